@@ -6,3 +6,5 @@ set(CMAKE_DIR ${PROJECT_DIR}/cmake)
 set(COMPONENTS_DIR ${PROJECT_DIR}/components)
 set(SUBMODULES_DIR ${PROJECT_DIR}/submodules)
 set(CUBEMX_DIR ${PROJECT_DIR}/cubemx/cmake/stm32cubemx)
+set(CMSIS_DSP_DIR ${PROJECT_DIR}/cubemx/Drivers/CMSIS/DSP)
+set(HOST_DIR ${PROJECT_DIR}/host)
@@ -0,0 +1,258 @@
+#include "termo_bus.h"
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "task.h"
+#include "termo_manager.h"
+#include "termo_notify.h"
+#include "termo_stats.h"
+#include <stddef.h>
+
+#define BUS_SUBSCRIBER_MASK(SUBSCRIBER) (1UL << (SUBSCRIBER))
+
+typedef struct {
+    termo_task_type_t task;
+    termo_queue_type_t queue;
+    uint32_t notify;
+    uint32_t depth;
+    termo_bus_drop_t drop;
+} termo_bus_subscriber_config_t;
+
+// the packet link keeps a contiguous history and loses the newest samples
+// instead, the display has no queue and only reads the latest values
+static termo_bus_subscriber_config_t const
+    termo_bus_subscribers[TERMO_BUS_SUBSCRIBER_NUM] = {
+        [TERMO_BUS_SUBSCRIBER_TERMO] = {.task = TERMO_TASK_TYPE_TERMO,
+                                        .queue = TERMO_QUEUE_TYPE_BUS_TERMO,
+                                        .notify = TERMO_NOTIFY_EVENT,
+                                        .depth = 2U,
+                                        .drop = TERMO_BUS_DROP_OLDEST},
+        [TERMO_BUS_SUBSCRIBER_DISPLAY] = {.task = TERMO_TASK_TYPE_DISPLAY,
+                                          .notify = DISPLAY_NOTIFY_EVENT,
+                                          .depth = 0U},
+        [TERMO_BUS_SUBSCRIBER_PACKET] = {.task = TERMO_TASK_TYPE_PACKET,
+                                         .queue = TERMO_QUEUE_TYPE_BUS_PACKET,
+                                         .notify = PACKET_NOTIFY_EVENT,
+                                         .depth = 8U,
+                                         .drop = TERMO_BUS_DROP_NEWEST},
+};
+
+static uint32_t const termo_bus_subscriptions[TERMO_BUS_TOPIC_NUM] = {
+    [TERMO_BUS_TOPIC_MEASURE] =
+        BUS_SUBSCRIBER_MASK(TERMO_BUS_SUBSCRIBER_PACKET),
+    [TERMO_BUS_TOPIC_REFERENCE] =
+        BUS_SUBSCRIBER_MASK(TERMO_BUS_SUBSCRIBER_TERMO),
+    [TERMO_BUS_TOPIC_CONTROL] =
+        BUS_SUBSCRIBER_MASK(TERMO_BUS_SUBSCRIBER_PACKET),
+    [TERMO_BUS_TOPIC_AUTOTUNE] =
+        BUS_SUBSCRIBER_MASK(TERMO_BUS_SUBSCRIBER_PACKET),
+};
+
+// woken on a new latest value without getting a queued copy of it
+static uint32_t const termo_bus_watches[TERMO_BUS_TOPIC_NUM] = {
+    [TERMO_BUS_TOPIC_MEASURE] =
+        BUS_SUBSCRIBER_MASK(TERMO_BUS_SUBSCRIBER_DISPLAY),
+    [TERMO_BUS_TOPIC_REFERENCE] =
+        BUS_SUBSCRIBER_MASK(TERMO_BUS_SUBSCRIBER_DISPLAY),
+    [TERMO_BUS_TOPIC_CONTROL] =
+        BUS_SUBSCRIBER_MASK(TERMO_BUS_SUBSCRIBER_DISPLAY),
+};
+
+static termo_bus_message_t termo_bus_blocks[TERMO_BUS_BLOCK_NUM];
+static termo_mailbox_t termo_bus_mailboxes[TERMO_BUS_TOPIC_NUM];
+
+static inline termo_bus_message_t* termo_bus_allocate(void)
+{
+    termo_bus_message_t* message = NULL;
+
+    taskENTER_CRITICAL();
+    for (size_t index = 0UL; index < TERMO_BUS_BLOCK_NUM; ++index) {
+        if (termo_bus_blocks[index].references == 0U) {
+            message = &termo_bus_blocks[index];
+            message->references = 1U;
+            break;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return message;
+}
+
+static inline void termo_bus_retain(termo_bus_message_t* message)
+{
+    taskENTER_CRITICAL();
+    message->references++;
+    taskEXIT_CRITICAL();
+}
+
+static inline void termo_bus_notify(termo_bus_subscriber_t subscriber)
+{
+    termo_bus_subscriber_config_t const* config =
+        &termo_bus_subscribers[subscriber];
+
+    TaskHandle_t task = termo_task_manager_get(config->task);
+    if (task != NULL) {
+        xTaskNotify(task, config->notify, eSetBits);
+    }
+}
+
+static void termo_bus_deliver(termo_bus_subscriber_t subscriber,
+                              termo_bus_message_t* message)
+{
+    termo_bus_subscriber_config_t const* config =
+        &termo_bus_subscribers[subscriber];
+    QueueHandle_t queue = termo_queue_manager_get(config->queue);
+
+    termo_bus_retain(message);
+
+    bool is_sent = termo_stats_queue_send(config->queue, &message, 0U);
+    if (!is_sent && config->drop == TERMO_BUS_DROP_OLDEST) {
+        termo_bus_message_t* oldest;
+        if (xQueueReceive(queue, &oldest, 0U) == pdPASS) {
+            termo_bus_release(oldest);
+        }
+        is_sent = xQueueSend(queue, &message, 0U) == pdPASS;
+    }
+
+    if (!is_sent) {
+        termo_bus_release(message);
+        return;
+    }
+
+    termo_bus_notify(subscriber);
+}
+
+termo_err_t termo_bus_initialize(void)
+{
+    static StaticQueue_t queue_buffers[TERMO_BUS_SUBSCRIBER_NUM];
+    static termo_bus_message_t*
+        queue_storages[TERMO_BUS_SUBSCRIBER_NUM][TERMO_BUS_QUEUE_DEPTH_MAX];
+
+    for (size_t index = 0UL; index < TERMO_BUS_BLOCK_NUM; ++index) {
+        termo_bus_blocks[index].references = 0U;
+    }
+
+    for (termo_bus_topic_t topic = 0; topic < TERMO_BUS_TOPIC_NUM; ++topic) {
+        if (!termo_mailbox_initialize(&termo_bus_mailboxes[topic])) {
+            return TERMO_ERR_FAIL;
+        }
+    }
+
+    for (termo_bus_subscriber_t subscriber = 0;
+         subscriber < TERMO_BUS_SUBSCRIBER_NUM;
+         ++subscriber) {
+        termo_bus_subscriber_config_t const* config =
+            &termo_bus_subscribers[subscriber];
+        if (config->depth == 0U) {
+            continue;
+        }
+        if (config->depth > TERMO_BUS_QUEUE_DEPTH_MAX) {
+            return TERMO_ERR_FAIL;
+        }
+
+        QueueHandle_t queue =
+            xQueueCreateStatic(config->depth,
+                               sizeof(termo_bus_message_t*),
+                               (uint8_t*)queue_storages[subscriber],
+                               &queue_buffers[subscriber]);
+        if (queue == NULL) {
+            return TERMO_ERR_FAIL;
+        }
+        termo_queue_manager_set(config->queue, queue);
+    }
+
+    return TERMO_ERR_OK;
+}
+
+bool termo_bus_publish(termo_bus_topic_t topic,
+                       termo_bus_payload_t const* payload)
+{
+    if (topic >= TERMO_BUS_TOPIC_NUM || payload == NULL) {
+        return false;
+    }
+
+    if (!termo_mailbox_write(&termo_bus_mailboxes[topic], payload)) {
+        return false;
+    }
+
+    for (termo_bus_subscriber_t subscriber = 0;
+         subscriber < TERMO_BUS_SUBSCRIBER_NUM;
+         ++subscriber) {
+        if ((termo_bus_watches[topic] & BUS_SUBSCRIBER_MASK(subscriber)) !=
+            0UL) {
+            termo_bus_notify(subscriber);
+        }
+    }
+
+    uint32_t subscriptions = termo_bus_subscriptions[topic];
+    if (subscriptions == 0UL) {
+        return true;
+    }
+
+    termo_bus_message_t* message = termo_bus_allocate();
+    if (message == NULL) {
+        return false;
+    }
+    message->topic = topic;
+    message->payload = *payload;
+
+    for (termo_bus_subscriber_t subscriber = 0;
+         subscriber < TERMO_BUS_SUBSCRIBER_NUM;
+         ++subscriber) {
+        if ((subscriptions & BUS_SUBSCRIBER_MASK(subscriber)) != 0UL) {
+            termo_bus_deliver(subscriber, message);
+        }
+    }
+
+    // the publisher's reference keeps the block alive until every
+    // subscriber got its own
+    termo_bus_release(message);
+
+    return true;
+}
+
+termo_bus_message_t const* termo_bus_receive(termo_bus_subscriber_t subscriber)
+{
+    if (subscriber >= TERMO_BUS_SUBSCRIBER_NUM ||
+        termo_bus_subscribers[subscriber].depth == 0U) {
+        return NULL;
+    }
+
+    termo_bus_message_t* message;
+    if (xQueueReceive(
+            termo_queue_manager_get(termo_bus_subscribers[subscriber].queue),
+            &message,
+            0U) != pdPASS) {
+        return NULL;
+    }
+
+    return message;
+}
+
+void termo_bus_release(termo_bus_message_t const* message)
+{
+    if (message < termo_bus_blocks ||
+        message >= termo_bus_blocks + TERMO_BUS_BLOCK_NUM) {
+        return;
+    }
+
+    termo_bus_message_t* block = &termo_bus_blocks[message - termo_bus_blocks];
+
+    taskENTER_CRITICAL();
+    if (block->references > 0U) {
+        block->references--;
+    }
+    taskEXIT_CRITICAL();
+}
+
+bool termo_bus_read_latest(termo_bus_topic_t topic,
+                           termo_mailbox_reader_t* reader,
+                           termo_bus_payload_t* payload)
+{
+    if (topic >= TERMO_BUS_TOPIC_NUM) {
+        return false;
+    }
+
+    return termo_mailbox_read(&termo_bus_mailboxes[topic], reader, payload);
+}
+
+#undef BUS_SUBSCRIBER_MASK
@@ -0,0 +1,59 @@
+#ifndef COMMON_TERMO_BUS_H
+#define COMMON_TERMO_BUS_H
+
+#include "termo_err.h"
+#include "termo_event.h"
+#include "termo_mailbox.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// enough blocks for every subscriber queue to be full while each subscriber
+// and publisher still holds one
+#define TERMO_BUS_BLOCK_NUM (20U)
+#define TERMO_BUS_QUEUE_DEPTH_MAX (8U)
+
+typedef enum {
+    TERMO_BUS_TOPIC_MEASURE,
+    TERMO_BUS_TOPIC_REFERENCE,
+    TERMO_BUS_TOPIC_CONTROL,
+    TERMO_BUS_TOPIC_AUTOTUNE,
+    TERMO_BUS_TOPIC_NUM,
+} termo_bus_topic_t;
+
+typedef enum {
+    TERMO_BUS_SUBSCRIBER_TERMO,
+    TERMO_BUS_SUBSCRIBER_DISPLAY,
+    TERMO_BUS_SUBSCRIBER_PACKET,
+    TERMO_BUS_SUBSCRIBER_NUM,
+} termo_bus_subscriber_t;
+
+typedef enum {
+    TERMO_BUS_DROP_NEWEST,
+    TERMO_BUS_DROP_OLDEST,
+} termo_bus_drop_t;
+
+// one pooled block is shared by every subscriber of its topic and returns
+// to the pool once the last of them releases it
+typedef struct {
+    termo_bus_topic_t topic;
+    termo_bus_payload_t payload;
+    uint32_t references;
+} termo_bus_message_t;
+
+termo_err_t termo_bus_initialize(void);
+
+// never blocks - a full subscriber queue drops by the subscriber's policy,
+// fails only when the block pool is exhausted
+bool termo_bus_publish(termo_bus_topic_t topic,
+                       termo_bus_payload_t const* payload);
+
+termo_bus_message_t const* termo_bus_receive(termo_bus_subscriber_t subscriber);
+void termo_bus_release(termo_bus_message_t const* message);
+
+// every topic also keeps its latest value, for state-like consumers that
+// only care about the freshest one
+bool termo_bus_read_latest(termo_bus_topic_t topic,
+                           termo_mailbox_reader_t* reader,
+                           termo_bus_payload_t* payload);
+
+#endif // COMMON_TERMO_BUS_H
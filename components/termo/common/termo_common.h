@@ -1,13 +1,22 @@
 #ifndef COMMON_TERMO_COMMON_H
 #define COMMON_TERMO_COMMON_H
 
+#include "termo_bus.h"
 #include "termo_err.h"
 #include "termo_event.h"
+#include "termo_format.h"
 #include "termo_log.h"
+#include "termo_mailbox.h"
 #include "termo_manager.h"
 #include "termo_notify.h"
+#include "termo_power.h"
+#include "termo_ring.h"
+#include "termo_stats.h"
+#include "termo_trace.h"
 #include "termo_utility.h"
 
+// scripts/trace_to_chrome.py speaks the text codec, leave this off to take
+// a trace dump
 // #define USE_BINARY_PACKETS
 // #define PACKET_IN_TEST
 
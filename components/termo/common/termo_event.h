@@ -1,6 +1,11 @@
 #ifndef COMMON_TERMO_EVENT_H
 #define COMMON_TERMO_EVENT_H
 
+#include <stdbool.h>
+#include <stdint.h>
+
+#define TERMO_SENSOR_NUM (8U)
+
 typedef enum {
     SYSTEM_EVENT_ORIGIN_TERMO,
     SYSTEM_EVENT_ORIGIN_DISPLAY,
@@ -12,7 +17,7 @@ typedef enum {
     SYSTEM_EVENT_TYPE_TERMO_STARTED,
     SYSTEM_EVENT_TYPE_TERMO_STOPPED,
     SYSTEM_EVENT_TYPE_TERMO_REFERENCE,
-    SYSTEM_EVENT_TYPE_TERMO_MEASURE,
+    SYSTEM_EVENT_TYPE_TERMO_AUTOTUNE,
     SYSTEM_EVENT_TYPE_PACKET_READY,
     SYSTEM_EVENT_TYPE_PACKET_STARTED,
     SYSTEM_EVENT_TYPE_PACKET_STOPPED,
@@ -33,13 +38,15 @@ typedef struct {
 typedef struct {
     float temperature;
     float update_time;
+    uint32_t timestamp;
+    uint32_t zone;
 } system_event_payload_termo_reference_t;
 
 typedef struct {
-    float temperature;
-    float humidity;
-    float pressure;
-} system_event_payload_termo_measure_t;
+    float setpoint;
+    float amplitude;
+    uint32_t rule;
+} system_event_payload_termo_autotune_t;
 
 typedef struct {
 } system_event_payload_packet_ready_t;
@@ -63,8 +70,8 @@ typedef union {
     system_event_payload_termo_ready_t termo_ready;
     system_event_payload_termo_started_t termo_started;
     system_event_payload_termo_stopped_t termo_stopped;
-    system_event_payload_termo_measure_t termo_measure;
     system_event_payload_termo_reference_t termo_reference;
+    system_event_payload_termo_autotune_t termo_autotune;
     system_event_payload_packet_ready_t packet_ready;
     system_event_payload_packet_started_t packet_started;
     system_event_payload_packet_stopped_t packet_stopped;
@@ -82,7 +89,7 @@ typedef struct {
 typedef enum {
     TERMO_EVENT_TYPE_START,
     TERMO_EVENT_TYPE_STOP,
-    TERMO_EVENT_TYPE_REFERENCE,
+    TERMO_EVENT_TYPE_AUTOTUNE,
 } termo_event_type_t;
 
 typedef struct {
@@ -91,15 +98,17 @@ typedef struct {
 typedef struct {
 } termo_event_payload_stop_t;
 
+// an amplitude of 0 keeps the default relay amplitude
 typedef struct {
-    float temperature;
-    float update_time;
-} termo_event_payload_reference_t;
+    float setpoint;
+    float amplitude;
+    uint32_t rule;
+} termo_event_payload_autotune_t;
 
 typedef union {
     termo_event_payload_start_t start;
     termo_event_payload_stop_t stop;
-    termo_event_payload_reference_t reference;
+    termo_event_payload_autotune_t autotune;
 } termo_event_payload_t;
 
 typedef struct {
@@ -110,8 +119,6 @@ typedef struct {
 typedef enum {
     DISPLAY_EVENT_TYPE_START,
     DISPLAY_EVENT_TYPE_STOP,
-    DISPLAY_EVENT_TYPE_MEASURE,
-    DISPLAY_EVENT_TYPE_REFERENCE,
 } display_event_type_t;
 
 typedef struct {
@@ -120,22 +127,9 @@ typedef struct {
 typedef struct {
 } display_event_payload_stop_t;
 
-typedef struct {
-    float temperature;
-    float humidity;
-    float pressure;
-} display_event_payload_measure_t;
-
-typedef struct {
-    float update_time;
-    float temperature;
-} display_event_payload_reference_t;
-
 typedef union {
     display_event_payload_start_t start;
     display_event_payload_stop_t stop;
-    display_event_payload_measure_t measure;
-    display_event_payload_reference_t reference;
 } display_event_payload_t;
 
 typedef struct {
@@ -146,7 +140,7 @@ typedef struct {
 typedef enum {
     PACKET_EVENT_TYPE_START,
     PACKET_EVENT_TYPE_STOP,
-    PACKET_EVENT_TYPE_MEASURE,
+    PACKET_EVENT_TYPE_STATS,
 } packet_event_type_t;
 
 typedef struct {
@@ -156,15 +150,12 @@ typedef struct {
 } packet_event_payload_stop_t;
 
 typedef struct {
-    float temperature;
-    float humidity;
-    float pressure;
-} packet_event_payload_measure_t;
+} packet_event_payload_stats_t;
 
 typedef union {
     packet_event_payload_start_t start;
     packet_event_payload_stop_t stop;
-    packet_event_payload_measure_t measure;
+    packet_event_payload_stats_t stats;
 } packet_event_payload_t;
 
 typedef struct {
@@ -172,4 +163,64 @@ typedef struct {
     packet_event_payload_t payload;
 } packet_event_t;
 
+typedef struct {
+    float temperature;
+    float humidity;
+    float pressure;
+    uint32_t timestamp;
+    bool is_duplicate;
+    // temperature is fused from the sensors flagged in sensor_valid
+    uint32_t sensor_count;
+    uint32_t sensor_valid;
+    float sensors[TERMO_SENSOR_NUM];
+} termo_bus_payload_measure_t;
+
+typedef struct {
+    float temperature;
+    float update_time;
+    uint32_t timestamp;
+    // the update time is shared, the temperature is the zone's own
+    uint32_t zone;
+} termo_bus_payload_reference_t;
+
+typedef struct {
+    float error;
+    float duty;
+    uint32_t timestamp;
+    bool has_estimate;
+    float estimate;
+    float variance;
+} termo_bus_payload_control_t;
+
+typedef struct {
+    float rise_time;
+    float overshoot;
+    float settling_time;
+    float iae;
+} termo_bus_step_metrics_t;
+
+// published once the relay experiment ends, and again with the metrics of
+// the first reference step the new gains followed
+typedef struct {
+    uint32_t timestamp;
+    bool is_identified;
+    uint32_t rule;
+    float ultimate_gain;
+    float ultimate_period;
+    float kp;
+    float ki;
+    float kd;
+    bool has_before;
+    termo_bus_step_metrics_t before;
+    bool has_after;
+    termo_bus_step_metrics_t after;
+} termo_bus_payload_autotune_t;
+
+typedef union {
+    termo_bus_payload_measure_t measure;
+    termo_bus_payload_reference_t reference;
+    termo_bus_payload_control_t control;
+    termo_bus_payload_autotune_t autotune;
+} termo_bus_payload_t;
+
 #endif // COMMON_TERMO_EVENT_H
\ No newline at end of file
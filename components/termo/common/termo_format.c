@@ -0,0 +1,176 @@
+#include "termo_format.h"
+#include <math.h>
+#include <stdbool.h>
+
+static uint32_t const termo_format_pow10[TERMO_FORMAT_MAX_DECIMALS + 1U] = {
+    1U,
+    10U,
+    100U,
+    1000U,
+    10000U,
+    100000U,
+    1000000U,
+    10000000U,
+    100000000U,
+    1000000000U,
+};
+
+static size_t termo_format_digits(char* buffer,
+                                  size_t buffer_len,
+                                  uint32_t value,
+                                  size_t min_digits)
+{
+    char digits[10];
+    size_t count = 0UL;
+
+    do {
+        digits[count++] = (char)('0' + (value % 10U));
+        value /= 10U;
+    } while (value > 0U);
+
+    while (count < min_digits && count < sizeof(digits)) {
+        digits[count++] = '0';
+    }
+
+    if (count >= buffer_len) {
+        return 0UL;
+    }
+
+    for (size_t index = 0UL; index < count; ++index) {
+        buffer[index] = digits[count - index - 1UL];
+    }
+    buffer[count] = '\0';
+
+    return count;
+}
+
+size_t termo_format_string(char* buffer,
+                           size_t buffer_len,
+                           char const* string)
+{
+    if (buffer == NULL || buffer_len == 0UL || string == NULL) {
+        return 0UL;
+    }
+
+    size_t count = 0UL;
+    while (string[count] != '\0') {
+        if (count + 1UL >= buffer_len) {
+            buffer[0] = '\0';
+            return 0UL;
+        }
+        buffer[count] = string[count];
+        count++;
+    }
+    buffer[count] = '\0';
+
+    return count;
+}
+
+size_t termo_format_uint(char* buffer, size_t buffer_len, uint32_t value)
+{
+    if (buffer == NULL || buffer_len == 0UL) {
+        return 0UL;
+    }
+
+    return termo_format_digits(buffer, buffer_len, value, 1UL);
+}
+
+size_t termo_format_int(char* buffer, size_t buffer_len, int32_t value)
+{
+    if (buffer == NULL || buffer_len < 2UL) {
+        return 0UL;
+    }
+
+    if (value >= 0) {
+        return termo_format_digits(buffer, buffer_len, (uint32_t)value, 1UL);
+    }
+
+    buffer[0] = '-';
+    size_t count = termo_format_digits(buffer + 1UL,
+                                       buffer_len - 1UL,
+                                       0U - (uint32_t)value,
+                                       1UL);
+
+    return count > 0UL ? count + 1UL : 0UL;
+}
+
+size_t termo_format_float(char* buffer,
+                          size_t buffer_len,
+                          float value,
+                          uint8_t decimals)
+{
+    if (buffer == NULL || buffer_len == 0UL) {
+        return 0UL;
+    }
+
+    if (decimals > TERMO_FORMAT_MAX_DECIMALS) {
+        decimals = TERMO_FORMAT_MAX_DECIMALS;
+    }
+
+    if (isnan(value)) {
+        return termo_format_string(buffer, buffer_len, "nan");
+    }
+
+    bool is_negative = signbit(value);
+    if (is_negative) {
+        value = -value;
+    }
+
+    if (isinf(value)) {
+        return termo_format_string(buffer,
+                                   buffer_len,
+                                   is_negative ? "-inf" : "inf");
+    }
+
+    if (value >= 4294967040.0F) {
+        buffer[0] = '\0';
+        return 0UL;
+    }
+
+    uint32_t scale = termo_format_pow10[decimals];
+    uint32_t integer = (uint32_t)value;
+    uint32_t fraction =
+        (uint32_t)((value - (float)integer) * (float)scale + 0.5F);
+    if (fraction >= scale) {
+        fraction -= scale;
+        integer++;
+    }
+
+    size_t count = 0UL;
+    if (is_negative) {
+        if (buffer_len < 2UL) {
+            buffer[0] = '\0';
+            return 0UL;
+        }
+        buffer[count++] = '-';
+    }
+
+    size_t integer_len =
+        termo_format_digits(buffer + count, buffer_len - count, integer, 1UL);
+    if (integer_len == 0UL) {
+        buffer[0] = '\0';
+        return 0UL;
+    }
+    count += integer_len;
+
+    if (decimals == 0U) {
+        return count;
+    }
+
+    if (count + 1UL >= buffer_len) {
+        buffer[0] = '\0';
+        return 0UL;
+    }
+    buffer[count++] = '.';
+
+    size_t fraction_len = termo_format_digits(buffer + count,
+                                              buffer_len - count,
+                                              fraction,
+                                              decimals);
+    if (fraction_len == 0UL) {
+        buffer[0] = '\0';
+        return 0UL;
+    }
+
+    return count + fraction_len;
+}
@@ -0,0 +1,19 @@
+#ifndef COMMON_TERMO_FORMAT_H
+#define COMMON_TERMO_FORMAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define TERMO_FORMAT_MAX_DECIMALS (9U)
+
+size_t termo_format_uint(char* buffer, size_t buffer_len, uint32_t value);
+size_t termo_format_int(char* buffer, size_t buffer_len, int32_t value);
+size_t termo_format_float(char* buffer,
+                          size_t buffer_len,
+                          float value,
+                          uint8_t decimals);
+size_t termo_format_string(char* buffer,
+                           size_t buffer_len,
+                           char const* string);
+
+#endif // COMMON_TERMO_FORMAT_H
@@ -1,18 +1,35 @@
 #include "termo_log.h"
+#include "FreeRTOS.h"
+#include "stm32l4xx_hal.h"
+#include "task.h"
+#include "termo_manager.h"
+#include "termo_notify.h"
+#include "termo_ring.h"
 #include <stdarg.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #define STATIC_BUFFER_LEN (1000U)
 
 extern int _write(int, char*, int);
 
+static uint8_t termo_log_ring_buffer[TERMO_LOG_RING_LEN];
+static termo_ring_t termo_log_ring = {.buffer = termo_log_ring_buffer,
+                                      .size = TERMO_LOG_RING_LEN};
+static atomic_uint_least32_t termo_log_dropped;
+
 void termo_log(char const* format, ...)
 {
     va_list list;
-    va_start(list, ...);
-    int needed_len = vsnprintf(NULL, 0UL, format, list) + 1;
+    va_start(list, format);
+
+    va_list size_list;
+    va_copy(size_list, list);
+    int needed_len = vsnprintf(NULL, 0UL, format, size_list) + 1;
+    va_end(size_list);
 
     char* buffer;
     size_t buffer_len;
@@ -24,8 +41,10 @@ void termo_log(char const* format, ...)
         used_heap_buffer = false;
     } else {
         char* heap_buffer = malloc(needed_len);
-        if (heap_buffer == NULL)
+        if (heap_buffer == NULL) {
+            va_end(list);
             return;
+        }
         buffer = heap_buffer;
         buffer_len = needed_len;
         used_heap_buffer = true;
@@ -38,6 +57,7 @@ void termo_log(char const* format, ...)
         if (used_heap_buffer) {
             free(buffer);
         }
+        return;
     }
 
     _write(1, buffer, written_len);
@@ -47,4 +67,241 @@ void termo_log(char const* format, ...)
     }
 }
 
-#undef STATIC_BUFFER_LEN
\ No newline at end of file
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+} termo_log_record_t;
+
+static inline bool termo_log_record_put(termo_log_record_t* record,
+                                        void const* value,
+                                        size_t value_size)
+{
+    if (record->capacity - record->size < value_size) {
+        return false;
+    }
+
+    memcpy(record->data + record->size, value, value_size);
+    record->size += value_size;
+
+    return true;
+}
+
+static inline bool termo_log_record_put_string(termo_log_record_t* record,
+                                               char const* string)
+{
+    if (string == NULL) {
+        string = "(null)";
+    }
+
+    uint8_t string_len = (uint8_t)strnlen(string, TERMO_LOG_STRING_LEN);
+
+    return termo_log_record_put(record, &string_len, sizeof(string_len)) &&
+           termo_log_record_put(record, string, string_len);
+}
+
+static inline bool termo_log_is_flag(char c)
+{
+    return c == '-' || c == '+' || c == ' ' || c == '#' || c == '0';
+}
+
+static inline bool termo_log_is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+static bool termo_log_record_put_width(termo_log_record_t* record,
+                                       char const** format,
+                                       va_list* list)
+{
+    if (**format == '*') {
+        int value = va_arg(*list, int);
+        ++*format;
+        if (!termo_log_record_put(record, &value, sizeof(value))) {
+            return false;
+        }
+    }
+
+    while (termo_log_is_digit(**format)) {
+        ++*format;
+    }
+
+    return true;
+}
+
+// walks the conversions the same way the host formatter does and copies each
+// argument in its raw form, only the %s contents are copied by value
+static bool termo_log_record_put_args(termo_log_record_t* record,
+                                      char const* format,
+                                      va_list* list)
+{
+    while (*format != '\0') {
+        if (*format++ != '%') {
+            continue;
+        }
+        if (*format == '%') {
+            ++format;
+            continue;
+        }
+
+        while (termo_log_is_flag(*format)) {
+            ++format;
+        }
+
+        if (!termo_log_record_put_width(record, &format, list)) {
+            return false;
+        }
+        if (*format == '.') {
+            ++format;
+            if (!termo_log_record_put_width(record, &format, list)) {
+                return false;
+            }
+        }
+
+        char length = '\0';
+        if (*format == 'h' || *format == 'l') {
+            length = *format++;
+            if (*format == length) {
+                length = (char)(length == 'l' ? 'L' : 'H');
+                ++format;
+            }
+        } else if (*format == 'j' || *format == 'z' || *format == 't' ||
+                   *format == 'L') {
+            length = *format++;
+        }
+
+        char conversion = *format++;
+        switch (conversion) {
+            case 'd':
+            case 'i':
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o':
+            case 'c': {
+                bool is_ok;
+                if (length == 'l') {
+                    long value = va_arg(*list, long);
+                    is_ok = termo_log_record_put(record, &value, sizeof(value));
+                } else if (length == 'L' || length == 'j') {
+                    long long value = va_arg(*list, long long);
+                    is_ok = termo_log_record_put(record, &value, sizeof(value));
+                } else if (length == 'z' || length == 't') {
+                    size_t value = va_arg(*list, size_t);
+                    is_ok = termo_log_record_put(record, &value, sizeof(value));
+                } else {
+                    int value = va_arg(*list, int);
+                    is_ok = termo_log_record_put(record, &value, sizeof(value));
+                }
+                if (!is_ok) {
+                    return false;
+                }
+                break;
+            }
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A': {
+                double value = va_arg(*list, double);
+                if (!termo_log_record_put(record, &value, sizeof(value))) {
+                    return false;
+                }
+                break;
+            }
+            case 'p': {
+                void* value = va_arg(*list, void*);
+                if (!termo_log_record_put(record, &value, sizeof(value))) {
+                    return false;
+                }
+                break;
+            }
+            case 's': {
+                if (!termo_log_record_put_string(record,
+                                                 va_arg(*list, char const*))) {
+                    return false;
+                }
+                break;
+            }
+            default: {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static inline void termo_log_notify_drain(void)
+{
+    TaskHandle_t log_task = termo_task_manager_get(TERMO_TASK_TYPE_LOG);
+    if (log_task == NULL) {
+        return;
+    }
+
+    if (xPortIsInsideInterrupt() == pdTRUE) {
+        BaseType_t task_woken = pdFALSE;
+        xTaskNotifyFromISR(log_task, LOG_NOTIFY_DATA, eSetBits, &task_woken);
+        portYIELD_FROM_ISR(task_woken);
+    } else if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) {
+        xTaskNotify(log_task, LOG_NOTIFY_DATA, eSetBits);
+    }
+}
+
+void termo_log_deferred(char const* format, ...)
+{
+    uint8_t data[TERMO_LOG_RECORD_LEN];
+    termo_log_record_t record = {.data = data,
+                                 .size = TERMO_LOG_HEADER_SIZE,
+                                 .capacity = sizeof(data)};
+
+    va_list list;
+    va_start(list, format);
+    bool is_encoded = termo_log_record_put_args(&record, format, &list);
+    va_end(list);
+
+    if (!is_encoded) {
+        atomic_fetch_add_explicit(&termo_log_dropped, 1U, memory_order_relaxed);
+        return;
+    }
+
+    uint32_t address = (uint32_t)(uintptr_t)format;
+    uint32_t tick = HAL_GetTick();
+    data[0] = TERMO_LOG_SYNC;
+    data[1] = (uint8_t)(record.size - TERMO_LOG_HEADER_SIZE);
+    memcpy(&data[2], &address, sizeof(address));
+    memcpy(&data[6], &tick, sizeof(tick));
+
+    // the ring is single producer - the copy is short and bounded, so
+    // producers from any task or isr are serialized by masking interrupts
+    UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+    bool is_written = termo_ring_space(&termo_log_ring) >= record.size;
+    if (is_written) {
+        termo_ring_write(&termo_log_ring, data, record.size);
+    }
+    taskEXIT_CRITICAL_FROM_ISR(mask);
+
+    if (!is_written) {
+        atomic_fetch_add_explicit(&termo_log_dropped, 1U, memory_order_relaxed);
+        return;
+    }
+
+    termo_log_notify_drain();
+}
+
+size_t termo_log_read(uint8_t* data, size_t data_size)
+{
+    return termo_ring_read(&termo_log_ring, data, data_size);
+}
+
+uint32_t termo_log_get_dropped(void)
+{
+    return atomic_exchange_explicit(&termo_log_dropped,
+                                    0U,
+                                    memory_order_relaxed);
+}
+
+#undef STATIC_BUFFER_LEN
@@ -1,6 +1,25 @@
 #ifndef COMMON_TERMO_LOG_H
 #define COMMON_TERMO_LOG_H
 
+#include <stddef.h>
+#include <stdint.h>
+
+// #define USE_DEFERRED_LOG
+
+#define TERMO_LOG_SYNC (0xA5U)
+#define TERMO_LOG_HEADER_SIZE (10U)
+#define TERMO_LOG_RECORD_LEN (128U)
+#define TERMO_LOG_STRING_LEN (32U)
+#define TERMO_LOG_RING_LEN (2048U)
+
 void termo_log(char const* format, ...);
 
-#endif // COMMON_TERMO_LOG_H
\ No newline at end of file
+// record: sync, payload size, format address, tick, then the raw arguments
+// in format order - integers and pointers in their native width, doubles as
+// 8 bytes, strings as a length byte and up to TERMO_LOG_STRING_LEN chars
+void termo_log_deferred(char const* format, ...);
+
+size_t termo_log_read(uint8_t* data, size_t data_size);
+uint32_t termo_log_get_dropped(void);
+
+#endif // COMMON_TERMO_LOG_H
@@ -0,0 +1,52 @@
+#include "termo_mailbox.h"
+#include <stddef.h>
+
+bool termo_mailbox_initialize(termo_mailbox_t* mailbox)
+{
+    if (mailbox == NULL) {
+        return false;
+    }
+
+    mailbox->sequence = 0U;
+    mailbox->queue = xQueueCreateStatic(1U,
+                                        sizeof(termo_mailbox_slot_t),
+                                        mailbox->queue_storage,
+                                        &mailbox->queue_buffer);
+
+    return mailbox->queue != NULL;
+}
+
+bool termo_mailbox_write(termo_mailbox_t* mailbox,
+                         termo_bus_payload_t const* payload)
+{
+    if (mailbox == NULL || payload == NULL) {
+        return false;
+    }
+
+    termo_mailbox_slot_t slot = {.sequence = ++mailbox->sequence,
+                                 .payload = *payload};
+
+    return xQueueOverwrite(mailbox->queue, &slot) == pdPASS;
+}
+
+bool termo_mailbox_read(termo_mailbox_t* mailbox,
+                        termo_mailbox_reader_t* reader,
+                        termo_bus_payload_t* payload)
+{
+    if (mailbox == NULL || reader == NULL || payload == NULL) {
+        return false;
+    }
+
+    termo_mailbox_slot_t slot;
+    if (xQueuePeek(mailbox->queue, &slot, 0U) != pdPASS ||
+        slot.sequence == reader->sequence) {
+        return false;
+    }
+
+    // unsigned difference survives the sequence wrapping around
+    reader->superseded += slot.sequence - reader->sequence - 1U;
+    reader->sequence = slot.sequence;
+    *payload = slot.payload;
+
+    return true;
+}
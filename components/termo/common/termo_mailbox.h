@@ -0,0 +1,40 @@
+#ifndef COMMON_TERMO_MAILBOX_H
+#define COMMON_TERMO_MAILBOX_H
+
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "termo_event.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct {
+    uint32_t sequence;
+    termo_bus_payload_t payload;
+} termo_mailbox_slot_t;
+
+// single slot overwritten by one writer, readers peek the latest value
+typedef struct {
+    QueueHandle_t queue;
+    StaticQueue_t queue_buffer;
+    uint8_t queue_storage[sizeof(termo_mailbox_slot_t)];
+
+    uint32_t sequence;
+} termo_mailbox_t;
+
+// superseded counts the values overwritten before this reader saw them
+typedef struct {
+    uint32_t sequence;
+    uint32_t superseded;
+} termo_mailbox_reader_t;
+
+bool termo_mailbox_initialize(termo_mailbox_t* mailbox);
+
+bool termo_mailbox_write(termo_mailbox_t* mailbox,
+                         termo_bus_payload_t const* payload);
+
+// false when nothing was written since the reader's previous read
+bool termo_mailbox_read(termo_mailbox_t* mailbox,
+                        termo_mailbox_reader_t* reader,
+                        termo_bus_payload_t* payload);
+
+#endif // COMMON_TERMO_MAILBOX_H
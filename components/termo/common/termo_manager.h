@@ -1,3 +1,6 @@
+#ifndef COMMON_TERMO_MANAGER_H
+#define COMMON_TERMO_MANAGER_H
+
 #include "FreeRTOS.h"
 #include "handle_manager.h"
 #include "queue.h"
@@ -9,6 +12,7 @@ typedef enum {
     TERMO_TASK_TYPE_TERMO,
     TERMO_TASK_TYPE_DISPLAY,
     TERMO_TASK_TYPE_PACKET,
+    TERMO_TASK_TYPE_LOG,
     TERMO_TASK_TYPE_NUM,
 } termo_task_type_t;
 
@@ -17,6 +21,8 @@ typedef enum {
     TERMO_QUEUE_TYPE_TERMO,
     TERMO_QUEUE_TYPE_DISPLAY,
     TERMO_QUEUE_TYPE_PACKET,
+    TERMO_QUEUE_TYPE_BUS_TERMO,
+    TERMO_QUEUE_TYPE_BUS_PACKET,
     TERMO_QUEUE_TYPE_NUM,
 } termo_queue_type_t;
 
@@ -38,4 +44,6 @@ DECLARE_HANDLE_MANAGER(termo_queue,
 DECLARE_HANDLE_MANAGER(termo_semaphore,
                        termo_semaphore_type_t,
                        SemaphoreHandle_t,
-                       TERMO_SEMAPHORE_TYPE_NUM);
\ No newline at end of file
+                       TERMO_SEMAPHORE_TYPE_NUM);
+
+#endif // COMMON_TERMO_MANAGER_H
\ No newline at end of file
@@ -2,24 +2,47 @@
 #define COMMON_TERMO_NOTIFY_H
 
 typedef enum {
-    SYSTEM_NOTIFY_ALL = (1 << 0),
+    SYSTEM_NOTIFY_EVENT = (1 << 0),
+    SYSTEM_NOTIFY_ALL = (SYSTEM_NOTIFY_EVENT),
 } system_notify_t;
 
 typedef enum {
     TERMO_NOTIFY_UPDATE_TIMER = (1 << 0),
     TERMO_NOTIFY_DELTA_TIMER = (1 << 1),
     TERMO_NOTIFY_PWM_TIMER = (1 << 2),
+    TERMO_NOTIFY_EVENT = (1 << 3),
+    TERMO_NOTIFY_SENSOR_DONE = (1 << 4),
+    TERMO_NOTIFY_SENSOR_ERROR = (1 << 5),
+    TERMO_NOTIFY_SENSOR_TIMEOUT = (1 << 6),
     TERMO_NOTIFY_ALL = (TERMO_NOTIFY_UPDATE_TIMER | TERMO_NOTIFY_DELTA_TIMER |
-                        TERMO_NOTIFY_PWM_TIMER),
+                        TERMO_NOTIFY_PWM_TIMER | TERMO_NOTIFY_EVENT |
+                        TERMO_NOTIFY_SENSOR_DONE | TERMO_NOTIFY_SENSOR_ERROR |
+                        TERMO_NOTIFY_SENSOR_TIMEOUT),
 } termo_notify_t;
 
 typedef enum {
-    DISPLAY_NOTIFY_ALL = (1 << 0),
+    DISPLAY_NOTIFY_TX_COMPLETE = (1 << 0),
+    DISPLAY_NOTIFY_TX_ERROR = (1 << 1),
+    DISPLAY_NOTIFY_EVENT = (1 << 2),
+    DISPLAY_NOTIFY_ALL = (DISPLAY_NOTIFY_TX_COMPLETE | DISPLAY_NOTIFY_TX_ERROR |
+                          DISPLAY_NOTIFY_EVENT),
 } display_notify_t;
 
 typedef enum {
     PACKET_NOTIFY_RX_COMPLETE = (1 << 0),
-    PACKET_NOTIFY_ALL = (PACKET_NOTIFY_RX_COMPLETE),
+    PACKET_NOTIFY_TX_COMPLETE = (1 << 1),
+    PACKET_NOTIFY_EVENT = (1 << 2),
+    PACKET_NOTIFY_TX_ERROR = (1 << 3),
+    PACKET_NOTIFY_ALL = (PACKET_NOTIFY_RX_COMPLETE | PACKET_NOTIFY_TX_COMPLETE |
+                         PACKET_NOTIFY_EVENT | PACKET_NOTIFY_TX_ERROR),
 } packet_notify_t;
 
+typedef enum {
+    LOG_NOTIFY_DATA = (1 << 0),
+    LOG_NOTIFY_TX_COMPLETE = (1 << 1),
+    LOG_NOTIFY_TX_ERROR = (1 << 2),
+    LOG_NOTIFY_ALL =
+        (LOG_NOTIFY_DATA | LOG_NOTIFY_TX_COMPLETE | LOG_NOTIFY_TX_ERROR),
+} log_notify_t;
+
 #endif // COMMON_TERMO_NOTIFY_H
\ No newline at end of file
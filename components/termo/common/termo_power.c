@@ -0,0 +1,190 @@
+#include "termo_power.h"
+#include "FreeRTOS.h"
+#include "stm32l476xx.h"
+#include "stm32l4xx_hal.h"
+#include "task.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define LPTIM_CLOCK_HZ (32768UL)
+#define LPTIM_MAX_COUNT (0xFFFFUL)
+#define LPTIM_SYNC_TIMEOUT (1000UL)
+
+extern void SystemClock_Config(void);
+extern void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime);
+
+static atomic_uint termo_power_stop_locks = 0U;
+static termo_power_stats_t termo_power_stats = {};
+
+static inline bool termo_power_wait_lptim_flag(uint32_t flag)
+{
+    for (uint32_t count = 0UL; count < LPTIM_SYNC_TIMEOUT; ++count) {
+        if ((LPTIM1->ISR & flag) == flag) {
+            LPTIM1->ICR = flag;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool termo_power_start_lptim(uint32_t compare)
+{
+    __HAL_RCC_LPTIM1_CONFIG(RCC_LPTIM1CLKSOURCE_LSE);
+    __HAL_RCC_LPTIM1_CLK_ENABLE();
+
+    LPTIM1->CR = 0UL;
+    LPTIM1->CFGR = 0UL;
+    LPTIM1->IER = LPTIM_IER_CMPMIE;
+    LPTIM1->CR = LPTIM_CR_ENABLE;
+
+    LPTIM1->ARR = LPTIM_MAX_COUNT;
+    if (!termo_power_wait_lptim_flag(LPTIM_ISR_ARROK)) {
+        return false;
+    }
+
+    LPTIM1->CMP = compare;
+    if (!termo_power_wait_lptim_flag(LPTIM_ISR_CMPOK)) {
+        return false;
+    }
+
+    EXTI->IMR2 |= EXTI_IMR2_IM32;
+    HAL_NVIC_EnableIRQ(LPTIM1_IRQn);
+
+    LPTIM1->CR |= LPTIM_CR_CNTSTRT;
+
+    return true;
+}
+
+static uint32_t termo_power_stop_lptim(void)
+{
+    // counter runs asynchronously - two equal reads give a valid value
+    uint32_t count = LPTIM1->CNT;
+    while (count != LPTIM1->CNT) {
+        count = LPTIM1->CNT;
+    }
+
+    LPTIM1->CR = 0UL;
+    LPTIM1->ICR = LPTIM_ICR_CMPMCF;
+    HAL_NVIC_DisableIRQ(LPTIM1_IRQn);
+    NVIC_ClearPendingIRQ(LPTIM1_IRQn);
+
+    return count;
+}
+
+static void termo_power_enter_stop2(TickType_t expected_idle_time)
+{
+    uint32_t max_idle_time =
+        (LPTIM_MAX_COUNT * configTICK_RATE_HZ) / LPTIM_CLOCK_HZ;
+    if (expected_idle_time > max_idle_time) {
+        expected_idle_time = max_idle_time;
+    }
+
+    __disable_irq();
+    __DSB();
+    __ISB();
+
+    if (eTaskConfirmSleepModeStatus() == eAbortSleep) {
+        __enable_irq();
+        return;
+    }
+
+    uint32_t compare =
+        (expected_idle_time * LPTIM_CLOCK_HZ) / configTICK_RATE_HZ;
+    if (!termo_power_start_lptim(compare)) {
+        termo_power_stop_lptim();
+        __enable_irq();
+        return;
+    }
+
+    SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+    HAL_SuspendTick();
+
+    HAL_PWREx_EnterSTOP2Mode(PWR_STOPENTRY_WFI);
+
+    SystemClock_Config();
+
+    TickType_t slept_time = (TickType_t)(
+        (termo_power_stop_lptim() * configTICK_RATE_HZ) / LPTIM_CLOCK_HZ);
+    if (slept_time > expected_idle_time) {
+        slept_time = expected_idle_time;
+    }
+
+    vTaskStepTick(slept_time);
+    uwTick += slept_time * (1000UL / configTICK_RATE_HZ);
+
+    HAL_ResumeTick();
+    SysTick->LOAD = (configCPU_CLOCK_HZ / configTICK_RATE_HZ) - 1UL;
+    SysTick->VAL = 0UL;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+
+    termo_power_stats.mode_times[TERMO_POWER_MODE_STOP2] += slept_time;
+    termo_power_stats.stop2_entries++;
+
+    __enable_irq();
+}
+
+void termo_power_lock_stop(void)
+{
+    atomic_fetch_add(&termo_power_stop_locks, 1U);
+}
+
+void termo_power_unlock_stop(void)
+{
+    atomic_fetch_sub(&termo_power_stop_locks, 1U);
+}
+
+termo_power_mode_t termo_power_get_sleep_mode(void)
+{
+    return atomic_load(&termo_power_stop_locks) > 0U ? TERMO_POWER_MODE_SLEEP
+                                                     : TERMO_POWER_MODE_STOP2;
+}
+
+void termo_power_get_stats(termo_power_stats_t* stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    *stats = termo_power_stats;
+    taskEXIT_CRITICAL();
+
+    uint32_t total_time = xTaskGetTickCount();
+    uint32_t idle_time = stats->mode_times[TERMO_POWER_MODE_SLEEP] +
+                         stats->mode_times[TERMO_POWER_MODE_STOP2];
+    stats->mode_times[TERMO_POWER_MODE_RUN] =
+        total_time > idle_time ? total_time - idle_time : 0UL;
+}
+
+char const* termo_power_mode_to_string(termo_power_mode_t mode)
+{
+    switch (mode) {
+        case TERMO_POWER_MODE_RUN: {
+            return "run";
+        }
+        case TERMO_POWER_MODE_SLEEP: {
+            return "sleep";
+        }
+        case TERMO_POWER_MODE_STOP2: {
+            return "stop2";
+        }
+        default: {
+            return "unknown";
+        }
+    }
+}
+
+void termo_power_suppress_ticks_and_sleep(uint32_t expected_idle_time)
+{
+    if (termo_power_get_sleep_mode() == TERMO_POWER_MODE_STOP2) {
+        termo_power_enter_stop2(expected_idle_time);
+        return;
+    }
+
+    TickType_t start = xTaskGetTickCount();
+    vPortSuppressTicksAndSleep(expected_idle_time);
+    termo_power_stats.mode_times[TERMO_POWER_MODE_SLEEP] +=
+        xTaskGetTickCount() - start;
+}
@@ -0,0 +1,29 @@
+#ifndef COMMON_TERMO_POWER_H
+#define COMMON_TERMO_POWER_H
+
+#include <stdint.h>
+
+typedef enum {
+    TERMO_POWER_MODE_RUN,
+    TERMO_POWER_MODE_SLEEP,
+    TERMO_POWER_MODE_STOP2,
+    TERMO_POWER_MODE_NUM,
+} termo_power_mode_t;
+
+typedef struct {
+    uint32_t mode_times[TERMO_POWER_MODE_NUM];
+    uint32_t stop2_entries;
+} termo_power_stats_t;
+
+// STOP2 stops every clock but LSE/LSI - hold a lock while a peripheral
+// outside LPTIM1 has to keep running
+void termo_power_lock_stop(void);
+void termo_power_unlock_stop(void);
+
+termo_power_mode_t termo_power_get_sleep_mode(void);
+void termo_power_get_stats(termo_power_stats_t* stats);
+char const* termo_power_mode_to_string(termo_power_mode_t mode);
+
+void termo_power_suppress_ticks_and_sleep(uint32_t expected_idle_time);
+
+#endif // COMMON_TERMO_POWER_H
@@ -0,0 +1,112 @@
+#include "termo_ring.h"
+#include <string.h>
+
+bool termo_ring_initialize(termo_ring_t* ring, uint8_t* buffer, size_t size)
+{
+    if (ring == NULL || buffer == NULL || size == 0UL ||
+        (size & (size - 1UL)) != 0UL) {
+        return false;
+    }
+
+    ring->buffer = buffer;
+    ring->size = size;
+
+    atomic_init(&ring->head, 0UL);
+    atomic_init(&ring->tail, 0UL);
+
+    return true;
+}
+
+void termo_ring_reset(termo_ring_t* ring)
+{
+    atomic_store_explicit(&ring->tail,
+                          atomic_load_explicit(&ring->head,
+                                               memory_order_acquire),
+                          memory_order_release);
+}
+
+size_t termo_ring_count(termo_ring_t const* ring)
+{
+    size_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+
+    return head - tail;
+}
+
+size_t termo_ring_space(termo_ring_t const* ring)
+{
+    return ring->size - termo_ring_count(ring);
+}
+
+size_t termo_ring_write(termo_ring_t* ring, uint8_t const* data, size_t size)
+{
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+
+    size_t space = ring->size - (head - tail);
+    if (size > space) {
+        size = space;
+    }
+
+    size_t offset = head & (ring->size - 1UL);
+    size_t first = ring->size - offset;
+    if (first > size) {
+        first = size;
+    }
+
+    memcpy(ring->buffer + offset, data, first);
+    memcpy(ring->buffer, data + first, size - first);
+
+    atomic_store_explicit(&ring->head, head + size, memory_order_release);
+
+    return size;
+}
+
+size_t termo_ring_read(termo_ring_t* ring, uint8_t* data, size_t size)
+{
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    size_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+
+    size_t count = head - tail;
+    if (size > count) {
+        size = count;
+    }
+
+    size_t offset = tail & (ring->size - 1UL);
+    size_t first = ring->size - offset;
+    if (first > size) {
+        first = size;
+    }
+
+    memcpy(data, ring->buffer + offset, first);
+    memcpy(data + first, ring->buffer, size - first);
+
+    atomic_store_explicit(&ring->tail, tail + size, memory_order_release);
+
+    return size;
+}
+
+size_t termo_ring_write_circular(termo_ring_t* ring,
+                                 uint8_t const* source,
+                                 size_t source_size,
+                                 size_t* position,
+                                 size_t end)
+{
+    size_t lost = 0UL;
+
+    // the writer wrapped since the last call
+    if (end < *position) {
+        size_t size = source_size - *position;
+        lost += size - termo_ring_write(ring, source + *position, size);
+        *position = 0UL;
+    }
+
+    if (end > *position) {
+        size_t size = end - *position;
+        lost += size - termo_ring_write(ring, source + *position, size);
+    }
+
+    *position = end % source_size;
+
+    return lost;
+}
@@ -0,0 +1,36 @@
+#ifndef COMMON_TERMO_RING_H
+#define COMMON_TERMO_RING_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// single producer, single consumer byte ring - producer may be an ISR
+typedef struct {
+    uint8_t* buffer;
+    size_t size;
+
+    atomic_size_t head;
+    atomic_size_t tail;
+} termo_ring_t;
+
+bool termo_ring_initialize(termo_ring_t* ring, uint8_t* buffer, size_t size);
+void termo_ring_reset(termo_ring_t* ring);
+
+size_t termo_ring_count(termo_ring_t const* ring);
+size_t termo_ring_space(termo_ring_t const* ring);
+
+size_t termo_ring_write(termo_ring_t* ring, uint8_t const* data, size_t size);
+size_t termo_ring_read(termo_ring_t* ring, uint8_t* data, size_t size);
+
+// copies what a circular writer, like a dma channel, has put into source
+// since position up to end and moves position along - returns the number of
+// bytes that did not fit
+size_t termo_ring_write_circular(termo_ring_t* ring,
+                                 uint8_t const* source,
+                                 size_t source_size,
+                                 size_t* position,
+                                 size_t end);
+
+#endif // COMMON_TERMO_RING_H
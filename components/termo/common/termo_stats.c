@@ -0,0 +1,244 @@
+#include "termo_stats.h"
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "stm32l4xx_hal.h"
+#include "task.h"
+#include <stddef.h>
+#include <string.h>
+
+#ifdef TERMO_HOST
+#include <time.h>
+#endif
+
+#define STATS_HOST_CLOCK_HZ (1000000UL)
+
+typedef struct {
+    uint32_t peak_depth;
+    uint32_t send_failed;
+} termo_stats_queue_counters_t;
+
+typedef struct {
+    uint32_t errors;
+    uint32_t timeouts;
+    uint32_t duplicates;
+    uint32_t samples;
+    float resolution;
+} termo_stats_sensor_counters_t;
+
+typedef struct {
+    TickType_t tick;
+    uint32_t run_times[TERMO_TASK_TYPE_NUM];
+    uint32_t sensor_samples;
+} termo_stats_sample_t;
+
+static termo_stats_queue_counters_t
+    termo_stats_queue_counters[TERMO_QUEUE_TYPE_NUM] = {};
+static termo_stats_sample_t termo_stats_last_sample = {};
+static termo_stats_sensor_counters_t termo_stats_sensor_counters = {};
+static termo_stats_display_t termo_stats_display = {};
+static termo_stats_latency_t termo_stats_latency = {};
+
+void termo_stats_start_run_time_counter(void)
+{
+#ifndef TERMO_HOST
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0UL;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+uint32_t termo_stats_get_run_time_counter(void)
+{
+#ifdef TERMO_HOST
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return (uint32_t)((uint64_t)time.tv_sec * STATS_HOST_CLOCK_HZ +
+                      (uint64_t)time.tv_nsec / 1000ULL);
+#else
+    return DWT->CYCCNT;
+#endif
+}
+
+uint32_t termo_stats_get_run_time_clock(void)
+{
+#ifdef TERMO_HOST
+    return STATS_HOST_CLOCK_HZ;
+#else
+    return SystemCoreClock;
+#endif
+}
+
+bool termo_stats_queue_send(termo_queue_type_t type,
+                            void const* item,
+                            TickType_t timeout)
+{
+    QueueHandle_t queue = termo_queue_manager_get(type);
+    termo_stats_queue_counters_t* counters = &termo_stats_queue_counters[type];
+
+    bool is_sent = xQueueSend(queue, item, timeout) == pdPASS;
+    uint32_t depth = (uint32_t)uxQueueMessagesWaiting(queue);
+
+    taskENTER_CRITICAL();
+    if (!is_sent) {
+        counters->send_failed++;
+    } else if (depth > counters->peak_depth) {
+        counters->peak_depth = depth;
+    }
+    taskEXIT_CRITICAL();
+
+    return is_sent;
+}
+
+void termo_stats_count_sensor_error(void)
+{
+    taskENTER_CRITICAL();
+    termo_stats_sensor_counters.errors++;
+    taskEXIT_CRITICAL();
+}
+
+void termo_stats_count_sensor_timeout(void)
+{
+    taskENTER_CRITICAL();
+    termo_stats_sensor_counters.timeouts++;
+    taskEXIT_CRITICAL();
+}
+
+void termo_stats_count_sensor_sample(bool is_duplicate)
+{
+    taskENTER_CRITICAL();
+    if (is_duplicate) {
+        termo_stats_sensor_counters.duplicates++;
+    } else {
+        termo_stats_sensor_counters.samples++;
+    }
+    taskEXIT_CRITICAL();
+}
+
+void termo_stats_set_sensor_resolution(float resolution)
+{
+    taskENTER_CRITICAL();
+    termo_stats_sensor_counters.resolution = resolution;
+    taskEXIT_CRITICAL();
+}
+
+void termo_stats_count_display_superseded(uint32_t count)
+{
+    taskENTER_CRITICAL();
+    termo_stats_display.superseded += count;
+    taskEXIT_CRITICAL();
+}
+
+void termo_stats_set_display_bytes(uint32_t bytes_sent,
+                                   uint32_t bytes_per_second)
+{
+    taskENTER_CRITICAL();
+    termo_stats_display.bytes_sent = bytes_sent;
+    termo_stats_display.bytes_per_second = bytes_per_second;
+    taskEXIT_CRITICAL();
+}
+
+void termo_stats_set_reference_latency(uint32_t latency)
+{
+    taskENTER_CRITICAL();
+    termo_stats_latency.reference = latency;
+    taskEXIT_CRITICAL();
+}
+
+void termo_stats_set_measure_latency(uint32_t latency)
+{
+    taskENTER_CRITICAL();
+    termo_stats_latency.measure = latency;
+    taskEXIT_CRITICAL();
+}
+
+static void termo_stats_sample_task(termo_task_type_t type,
+                                    float wall_time,
+                                    termo_stats_sample_t* sample,
+                                    termo_stats_task_t* stats)
+{
+    TaskHandle_t task = termo_task_manager_get(type);
+    if (task == NULL) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+
+    TaskStatus_t status;
+    vTaskGetInfo(task, &status, pdFALSE, eInvalid);
+
+    // per task counters wrap - unsigned deltas survive a single wrap
+    uint32_t run_time =
+        status.ulRunTimeCounter - termo_stats_last_sample.run_times[type];
+    sample->run_times[type] = status.ulRunTimeCounter;
+
+    stats->cpu_load =
+        wall_time > 0.0F ? 100.0F * (float)run_time / wall_time : 0.0F;
+    stats->stack_free =
+        (uint32_t)uxTaskGetStackHighWaterMark(task) * sizeof(StackType_t);
+}
+
+static void termo_stats_sample_queue(termo_queue_type_t type,
+                                     termo_stats_queue_t* stats)
+{
+    QueueHandle_t queue = termo_queue_manager_get(type);
+    if (queue == NULL) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+
+    stats->depth = (uint32_t)uxQueueMessagesWaiting(queue);
+    stats->length = stats->depth + (uint32_t)uxQueueSpacesAvailable(queue);
+
+    taskENTER_CRITICAL();
+    stats->peak_depth = termo_stats_queue_counters[type].peak_depth;
+    stats->send_failed = termo_stats_queue_counters[type].send_failed;
+    taskEXIT_CRITICAL();
+}
+
+void termo_stats_sample(termo_stats_t* stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+
+    // the run time counter stops in sleep and stop modes, so the wall time
+    // comes from the tick count
+    termo_stats_sample_t sample = {.tick = xTaskGetTickCount()};
+    TickType_t elapsed = sample.tick - termo_stats_last_sample.tick;
+    float wall_time = (float)elapsed *
+                      (float)termo_stats_get_run_time_clock() /
+                      (float)configTICK_RATE_HZ;
+
+    stats->period = (uint32_t)(elapsed * portTICK_PERIOD_MS);
+
+    for (termo_task_type_t type = 0; type < TERMO_TASK_TYPE_NUM; ++type) {
+        termo_stats_sample_task(type, wall_time, &sample, &stats->tasks[type]);
+    }
+    for (termo_queue_type_t type = 0; type < TERMO_QUEUE_TYPE_NUM; ++type) {
+        termo_stats_sample_queue(type, &stats->queues[type]);
+    }
+
+    taskENTER_CRITICAL();
+    termo_stats_sensor_counters_t sensor = termo_stats_sensor_counters;
+    stats->display = termo_stats_display;
+    stats->latency = termo_stats_latency;
+    taskEXIT_CRITICAL();
+
+    sample.sensor_samples = sensor.samples;
+    stats->sensor = (termo_stats_sensor_t){
+        .errors = sensor.errors,
+        .timeouts = sensor.timeouts,
+        .duplicates = sensor.duplicates,
+        .resolution = sensor.resolution,
+        .sample_rate =
+            stats->period > 0U
+                ? 1000.0F *
+                      (float)(sensor.samples -
+                              termo_stats_last_sample.sensor_samples) /
+                      (float)stats->period
+                : 0.0F};
+
+    termo_stats_last_sample = sample;
+}
+
+#undef STATS_HOST_CLOCK_HZ
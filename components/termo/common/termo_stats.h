@@ -0,0 +1,85 @@
+#ifndef COMMON_TERMO_STATS_H
+#define COMMON_TERMO_STATS_H
+
+#include "FreeRTOS.h"
+#include "termo_manager.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct {
+    float cpu_load;
+    uint32_t stack_free;
+} termo_stats_task_t;
+
+typedef struct {
+    uint32_t depth;
+    uint32_t peak_depth;
+    uint32_t length;
+    uint32_t send_failed;
+} termo_stats_queue_t;
+
+// resolution in degrees, sample_rate counts fresh conversions per second
+typedef struct {
+    uint32_t errors;
+    uint32_t timeouts;
+    uint32_t duplicates;
+    float resolution;
+    float sample_rate;
+} termo_stats_sensor_t;
+
+// latest bus values overwritten before the display drew them, and the bytes
+// sent to the screen since boot and per second over the last stats window
+typedef struct {
+    uint32_t superseded;
+    uint32_t bytes_sent;
+    uint32_t bytes_per_second;
+} termo_stats_display_t;
+
+// ms from a new reference to the first compare update driven by it, and
+// from a measurement to its hand over to the uart, the latest of each
+typedef struct {
+    uint32_t reference;
+    uint32_t measure;
+} termo_stats_latency_t;
+
+// cpu_load is the share of wall time in percent since the previous sample,
+// covering period ms - stack_free is the stack high-water mark in bytes
+typedef struct {
+    uint32_t period;
+    termo_stats_task_t tasks[TERMO_TASK_TYPE_NUM];
+    termo_stats_queue_t queues[TERMO_QUEUE_TYPE_NUM];
+    termo_stats_sensor_t sensor;
+    termo_stats_display_t display;
+    termo_stats_latency_t latency;
+} termo_stats_t;
+
+// run time counter hooks of configGENERATE_RUN_TIME_STATS - DWT cycles on
+// the target, clock_gettime microseconds on the host
+void termo_stats_start_run_time_counter(void);
+uint32_t termo_stats_get_run_time_counter(void);
+uint32_t termo_stats_get_run_time_clock(void);
+
+// xQueueSend that keeps the peak depth and failed sends of the queue
+bool termo_stats_queue_send(termo_queue_type_t type,
+                            void const* item,
+                            TickType_t timeout);
+
+// failed and overrun temperature sensor transfers, counted since boot
+void termo_stats_count_sensor_error(void);
+void termo_stats_count_sensor_timeout(void);
+
+// duplicates were read before the sensor finished a new conversion
+void termo_stats_count_sensor_sample(bool is_duplicate);
+void termo_stats_set_sensor_resolution(float resolution);
+
+// counted since boot, like the sensor errors
+void termo_stats_count_display_superseded(uint32_t count);
+void termo_stats_set_display_bytes(uint32_t bytes_sent,
+                                   uint32_t bytes_per_second);
+
+void termo_stats_set_reference_latency(uint32_t latency);
+void termo_stats_set_measure_latency(uint32_t latency);
+
+void termo_stats_sample(termo_stats_t* stats);
+
+#endif // COMMON_TERMO_STATS_H
@@ -0,0 +1,134 @@
+#include "termo_trace.h"
+#include "FreeRTOS.h"
+#include "stm32l4xx_hal.h"
+#include "task.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef TERMO_HOST
+#include <time.h>
+#endif
+
+#define TRACE_ISR_NAME ("isr")
+#define TRACE_MAIN_NAME ("main")
+#define TRACE_HOST_CLOCK_HZ (1000000000UL)
+
+static termo_trace_event_t termo_trace_events[TERMO_TRACE_EVENT_NUM];
+static size_t termo_trace_head = 0UL;
+static size_t termo_trace_count = 0UL;
+static atomic_bool termo_trace_is_paused = false;
+
+static inline uint32_t termo_trace_get_timestamp(void)
+{
+#ifdef TERMO_HOST
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return (uint32_t)((uint64_t)time.tv_sec * TRACE_HOST_CLOCK_HZ +
+                      (uint64_t)time.tv_nsec);
+#else
+    return DWT->CYCCNT;
+#endif
+}
+
+static inline char const* termo_trace_get_task_name(void)
+{
+    if (xPortIsInsideInterrupt() == pdTRUE) {
+        return TRACE_ISR_NAME;
+    }
+
+    if (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED) {
+        return TRACE_MAIN_NAME;
+    }
+
+    return pcTaskGetName(NULL);
+}
+
+void termo_trace_initialize(void)
+{
+#ifndef TERMO_HOST
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0UL;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+    termo_trace_head = 0UL;
+    termo_trace_count = 0UL;
+    atomic_store(&termo_trace_is_paused, false);
+}
+
+uint32_t termo_trace_get_clock(void)
+{
+#ifdef TERMO_HOST
+    return TRACE_HOST_CLOCK_HZ;
+#else
+    return SystemCoreClock;
+#endif
+}
+
+void termo_trace_record(char const* name, termo_trace_phase_t phase)
+{
+    termo_trace_event_t event = {.name = name,
+                                 .task = termo_trace_get_task_name(),
+                                 .phase = phase};
+
+    // taking the timestamp inside the critical section keeps the ring
+    // ordered by time across tasks and isrs
+    UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+    if (atomic_load_explicit(&termo_trace_is_paused, memory_order_relaxed)) {
+        taskEXIT_CRITICAL_FROM_ISR(mask);
+        return;
+    }
+    event.timestamp = termo_trace_get_timestamp();
+    termo_trace_events[termo_trace_head] = event;
+    termo_trace_head = (termo_trace_head + 1UL) % TERMO_TRACE_EVENT_NUM;
+    if (termo_trace_count < TERMO_TRACE_EVENT_NUM) {
+        termo_trace_count++;
+    }
+    taskEXIT_CRITICAL_FROM_ISR(mask);
+}
+
+void termo_trace_scope_end(char const* const* name)
+{
+    termo_trace_record(*name, TERMO_TRACE_PHASE_END);
+}
+
+void termo_trace_pause(void)
+{
+    atomic_store(&termo_trace_is_paused, true);
+}
+
+// dumped events are dropped, so the next dump starts from fresh ones
+void termo_trace_resume(void)
+{
+    UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+    termo_trace_head = 0UL;
+    termo_trace_count = 0UL;
+    taskEXIT_CRITICAL_FROM_ISR(mask);
+
+    atomic_store(&termo_trace_is_paused, false);
+}
+
+size_t termo_trace_get_count(void)
+{
+    return termo_trace_count;
+}
+
+bool termo_trace_get_event(size_t index, termo_trace_event_t* event)
+{
+    if (event == NULL || index >= termo_trace_count) {
+        return false;
+    }
+
+    size_t oldest = (termo_trace_head + TERMO_TRACE_EVENT_NUM -
+                     termo_trace_count) %
+                    TERMO_TRACE_EVENT_NUM;
+    *event = termo_trace_events[(oldest + index) % TERMO_TRACE_EVENT_NUM];
+
+    return true;
+}
+
+#undef TRACE_ISR_NAME
+#undef TRACE_MAIN_NAME
+#undef TRACE_HOST_CLOCK_HZ
@@ -0,0 +1,67 @@
+#ifndef COMMON_TERMO_TRACE_H
+#define COMMON_TERMO_TRACE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// #define USE_TRACE
+
+#define TERMO_TRACE_EVENT_NUM (256U)
+
+typedef enum {
+    TERMO_TRACE_PHASE_BEGIN,
+    TERMO_TRACE_PHASE_END,
+} termo_trace_phase_t;
+
+typedef struct {
+    char const* name;
+    char const* task;
+    uint32_t timestamp;
+    termo_trace_phase_t phase;
+} termo_trace_event_t;
+
+// timestamps are DWT cycles on the target and clock_gettime nanoseconds on
+// the host, both wrap around - see termo_trace_get_clock for the unit
+void termo_trace_initialize(void);
+uint32_t termo_trace_get_clock(void);
+
+void termo_trace_record(char const* name, termo_trace_phase_t phase);
+void termo_trace_scope_end(char const* const* name);
+
+// the ring keeps the newest events, recording stops while it is dumped
+void termo_trace_pause(void);
+void termo_trace_resume(void);
+
+size_t termo_trace_get_count(void);
+bool termo_trace_get_event(size_t index, termo_trace_event_t* event);
+
+#ifdef USE_TRACE
+
+#define TERMO_TRACE_BEGIN(NAME) \
+    termo_trace_record((NAME), TERMO_TRACE_PHASE_BEGIN)
+
+#define TERMO_TRACE_END(NAME) termo_trace_record((NAME), TERMO_TRACE_PHASE_END)
+
+#define TERMO_TRACE_FUNC()                                                 \
+    [[gnu::cleanup(termo_trace_scope_end)]] char const* const trace_scope = \
+        __func__;                                                          \
+    TERMO_TRACE_BEGIN(trace_scope)
+
+#else
+
+#define TERMO_TRACE_BEGIN(NAME) \
+    do {                        \
+    } while (0)
+
+#define TERMO_TRACE_END(NAME) \
+    do {                      \
+    } while (0)
+
+#define TERMO_TRACE_FUNC() \
+    do {                   \
+    } while (0)
+
+#endif // USE_TRACE
+
+#endif // COMMON_TERMO_TRACE_H
@@ -12,6 +12,8 @@
 
 #define TERMO_DELAY(MS) vTaskDelay(pdMS_TO_TICKS(MS))
 
+#define TERMO_ARRAY_SIZE(ARRAY) (sizeof(ARRAY) / sizeof(*(ARRAY)))
+
 #define TERMO_PANIC()             \
     do {                          \
         taskDISABLE_INTERRUPTS(); \
@@ -29,9 +31,18 @@
 
 #ifdef DEBUG
 
+#ifdef USE_DEFERRED_LOG
+
+#define TERMO_LOG(TAG, FMT, ...) \
+    termo_log_deferred("[%s] " FMT "\n\r", TAG, ##__VA_ARGS__)
+
+#else
+
 #define TERMO_LOG(TAG, FMT, ...) \
     termo_log("[%s] " FMT "\n\r", TAG, ##__VA_ARGS__)
 
+#endif // USE_DEFERRED_LOG
+
 #define TERMO_LOG_FUNC(TAG) TERMO_LOG(TAG, "%s", __func__)
 
 #define TERMO_LOG_ON_ERR(TAG, ERR)                          \
@@ -4,22 +4,62 @@
 
 static char const* const TAG = "display_manager";
 
+static inline bool display_manager_wait_transmit_notify(void)
+{
+    TickType_t start = xTaskGetTickCount();
+    TickType_t timeout = pdMS_TO_TICKS(DISPLAY_TRANSMIT_TIMEOUT);
+    uint32_t pending = 0UL;
+    uint32_t notify = 0UL;
+
+    while ((notify & (DISPLAY_NOTIFY_TX_COMPLETE | DISPLAY_NOTIFY_TX_ERROR)) ==
+           0UL) {
+        TickType_t elapsed = xTaskGetTickCount() - start;
+        if (elapsed >= timeout ||
+            xTaskNotifyWait(0x00,
+                            DISPLAY_NOTIFY_ALL,
+                            &notify,
+                            timeout - elapsed) != pdPASS) {
+            break;
+        }
+        pending |= notify & DISPLAY_NOTIFY_EVENT;
+    }
+
+    if (pending != 0UL) {
+        xTaskNotify(xTaskGetCurrentTaskHandle(), pending, eSetBits);
+    }
+
+    return (notify & DISPLAY_NOTIFY_TX_COMPLETE) == DISPLAY_NOTIFY_TX_COMPLETE;
+}
+
 static sh1107_err_t sh1107_bus_transmit_data(void* user,
                                              uint8_t const* data,
                                              size_t data_size)
 {
+    TERMO_TRACE_FUNC();
     display_config_t* config = (display_config_t*)user;
 
     HAL_GPIO_WritePin(config->sh1107_slave_select_gpio,
                       config->sh1107_slave_select_pin,
                       GPIO_PIN_RESET);
-    HAL_StatusTypeDef err =
-        HAL_SPI_Transmit(config->sh1107_spi_bus, data, data_size, 100);
+
+    termo_power_lock_stop();
+
+    bool is_complete = false;
+    if (HAL_SPI_Transmit_DMA(config->sh1107_spi_bus, data, data_size) ==
+        HAL_OK) {
+        is_complete = display_manager_wait_transmit_notify();
+        if (!is_complete) {
+            HAL_SPI_Abort(config->sh1107_spi_bus);
+        }
+    }
+
+    termo_power_unlock_stop();
+
     HAL_GPIO_WritePin(config->sh1107_slave_select_gpio,
                       config->sh1107_slave_select_pin,
                       GPIO_PIN_SET);
 
-    return err == HAL_OK ? SH1107_ERR_OK : SH1107_ERR_FAIL;
+    return is_complete ? SH1107_ERR_OK : SH1107_ERR_FAIL;
 }
 
 static sh1107_err_t sh1107_bus_initialize(void* user)
@@ -65,35 +105,28 @@ static sh1107_err_t sh1107_gpio_write(void* user, uint32_t pin, bool state)
 
 static sh1107_err_t sh1107_initialize_chip(sh1107_t* sh1107)
 {
-    sh1107_gpio_write(sh1107->interface.bus_user, sh1107->config.reset_pin, 0);
-    HAL_Delay(100);
-    sh1107_gpio_write(sh1107->interface.bus_user, sh1107->config.reset_pin, 1);
-    HAL_Delay(100);
-
-    uint8_t cmd = (0xAE); // Display OFF
-    sh1107_bus_transmit_data(sh1107->interface.bus_user, &cmd, 1);
-    cmd = (0xD5); // Set Display Clock Divide Ratio
-    sh1107_bus_transmit_data(sh1107->interface.bus_user, &cmd, 1);
-    cmd = (0x80);
-    sh1107_bus_transmit_data(sh1107->interface.bus_user, &cmd, 1);
-    cmd = (0xA8); // Set Multiplex Ratio
-    sh1107_bus_transmit_data(sh1107->interface.bus_user, &cmd, 1);
-    cmd = (0x7F);
-    sh1107_bus_transmit_data(sh1107->interface.bus_user, &cmd, 1);
-    cmd = (0xD3); // Display Offset
-    sh1107_bus_transmit_data(sh1107->interface.bus_user, &cmd, 1);
-    cmd = (0x00);
-    sh1107_bus_transmit_data(sh1107->interface.bus_user, &cmd, 1);
-    cmd = (0x40); // Display Start Line
-    sh1107_bus_transmit_data(sh1107->interface.bus_user, &cmd, 1);
-    cmd = (0x8D); // Charge Pump
-    sh1107_bus_transmit_data(sh1107->interface.bus_user, &cmd, 1);
-    cmd = (0x14);
-    sh1107_bus_transmit_data(sh1107->interface.bus_user, &cmd, 1);
-    cmd = (0xAF); // Display // ON
-    sh1107_bus_transmit_data(sh1107->interface.bus_user, &cmd, 1);
-
-    return SH1107_ERR_OK;
+    static uint8_t const init_sequence[] = {
+        0xAE,       // Display OFF
+        0xD5, 0x80, // Set Display Clock Divide Ratio
+        0xA8, 0x7F, // Set Multiplex Ratio
+        0xD3, 0x00, // Display Offset
+        0x40,       // Display Start Line
+        0x8D, 0x14, // Charge Pump
+        0xAF,       // Display ON
+    };
+
+    sh1107_gpio_write(sh1107->interface.gpio_user, sh1107->config.reset_pin, 0);
+    TERMO_DELAY(100);
+    sh1107_gpio_write(sh1107->interface.gpio_user, sh1107->config.reset_pin, 1);
+    TERMO_DELAY(100);
+
+    sh1107_gpio_write(sh1107->interface.gpio_user,
+                      sh1107->config.control_pin,
+                      false);
+
+    return sh1107_bus_transmit_data(sh1107->interface.bus_user,
+                                    init_sequence,
+                                    sizeof(init_sequence));
 }
 
 static inline bool display_manager_send_system_event(
@@ -101,20 +134,27 @@ static inline bool display_manager_send_system_event(
 {
     TERMO_ASSERT(event != NULL);
 
-    return xQueueSend(termo_queue_manager_get(TERMO_QUEUE_TYPE_SYSTEM),
-                      event,
-                      pdMS_TO_TICKS(10)) == pdPASS;
+    if (!termo_stats_queue_send(TERMO_QUEUE_TYPE_SYSTEM,
+                                event,
+                                pdMS_TO_TICKS(10))) {
+        return false;
+    }
+
+    return xTaskNotify(termo_task_manager_get(TERMO_TASK_TYPE_SYSTEM),
+                       SYSTEM_NOTIFY_EVENT,
+                       eSetBits) == pdPASS;
 }
 
 static inline bool display_manager_receive_display_notify(
-    display_notify_t* notify)
+    display_notify_t* notify,
+    TickType_t timeout)
 {
     TERMO_ASSERT(notify != NULL);
 
     return xTaskNotifyWait(0x00,
                            DISPLAY_NOTIFY_ALL,
                            (uint32_t*)notify,
-                           pdMS_TO_TICKS(10)) == pdPASS;
+                           timeout) == pdPASS;
 }
 
 static inline bool display_manager_has_display_event(void)
@@ -129,12 +169,185 @@ static inline bool display_manager_receive_display_event(display_event_t* event)
 
     return xQueueReceive(termo_queue_manager_get(TERMO_QUEUE_TYPE_DISPLAY),
                          event,
-                         pdMS_TO_TICKS(10)) == pdPASS;
+                         0U) == pdPASS;
+}
+
+static_assert(FONT5X7_LINE_HEIGHT == DISPLAY_PAGE_HEIGHT,
+              "display lines must map onto sh1107 pages");
+static_assert(DISPLAY_PAGE_NUM <= 32U, "dirty page mask is 32 bits wide");
+
+static inline void display_manager_mark_all_dirty(display_manager_t* manager)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    manager->dirty_pages = (uint32_t)((1ULL << DISPLAY_PAGE_NUM) - 1ULL);
+}
+
+static void display_manager_clear(display_manager_t* manager)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    sh1107_clear_frame_buffer(&manager->sh1107);
+    memset(manager->line_texts, 0, sizeof(manager->line_texts));
+    display_manager_mark_all_dirty(manager);
+}
+
+static inline void display_manager_reset_stats(display_manager_t* manager)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    manager->bytes_per_second = 0UL;
+    manager->stats_window_bytes = 0UL;
+    manager->stats_window_start = HAL_GetTick();
+
+    termo_stats_set_display_bytes(manager->bytes_sent,
+                                  manager->bytes_per_second);
+}
+
+static void display_manager_update_stats(display_manager_t* manager)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    uint32_t elapsed = HAL_GetTick() - manager->stats_window_start;
+    if (elapsed < DISPLAY_STATS_WINDOW) {
+        return;
+    }
+
+    manager->bytes_per_second = (uint32_t)(
+        ((uint64_t)manager->stats_window_bytes * 1000ULL) / elapsed);
+    manager->stats_window_bytes = 0UL;
+    manager->stats_window_start += elapsed;
+
+    termo_stats_set_display_bytes(manager->bytes_sent,
+                                  manager->bytes_per_second);
+}
+
+// a running display wakes when its stats window closes even with nothing to
+// draw, so the rate covers one window and not the time since the last draw
+static inline TickType_t display_manager_get_notify_timeout(
+    display_manager_t const* manager)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    if (!manager->is_running) {
+        return portMAX_DELAY;
+    }
+
+    uint32_t elapsed = HAL_GetTick() - manager->stats_window_start;
+    if (elapsed >= DISPLAY_STATS_WINDOW) {
+        return 0U;
+    }
+
+    return pdMS_TO_TICKS(DISPLAY_STATS_WINDOW - elapsed);
+}
+
+static sh1107_err_t display_manager_transmit(display_manager_t* manager,
+                                             bool is_data,
+                                             uint8_t const* data,
+                                             size_t data_size)
+{
+    TERMO_ASSERT(manager != NULL);
+    TERMO_ASSERT(data != NULL);
+
+    sh1107_interface_t const* interface = &manager->sh1107.interface;
+
+    interface->gpio_write(interface->gpio_user,
+                          manager->sh1107.config.control_pin,
+                          is_data);
+    sh1107_err_t err =
+        interface->bus_transmit(interface->bus_user, data, data_size);
+    if (err == SH1107_ERR_OK) {
+        manager->bytes_sent += data_size;
+        manager->stats_window_bytes += data_size;
+    }
+
+    return err;
+}
+
+static termo_err_t display_manager_flush_dirty_pages(
+    display_manager_t* manager)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    size_t frame_width = manager->sh1107.config.frame_width;
+
+    for (uint8_t page = 0U; page < DISPLAY_PAGE_NUM; ++page) {
+        if ((manager->dirty_pages & (1UL << page)) == 0UL) {
+            continue;
+        }
+
+        uint8_t address[] = {0xB0U | page, 0x00U, 0x10U};
+        if (display_manager_transmit(manager,
+                                     false,
+                                     address,
+                                     sizeof(address)) != SH1107_ERR_OK ||
+            display_manager_transmit(
+                manager,
+                true,
+                manager->sh1107_frame_buffer + page * frame_width,
+                frame_width) != SH1107_ERR_OK) {
+            return TERMO_ERR_FAIL;
+        }
+
+        manager->dirty_pages &= ~(1UL << page);
+    }
+
+    return TERMO_ERR_OK;
+}
+
+static void display_manager_draw_line(display_manager_t* manager,
+                                      uint8_t line,
+                                      char const* text)
+{
+    TERMO_ASSERT(manager != NULL);
+    TERMO_ASSERT(line < DISPLAY_LINE_NUM);
+    TERMO_ASSERT(text != NULL);
+
+    char* line_text = manager->line_texts[line];
+    if (strncmp(line_text, text, DISPLAY_LINE_TEXT_SIZE) == 0) {
+        return;
+    }
+    termo_format_string(line_text, DISPLAY_LINE_TEXT_SIZE, text);
+
+    size_t frame_width = manager->sh1107.config.frame_width;
+    memset(manager->sh1107_frame_buffer + line * frame_width,
+           0,
+           frame_width);
+    font5x7_draw_string(manager->sh1107_frame_buffer,
+                        frame_width,
+                        manager->sh1107.config.frame_height,
+                        0UL,
+                        line * FONT5X7_LINE_HEIGHT,
+                        line_text);
+
+    manager->dirty_pages |= (1UL << line);
+}
+
+static void display_manager_draw_value(display_manager_t* manager,
+                                       uint8_t line,
+                                       char const* label,
+                                       float value,
+                                       char const* unit)
+{
+    TERMO_ASSERT(manager != NULL);
+    TERMO_ASSERT(label != NULL);
+    TERMO_ASSERT(unit != NULL);
+
+    char text[DISPLAY_LINE_TEXT_SIZE];
+    size_t text_len = termo_format_string(text, sizeof(text), label);
+    text_len += termo_format_float(text + text_len,
+                                   sizeof(text) - text_len,
+                                   value,
+                                   DISPLAY_VALUE_DECIMALS);
+    termo_format_string(text + text_len, sizeof(text) - text_len, unit);
+
+    display_manager_draw_line(manager, line, text);
 }
 
 static termo_err_t display_manager_notify_handler(display_manager_t* manager,
                                                   display_notify_t notify)
 {
+    TERMO_TRACE_FUNC();
     TERMO_ASSERT(manager != NULL);
 
     return TERMO_ERR_OK;
@@ -144,6 +357,7 @@ static termo_err_t display_manager_event_start_handler(
     display_manager_t* manager,
     display_event_payload_start_t const* start)
 {
+    TERMO_TRACE_FUNC();
     TERMO_LOG_FUNC(TAG);
     TERMO_ASSERT(manager != NULL);
     TERMO_ASSERT(start != NULL);
@@ -159,8 +373,8 @@ static termo_err_t display_manager_event_start_handler(
         return TERMO_ERR_FAIL;
     }
 
-    sh1107_clear_frame_buffer(&manager->sh1107);
-    sh1107_display_frame_buffer(&manager->sh1107);
+    display_manager_clear(manager);
+    display_manager_reset_stats(manager);
 
     manager->is_running = true;
 
@@ -171,6 +385,7 @@ static termo_err_t display_manager_event_stop_handler(
     display_manager_t* manager,
     display_event_payload_stop_t const* stop)
 {
+    TERMO_TRACE_FUNC();
     TERMO_LOG_FUNC(TAG);
     TERMO_ASSERT(manager != NULL);
     TERMO_ASSERT(stop != NULL);
@@ -186,49 +401,49 @@ static termo_err_t display_manager_event_stop_handler(
         return TERMO_ERR_FAIL;
     }
 
-    sh1107_clear_frame_buffer(&manager->sh1107);
-    sh1107_display_frame_buffer(&manager->sh1107);
+    display_manager_clear(manager);
+    display_manager_reset_stats(manager);
 
     manager->is_running = false;
 
     return TERMO_ERR_OK;
 }
 
-static termo_err_t display_manager_event_reference_handler(
+static termo_err_t display_manager_latest_reference_handler(
     display_manager_t* manager,
-    display_event_payload_reference_t const* reference)
+    termo_bus_payload_reference_t const* reference)
 {
+    TERMO_TRACE_FUNC();
     TERMO_LOG_FUNC(TAG);
     TERMO_ASSERT(manager != NULL);
     TERMO_ASSERT(reference != NULL);
 
-    manager->reference_temperature = reference->temperature;
+    // only the first zone fits on the screen
+    if (reference->zone == 0U) {
+        manager->reference_temperature = reference->temperature;
+    }
     manager->update_time = reference->update_time;
 
-    sh1107_draw_string_formatted(&manager->sh1107,
-                                 0,
-                                 1 * FONT5X7_LINE_HEIGHT,
-                                 "Reference: ");
-    sh1107_draw_string_formatted(&manager->sh1107,
-                                 0,
-                                 2 * FONT5X7_LINE_HEIGHT,
-                                 "-temperature: %.2f [*C]",
-                                 manager->reference_temperature);
-    sh1107_draw_string_formatted(&manager->sh1107,
-                                 0,
-                                 3 * FONT5X7_LINE_HEIGHT,
-                                 "-update_time: %.2f [s]",
-                                 manager->update_time);
-
-    sh1107_display_frame_buffer(&manager->sh1107);
+    display_manager_draw_line(manager, 1, "Reference: ");
+    display_manager_draw_value(manager,
+                               2,
+                               "-temperature: ",
+                               manager->reference_temperature,
+                               " [*C]");
+    display_manager_draw_value(manager,
+                               3,
+                               "-update_time: ",
+                               manager->update_time,
+                               " [s]");
 
     return TERMO_ERR_OK;
 }
 
-static termo_err_t display_manager_event_measure_handler(
+static termo_err_t display_manager_latest_measure_handler(
     display_manager_t* manager,
-    display_event_payload_measure_t const* measure)
+    termo_bus_payload_measure_t const* measure)
 {
+    TERMO_TRACE_FUNC();
     TERMO_LOG_FUNC(TAG);
     TERMO_ASSERT(manager != NULL);
     TERMO_ASSERT(measure != NULL);
@@ -237,27 +452,48 @@ static termo_err_t display_manager_event_measure_handler(
     manager->measure_pressure = measure->pressure;
     manager->measure_humidity = measure->humidity;
 
-    sh1107_draw_string_formatted(&manager->sh1107,
-                                 0,
-                                 5 * FONT5X7_LINE_HEIGHT,
-                                 "Measure: ");
-    sh1107_draw_string_formatted(&manager->sh1107,
-                                 0,
-                                 6 * FONT5X7_LINE_HEIGHT,
-                                 "-temperature: %.2f [*C]",
-                                 manager->measure_temperature);
-    sh1107_draw_string_formatted(&manager->sh1107,
-                                 0,
-                                 7 * FONT5X7_LINE_HEIGHT,
-                                 "-pressure: %.2f [hPa]",
-                                 manager->measure_pressure);
-    sh1107_draw_string_formatted(&manager->sh1107,
-                                 0,
-                                 8 * FONT5X7_LINE_HEIGHT,
-                                 "-humidity: %.2f [%%]",
-                                 manager->measure_humidity);
-
-    sh1107_display_frame_buffer(&manager->sh1107);
+    display_manager_draw_line(manager, 5, "Measure: ");
+    display_manager_draw_value(manager,
+                               6,
+                               "-temperature: ",
+                               manager->measure_temperature,
+                               " [*C]");
+    display_manager_draw_value(manager,
+                               7,
+                               "-pressure: ",
+                               manager->measure_pressure,
+                               " [hPa]");
+    display_manager_draw_value(manager,
+                               8,
+                               "-humidity: ",
+                               manager->measure_humidity,
+                               " [%]");
+
+    return TERMO_ERR_OK;
+}
+
+static termo_err_t display_manager_latest_control_handler(
+    display_manager_t* manager,
+    termo_bus_payload_control_t const* control)
+{
+    TERMO_TRACE_FUNC();
+    TERMO_ASSERT(manager != NULL);
+    TERMO_ASSERT(control != NULL);
+
+    manager->control_error = control->error;
+    manager->control_duty = control->duty;
+
+    display_manager_draw_line(manager, 10, "Control: ");
+    display_manager_draw_value(manager,
+                               11,
+                               "-error: ",
+                               manager->control_error,
+                               " [*C]");
+    display_manager_draw_value(manager,
+                               12,
+                               "-duty: ",
+                               manager->control_duty,
+                               " [%]");
 
     return TERMO_ERR_OK;
 }
@@ -265,6 +501,7 @@ static termo_err_t display_manager_event_measure_handler(
 static termo_err_t display_manager_event_handler(display_manager_t* manager,
                                                  display_event_t const* event)
 {
+    TERMO_TRACE_FUNC();
     TERMO_ASSERT(manager != NULL);
     TERMO_ASSERT(event != NULL);
 
@@ -277,28 +514,75 @@ static termo_err_t display_manager_event_handler(display_manager_t* manager,
             return display_manager_event_stop_handler(manager,
                                                       &event->payload.stop);
         }
-        case DISPLAY_EVENT_TYPE_REFERENCE: {
-            return display_manager_event_reference_handler(
-                manager,
-                &event->payload.reference);
-        }
-        case DISPLAY_EVENT_TYPE_MEASURE: {
-            return display_manager_event_measure_handler(
-                manager,
-                &event->payload.measure);
-        }
         default: {
             return TERMO_ERR_UNKNOWN_EVENT;
         }
     }
 }
 
+// whatever was published since the previous read is counted as superseded
+static bool display_manager_read_topic(termo_bus_topic_t topic,
+                                       termo_mailbox_reader_t* reader,
+                                       termo_bus_payload_t* payload)
+{
+    TERMO_ASSERT(reader != NULL);
+    TERMO_ASSERT(payload != NULL);
+
+    uint32_t superseded = reader->superseded;
+    bool has_payload = termo_bus_read_latest(topic, reader, payload);
+    if (reader->superseded != superseded) {
+        termo_stats_count_display_superseded(reader->superseded - superseded);
+    }
+
+    return has_payload;
+}
+
+// only the freshest values are drawn
+static termo_err_t display_manager_read_latest(display_manager_t* manager)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    if (!manager->is_running) {
+        return TERMO_ERR_OK;
+    }
+
+    termo_bus_payload_t payload;
+    if (display_manager_read_topic(TERMO_BUS_TOPIC_REFERENCE,
+                                   &manager->reference_reader,
+                                   &payload)) {
+        TERMO_RET_ON_ERR(
+            display_manager_latest_reference_handler(manager,
+                                                     &payload.reference));
+    }
+
+    if (display_manager_read_topic(TERMO_BUS_TOPIC_MEASURE,
+                                   &manager->measure_reader,
+                                   &payload)) {
+        TERMO_RET_ON_ERR(
+            display_manager_latest_measure_handler(manager, &payload.measure));
+    }
+
+    if (display_manager_read_topic(TERMO_BUS_TOPIC_CONTROL,
+                                   &manager->control_reader,
+                                   &payload)) {
+        TERMO_RET_ON_ERR(
+            display_manager_latest_control_handler(manager, &payload.control));
+    }
+
+    return TERMO_ERR_OK;
+}
+
 termo_err_t display_manager_process(display_manager_t* manager)
 {
     TERMO_ASSERT(manager != NULL);
 
     display_notify_t notify;
-    if (display_manager_receive_display_notify(&notify)) {
+    bool has_notify = display_manager_receive_display_notify(
+        &notify,
+        display_manager_get_notify_timeout(manager));
+
+    TERMO_TRACE_FUNC();
+    if (has_notify) {
         TERMO_RET_ON_ERR(display_manager_notify_handler(manager, notify));
     }
 
@@ -309,6 +593,13 @@ termo_err_t display_manager_process(display_manager_t* manager)
         }
     }
 
+    TERMO_RET_ON_ERR(display_manager_read_latest(manager));
+
+    if (manager->dirty_pages != 0UL) {
+        TERMO_RET_ON_ERR(display_manager_flush_dirty_pages(manager));
+    }
+    display_manager_update_stats(manager);
+
     return TERMO_ERR_OK;
 }
 
@@ -324,6 +615,17 @@ termo_err_t display_manager_initialize(display_manager_t* manager,
     memset(manager->sh1107_frame_buffer,
            0,
            sizeof(manager->sh1107_frame_buffer));
+    memset(manager->line_texts, 0, sizeof(manager->line_texts));
+
+    manager->dirty_pages = 0UL;
+
+    manager->reference_reader = (termo_mailbox_reader_t){};
+    manager->measure_reader = (termo_mailbox_reader_t){};
+    manager->control_reader = (termo_mailbox_reader_t){};
+    manager->bytes_sent = 0UL;
+    manager->bytes_per_second = 0UL;
+    manager->stats_window_bytes = 0UL;
+    manager->stats_window_start = HAL_GetTick();
 
     sh1107_initialize(
         &manager->sh1107,
@@ -344,7 +646,9 @@ termo_err_t display_manager_initialize(display_manager_t* manager,
                               .gpio_initialize = sh1107_gpio_initialize,
                               .gpio_deinitialize = sh1107_gpio_deinitialize,
                               .gpio_write = sh1107_gpio_write});
-    sh1107_initialize_chip(&manager->sh1107);
+    if (sh1107_initialize_chip(&manager->sh1107) != SH1107_ERR_OK) {
+        return TERMO_ERR_FAIL;
+    }
 
     system_event_t event = {.origin = SYSTEM_EVENT_ORIGIN_DISPLAY,
                             .type = SYSTEM_EVENT_TYPE_DISPLAY_READY,
@@ -8,6 +8,14 @@
 #include "termo_common.h"
 #include <stdint.h>
 
+#define DISPLAY_LINE_TEXT_SIZE (32U)
+#define DISPLAY_VALUE_DECIMALS (2U)
+#define DISPLAY_PAGE_HEIGHT (8U)
+#define DISPLAY_PAGE_NUM (SH1107_SCREEN_HEIGHT / DISPLAY_PAGE_HEIGHT)
+#define DISPLAY_LINE_NUM (SH1107_SCREEN_HEIGHT / FONT5X7_LINE_HEIGHT)
+#define DISPLAY_STATS_WINDOW (1000U)
+#define DISPLAY_TRANSMIT_TIMEOUT (100U)
+
 typedef struct {
     SPI_HandleTypeDef* sh1107_spi_bus;
     GPIO_TypeDef* sh1107_slave_select_gpio;
@@ -25,12 +33,27 @@ typedef struct {
     sh1107_t sh1107;
     uint8_t sh1107_frame_buffer[SH1107_FRAME_BUFFER_SIZE];
 
+    uint32_t dirty_pages;
+    char line_texts[DISPLAY_LINE_NUM][DISPLAY_LINE_TEXT_SIZE];
+
+    uint32_t bytes_sent;
+    uint32_t bytes_per_second;
+    uint32_t stats_window_bytes;
+    uint32_t stats_window_start;
+
     float reference_temperature;
     float update_time;
 
     float measure_temperature;
     float measure_pressure;
     float measure_humidity;
+
+    float control_error;
+    float control_duty;
+
+    termo_mailbox_reader_t reference_reader;
+    termo_mailbox_reader_t measure_reader;
+    termo_mailbox_reader_t control_reader;
 } display_manager_t;
 
 termo_err_t display_manager_process(display_manager_t* manager);
@@ -25,7 +25,6 @@ static void display_task_func(void* ctx)
     while (1) {
         TERMO_LOG_ON_ERR(pcTaskGetName(NULL),
                          display_manager_process(&manager));
-        TERMO_DELAY(10);
     }
 }
 
@@ -72,4 +71,24 @@ termo_err_t display_task_initialize(display_task_ctx_t const* task_ctx)
     termo_queue_manager_set(TERMO_QUEUE_TYPE_DISPLAY, display_queue);
 
     return TERMO_ERR_OK;
+}
+
+void display_task_tx_complete_callback(void)
+{
+    BaseType_t task_woken = pdFALSE;
+    xTaskNotifyFromISR(termo_task_manager_get(TERMO_TASK_TYPE_DISPLAY),
+                       DISPLAY_NOTIFY_TX_COMPLETE,
+                       eSetBits,
+                       &task_woken);
+    portYIELD_FROM_ISR(task_woken);
+}
+
+void display_task_tx_error_callback(void)
+{
+    BaseType_t task_woken = pdFALSE;
+    xTaskNotifyFromISR(termo_task_manager_get(TERMO_TASK_TYPE_DISPLAY),
+                       DISPLAY_NOTIFY_TX_ERROR,
+                       eSetBits,
+                       &task_woken);
+    portYIELD_FROM_ISR(task_woken);
 }
\ No newline at end of file
@@ -10,4 +10,7 @@ typedef struct {
 
 termo_err_t display_task_initialize(display_task_ctx_t const* task_ctx);
 
+void display_task_tx_complete_callback(void);
+void display_task_tx_error_callback(void);
+
 #endif // DISPLAY_TASK_DISPLAY_TASK_H
\ No newline at end of file
@@ -1,6 +1,6 @@
 #include "font5x7.h"
 
-uint8_t font5x7[96][5] = {
+uint8_t const font5x7[FONT5X7_CHARS][FONT5X7_WIDTH] = {
     {0x00, 0x00, 0x00, 0x00, 0x00}, // (space)
     {0x00, 0x00, 0x5F, 0x00, 0x00}, // !
     {0x00, 0x07, 0x00, 0x07, 0x00}, // "
@@ -97,4 +97,105 @@ uint8_t font5x7[96][5] = {
     {0x00, 0x41, 0x36, 0x08, 0x00}, // }
     {0x08, 0x08, 0x2A, 0x1C, 0x08}, // ->
     {0x08, 0x1C, 0x2A, 0x08, 0x08}  // <-
-};
\ No newline at end of file
+};
+
+static inline uint8_t const* font5x7_get_glyph(char c)
+{
+    size_t index = (size_t)(unsigned char)c - FONT5X7_CHAR_CODE_OFFSET;
+    if (index >= FONT5X7_CHARS) {
+        index = 0UL;
+    }
+
+    return font5x7[index];
+}
+
+static inline void font5x7_blit_column(uint8_t* column,
+                                       size_t frame_width,
+                                       size_t pages,
+                                       size_t page,
+                                       size_t shift,
+                                       uint8_t bits)
+{
+    uint16_t mask = (uint16_t)(((1U << FONT5X7_HEIGHT) - 1U) << shift);
+    uint16_t value = (uint16_t)(bits << shift);
+
+    column[0] = (uint8_t)((column[0] & ~mask) | (value & 0xFFU));
+    if ((mask >> 8U) != 0U && page + 1UL < pages) {
+        column[frame_width] = (uint8_t)((column[frame_width] & ~(mask >> 8U)) |
+                                        (value >> 8U));
+    }
+}
+
+size_t font5x7_draw_char(uint8_t* frame_buffer,
+                         size_t frame_width,
+                         size_t frame_height,
+                         size_t x,
+                         size_t y,
+                         char c)
+{
+    if (frame_buffer == NULL || x >= frame_width ||
+        y + FONT5X7_HEIGHT > frame_height) {
+        return 0UL;
+    }
+
+    uint8_t const* glyph = font5x7_get_glyph(c);
+    size_t width = frame_width - x;
+    if (width > FONT5X7_CHAR_WIDTH) {
+        width = FONT5X7_CHAR_WIDTH;
+    }
+
+    size_t page = y / FONT5X7_PAGE_HEIGHT;
+    size_t shift = y % FONT5X7_PAGE_HEIGHT;
+    uint8_t* column = frame_buffer + page * frame_width + x;
+
+    // the row under the glyph belongs to the line spacing and is kept, the
+    // same as the unaligned blit does
+    if (shift == 0UL) {
+        uint8_t keep = (uint8_t)~((1U << FONT5X7_HEIGHT) - 1U);
+        for (size_t index = 0UL; index < width; ++index) {
+            column[index] =
+                (uint8_t)((column[index] & keep) |
+                          (index < FONT5X7_WIDTH ? glyph[index] : 0x00U));
+        }
+    } else {
+        size_t pages = frame_height / FONT5X7_PAGE_HEIGHT;
+        for (size_t index = 0UL; index < width; ++index) {
+            font5x7_blit_column(column + index,
+                                frame_width,
+                                pages,
+                                page,
+                                shift,
+                                index < FONT5X7_WIDTH ? glyph[index] : 0x00U);
+        }
+    }
+
+    return width;
+}
+
+size_t font5x7_draw_string(uint8_t* frame_buffer,
+                           size_t frame_width,
+                           size_t frame_height,
+                           size_t x,
+                           size_t y,
+                           char const* string)
+{
+    if (string == NULL) {
+        return 0UL;
+    }
+
+    size_t start = x;
+    for (; *string != '\0'; ++string) {
+        size_t width = font5x7_draw_char(frame_buffer,
+                                         frame_width,
+                                         frame_height,
+                                         x,
+                                         y,
+                                         *string);
+        if (width == 0UL) {
+            break;
+        }
+        x += width;
+    }
+
+    return x - start;
+}
@@ -1,6 +1,7 @@
 #ifndef DISPLAY_UTILITY_FONT5x7_H
 #define DISPLAY_UTILITY_FONT5x7_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #define FONT5X7_CHAR_CODE_OFFSET (32UL)
@@ -9,7 +10,22 @@
 #define FONT5X7_LINE_HEIGHT (FONT5X7_HEIGHT + 1UL)
 #define FONT5X7_CHAR_WIDTH (FONT5X7_WIDTH + 1UL)
 #define FONT5X7_CHARS (96UL)
+#define FONT5X7_PAGE_HEIGHT (8UL)
 
-extern uint8_t font5x7[FONT5X7_CHARS][5];
+extern uint8_t const font5x7[FONT5X7_CHARS][FONT5X7_WIDTH];
+
+size_t font5x7_draw_char(uint8_t* frame_buffer,
+                         size_t frame_width,
+                         size_t frame_height,
+                         size_t x,
+                         size_t y,
+                         char c);
+
+size_t font5x7_draw_string(uint8_t* frame_buffer,
+                           size_t frame_width,
+                           size_t frame_height,
+                           size_t x,
+                           size_t y,
+                           char const* string);
 
 #endif // DISPLAY_UTILITY_FONT5x7_H
\ No newline at end of file
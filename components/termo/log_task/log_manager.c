@@ -0,0 +1,134 @@
+#include "log_manager.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "task.h"
+#include "termo_common.h"
+#include <string.h>
+
+static char const* const TAG = "log_manager";
+
+static inline bool log_manager_receive_log_notify(log_notify_t* notify)
+{
+    TERMO_ASSERT(notify != NULL);
+
+    return xTaskNotifyWait(0x00,
+                           LOG_NOTIFY_ALL,
+                           (uint32_t*)notify,
+                           portMAX_DELAY) == pdPASS;
+}
+
+static inline bool log_manager_wait_transmit_notify(void)
+{
+    TickType_t start = xTaskGetTickCount();
+    TickType_t timeout = pdMS_TO_TICKS(LOG_TRANSMIT_TIMEOUT);
+    uint32_t notify = 0UL;
+
+    while ((notify & (LOG_NOTIFY_TX_COMPLETE | LOG_NOTIFY_TX_ERROR)) == 0UL) {
+        TickType_t elapsed = xTaskGetTickCount() - start;
+        if (elapsed >= timeout ||
+            xTaskNotifyWait(0x00,
+                            LOG_NOTIFY_TX_COMPLETE | LOG_NOTIFY_TX_ERROR,
+                            &notify,
+                            timeout - elapsed) != pdPASS) {
+            break;
+        }
+    }
+
+    return (notify & LOG_NOTIFY_TX_COMPLETE) == LOG_NOTIFY_TX_COMPLETE;
+}
+
+// shares the log semaphore with _write, so plain termo_log output and the
+// deferred stream never interleave on the bus
+static bool log_manager_transmit(log_manager_t* manager, size_t size)
+{
+    TERMO_TRACE_FUNC();
+    TERMO_ASSERT(manager != NULL);
+
+    SemaphoreHandle_t semaphore =
+        termo_semaphore_manager_get(TERMO_SEMAPHORE_TYPE_LOG);
+    if (xSemaphoreTake(semaphore, pdMS_TO_TICKS(LOG_TRANSMIT_TIMEOUT)) !=
+        pdPASS) {
+        return false;
+    }
+
+    termo_power_lock_stop();
+
+    bool is_complete = false;
+    if (HAL_UART_Transmit_DMA(manager->config.log_uart_bus,
+                              manager->transmit_buffer,
+                              (uint16_t)size) == HAL_OK) {
+        is_complete = log_manager_wait_transmit_notify();
+        if (!is_complete) {
+            HAL_UART_AbortTransmit(manager->config.log_uart_bus);
+        }
+    }
+
+    termo_power_unlock_stop();
+
+    xSemaphoreGive(semaphore);
+
+    return is_complete;
+}
+
+static termo_err_t log_manager_notify_data_handler(log_manager_t* manager)
+{
+    TERMO_TRACE_FUNC();
+    TERMO_ASSERT(manager != NULL);
+
+    uint32_t dropped = termo_log_get_dropped();
+    if (dropped > 0U) {
+        TERMO_LOG(TAG, "dropped %lu records", dropped);
+    }
+
+    size_t size;
+    while ((size = termo_log_read(manager->transmit_buffer,
+                                  sizeof(manager->transmit_buffer))) > 0UL) {
+        if (!log_manager_transmit(manager, size)) {
+            ++manager->transmit_failed;
+            return TERMO_ERR_FAIL;
+        }
+    }
+
+    return TERMO_ERR_OK;
+}
+
+static termo_err_t log_manager_notify_handler(log_manager_t* manager,
+                                              log_notify_t notify)
+{
+    TERMO_TRACE_FUNC();
+    TERMO_ASSERT(manager != NULL);
+
+    if ((notify & LOG_NOTIFY_DATA) == LOG_NOTIFY_DATA) {
+        TERMO_RET_ON_ERR(log_manager_notify_data_handler(manager));
+    }
+
+    return TERMO_ERR_OK;
+}
+
+termo_err_t log_manager_process(log_manager_t* manager)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    log_notify_t notify;
+    bool has_notify = log_manager_receive_log_notify(&notify);
+
+    TERMO_TRACE_FUNC();
+    if (has_notify) {
+        TERMO_RET_ON_ERR(log_manager_notify_handler(manager, notify));
+    }
+
+    return TERMO_ERR_OK;
+}
+
+termo_err_t log_manager_initialize(log_manager_t* manager,
+                                   log_config_t const* config)
+{
+    TERMO_ASSERT(manager != NULL);
+    TERMO_ASSERT(config != NULL);
+
+    memset(manager->transmit_buffer, 0, sizeof(manager->transmit_buffer));
+    manager->transmit_failed = 0U;
+    manager->config = *config;
+
+    return TERMO_ERR_OK;
+}
@@ -0,0 +1,27 @@
+#ifndef LOG_TASK_LOG_MANAGER_H
+#define LOG_TASK_LOG_MANAGER_H
+
+#include "stm32l476xx.h"
+#include "stm32l4xx_hal.h"
+#include "termo_common.h"
+#include <stdint.h>
+
+#define LOG_TRANSMIT_BUFFER_SIZE (256U)
+#define LOG_TRANSMIT_TIMEOUT (100U)
+
+typedef struct {
+    UART_HandleTypeDef* log_uart_bus;
+} log_config_t;
+
+typedef struct {
+    uint8_t transmit_buffer[LOG_TRANSMIT_BUFFER_SIZE];
+    uint32_t transmit_failed;
+
+    log_config_t config;
+} log_manager_t;
+
+termo_err_t log_manager_process(log_manager_t* manager);
+termo_err_t log_manager_initialize(log_manager_t* manager,
+                                   log_config_t const* config);
+
+#endif // LOG_TASK_LOG_MANAGER_H
@@ -0,0 +1,69 @@
+#include "log_task.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "termo_common.h"
+
+#define LOG_TASK_STACK_DEPTH (2000UL / sizeof(StackType_t))
+#define LOG_TASK_NAME ("log_task")
+#define LOG_TASK_PRIORITY (tskIDLE_PRIORITY)
+
+static void log_task_func(void* ctx)
+{
+    log_task_ctx_t* task_ctx = (log_task_ctx_t*)ctx;
+
+    log_manager_t manager;
+    TERMO_LOG_ON_ERR(pcTaskGetName(NULL),
+                     log_manager_initialize(&manager, &task_ctx->config));
+
+    while (1) {
+        TERMO_LOG_ON_ERR(pcTaskGetName(NULL), log_manager_process(&manager));
+    }
+}
+
+TaskHandle_t log_task_create_log_task(log_task_ctx_t const* task_ctx)
+{
+    static StaticTask_t log_task_buffer;
+    static StackType_t log_task_stack[LOG_TASK_STACK_DEPTH];
+
+    return xTaskCreateStatic(log_task_func,
+                             LOG_TASK_NAME,
+                             LOG_TASK_STACK_DEPTH,
+                             task_ctx,
+                             LOG_TASK_PRIORITY,
+                             log_task_stack,
+                             &log_task_buffer);
+}
+
+termo_err_t log_task_initialize(log_task_ctx_t const* task_ctx)
+{
+    TERMO_ASSERT(task_ctx != NULL);
+
+    TaskHandle_t log_task = log_task_create_log_task(task_ctx);
+    if (log_task == NULL) {
+        return TERMO_ERR_FAIL;
+    }
+    termo_task_manager_set(TERMO_TASK_TYPE_LOG, log_task);
+
+    return TERMO_ERR_OK;
+}
+
+void log_task_tx_complete_callback(void)
+{
+    BaseType_t task_woken = pdFALSE;
+    xTaskNotifyFromISR(termo_task_manager_get(TERMO_TASK_TYPE_LOG),
+                       LOG_NOTIFY_TX_COMPLETE,
+                       eSetBits,
+                       &task_woken);
+    portYIELD_FROM_ISR(task_woken);
+}
+
+void log_task_tx_error_callback(void)
+{
+    BaseType_t task_woken = pdFALSE;
+    xTaskNotifyFromISR(termo_task_manager_get(TERMO_TASK_TYPE_LOG),
+                       LOG_NOTIFY_TX_ERROR,
+                       eSetBits,
+                       &task_woken);
+    portYIELD_FROM_ISR(task_woken);
+}
+
@@ -0,0 +1,16 @@
+#ifndef LOG_TASK_LOG_TASK_H
+#define LOG_TASK_LOG_TASK_H
+
+#include "log_manager.h"
+#include "termo_common.h"
+
+typedef struct {
+    log_config_t config;
+} log_task_ctx_t;
+
+termo_err_t log_task_initialize(log_task_ctx_t const* task_ctx);
+
+void log_task_tx_complete_callback(void);
+void log_task_tx_error_callback(void);
+
+#endif // LOG_TASK_LOG_TASK_H
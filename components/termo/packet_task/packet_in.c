@@ -1,5 +1,6 @@
 #include "packet_in.h"
 #include "termo_common.h"
+#include <stddef.h>
 #include <string.h>
 
 #ifdef USE_BINARY_PACKETS
@@ -29,6 +30,35 @@ static inline void packet_in_payload_reference_encode(
     buffer[5] = (update_time >> 16U) & 0xFFU;
     buffer[6] = (update_time >> 8U) & 0xFFU;
     buffer[7] = update_time & 0xFFU;
+
+    buffer[8] = (reference->zone >> 24U) & 0xFFU;
+    buffer[9] = (reference->zone >> 16U) & 0xFFU;
+    buffer[10] = (reference->zone >> 8U) & 0xFFU;
+    buffer[11] = reference->zone & 0xFFU;
+}
+
+static inline void packet_in_payload_autotune_encode(
+    packet_in_payload_autotune_t const* autotune,
+    uint8_t* buffer)
+{
+    uint32_t setpoint;
+    memcpy(&setpoint, &autotune->setpoint, sizeof(setpoint));
+    buffer[0] = (setpoint >> 24U) & 0xFFU;
+    buffer[1] = (setpoint >> 16U) & 0xFFU;
+    buffer[2] = (setpoint >> 8U) & 0xFFU;
+    buffer[3] = setpoint & 0xFFU;
+
+    uint32_t amplitude;
+    memcpy(&amplitude, &autotune->amplitude, sizeof(amplitude));
+    buffer[4] = (amplitude >> 24U) & 0xFFU;
+    buffer[5] = (amplitude >> 16U) & 0xFFU;
+    buffer[6] = (amplitude >> 8U) & 0xFFU;
+    buffer[7] = amplitude & 0xFFU;
+
+    buffer[8] = (autotune->rule >> 24U) & 0xFFU;
+    buffer[9] = (autotune->rule >> 16U) & 0xFFU;
+    buffer[10] = (autotune->rule >> 8U) & 0xFFU;
+    buffer[11] = autotune->rule & 0xFFU;
 }
 
 static inline void packet_in_payload_encode(packet_in_type_t type,
@@ -40,6 +70,10 @@ static inline void packet_in_payload_encode(packet_in_type_t type,
             packet_in_payload_reference_encode(&payload->reference, buffer);
             break;
         }
+        case PACKET_IN_TYPE_AUTOTUNE: {
+            packet_in_payload_autotune_encode(&payload->autotune, buffer);
+            break;
+        }
         default: {
             break;
         }
@@ -86,6 +120,29 @@ static inline void packet_in_payload_reference_decode(
     memcpy(&reference->update_time,
            &update_time,
            sizeof(reference->update_time));
+
+    reference->zone = ((buffer[8] & 0xFFU) << 24U) |
+                      ((buffer[9] & 0xFFU) << 16U) |
+                      ((buffer[10] & 0xFFU) << 8U) | (buffer[11] & 0xFFU);
+}
+
+static inline void packet_in_payload_autotune_decode(
+    uint8_t const* buffer,
+    packet_in_payload_autotune_t* autotune)
+{
+    uint32_t setpoint = ((buffer[0] & 0xFFU) << 24U) |
+                        ((buffer[1] & 0xFFU) << 16U) |
+                        ((buffer[2] & 0xFFU) << 8U) | (buffer[3] & 0xFFU);
+    memcpy(&autotune->setpoint, &setpoint, sizeof(autotune->setpoint));
+
+    uint32_t amplitude = ((buffer[4] & 0xFFU) << 24U) |
+                         ((buffer[5] & 0xFFU) << 16U) |
+                         ((buffer[6] & 0xFFU) << 8U) | (buffer[7] & 0xFFU);
+    memcpy(&autotune->amplitude, &amplitude, sizeof(autotune->amplitude));
+
+    autotune->rule = ((buffer[8] & 0xFFU) << 24U) |
+                     ((buffer[9] & 0xFFU) << 16U) |
+                     ((buffer[10] & 0xFFU) << 8U) | (buffer[11] & 0xFFU);
 }
 
 static inline void packet_in_payload_decode(uint8_t const* buffer,
@@ -97,6 +154,10 @@ static inline void packet_in_payload_decode(uint8_t const* buffer,
             packet_in_payload_reference_decode(buffer, &payload->reference);
             break;
         }
+        case PACKET_IN_TYPE_AUTOTUNE: {
+            packet_in_payload_autotune_decode(buffer, &payload->autotune);
+            break;
+        }
         default: {
             break;
         }
@@ -136,10 +197,30 @@ bool packet_in_encode(packet_in_t const* packet,
                                "{\"packet_type\": %d,"
                                "\"packet_payload\": {"
                                "\"temperature\": %f,"
-                               "\"update_time\": %f}}\n",
+                               "\"update_time\": %f,"
+                               "\"zone\": %lu}}\n",
                                packet->type,
                                packet->payload.reference.temperature,
-                               packet->payload.reference.update_time);
+                               packet->payload.reference.update_time,
+                               packet->payload.reference.zone);
+    } else if (packet->type == PACKET_IN_TYPE_TRACE_DUMP) {
+        written_len = snprintf(buffer,
+                               buffer_len,
+                               "{\"packet_type\": %d,"
+                               "\"packet_payload\": {}}\n",
+                               packet->type);
+    } else if (packet->type == PACKET_IN_TYPE_AUTOTUNE) {
+        written_len = snprintf(buffer,
+                               buffer_len,
+                               "{\"packet_type\": %d,"
+                               "\"packet_payload\": {"
+                               "\"setpoint\": %f,"
+                               "\"amplitude\": %f,"
+                               "\"rule\": %lu}}\n",
+                               packet->type,
+                               packet->payload.autotune.setpoint,
+                               packet->payload.autotune.amplitude,
+                               packet->payload.autotune.rule);
     }
 
     if (written_len < 0 || (size_t)written_len >= buffer_len) {
@@ -150,73 +231,745 @@ bool packet_in_encode(packet_in_t const* packet,
     return true;
 }
 
-float parse_float_field(const char* str, const char* key)
+typedef enum {
+    PACKET_IN_FIELD_FORMAT_FLOAT,
+    PACKET_IN_FIELD_FORMAT_UINT,
+} packet_in_field_format_t;
+
+typedef struct {
+    char const* key;
+    packet_in_type_t type;
+    packet_in_field_format_t format;
+    bool is_optional;
+    size_t offset;
+} packet_in_field_t;
+
+// an optional field left out of a packet keeps its zero value
+static packet_in_field_t const packet_in_fields[] = {
+    {.key = "temperature",
+     .type = PACKET_IN_TYPE_REFERENCE,
+     .format = PACKET_IN_FIELD_FORMAT_FLOAT,
+     .offset = offsetof(packet_in_payload_t, reference.temperature)},
+    {.key = "update_time",
+     .type = PACKET_IN_TYPE_REFERENCE,
+     .format = PACKET_IN_FIELD_FORMAT_FLOAT,
+     .offset = offsetof(packet_in_payload_t, reference.update_time)},
+    {.key = "zone",
+     .type = PACKET_IN_TYPE_REFERENCE,
+     .format = PACKET_IN_FIELD_FORMAT_UINT,
+     .is_optional = true,
+     .offset = offsetof(packet_in_payload_t, reference.zone)},
+    {.key = "setpoint",
+     .type = PACKET_IN_TYPE_AUTOTUNE,
+     .format = PACKET_IN_FIELD_FORMAT_FLOAT,
+     .offset = offsetof(packet_in_payload_t, autotune.setpoint)},
+    {.key = "amplitude",
+     .type = PACKET_IN_TYPE_AUTOTUNE,
+     .format = PACKET_IN_FIELD_FORMAT_FLOAT,
+     .is_optional = true,
+     .offset = offsetof(packet_in_payload_t, autotune.amplitude)},
+    {.key = "rule",
+     .type = PACKET_IN_TYPE_AUTOTUNE,
+     .format = PACKET_IN_FIELD_FORMAT_UINT,
+     .is_optional = true,
+     .offset = offsetof(packet_in_payload_t, autotune.rule)},
+};
+
+static_assert(TERMO_ARRAY_SIZE(packet_in_fields) <= 32U,
+              "field_mask holds at most 32 fields");
+
+// the fields of a packet type, or only the ones it cannot do without
+static uint32_t packet_in_field_mask(packet_in_type_t type, bool is_required)
 {
-    const char* ptr = strstr(str, key);
-    if (!ptr)
-        return 0.0f;
-    ptr += strlen(key);
-    while (*ptr && (*ptr < '0' || *ptr > '9') && *ptr != '-' && *ptr != '.')
-        ptr++;
-    return strtof(ptr, NULL);
+    uint32_t mask = 0UL;
+    for (size_t field = 0UL; field < TERMO_ARRAY_SIZE(packet_in_fields);
+         ++field) {
+        if (packet_in_fields[field].type == type &&
+            (!is_required || !packet_in_fields[field].is_optional)) {
+            mask |= (1UL << field);
+        }
+    }
+
+    return mask;
 }
 
-bool packet_in_decode(char const* buffer,
-                      size_t buffer_len,
-                      packet_in_t* packet)
+static inline bool packet_in_is_space(char byte)
 {
-    if (buffer == NULL || buffer_len == 0UL || packet == NULL) {
-        return false;
+    return byte == ' ' || byte == '\t' || byte == '\r' || byte == '\n';
+}
+
+static inline bool packet_in_is_digit(char byte)
+{
+    return byte >= '0' && byte <= '9';
+}
+
+static inline bool packet_in_is_type_valid(uint32_t type)
+{
+    switch (type) {
+        case PACKET_IN_TYPE_REFERENCE:
+        case PACKET_IN_TYPE_TRACE_DUMP:
+        case PACKET_IN_TYPE_AUTOTUNE: {
+            return true;
+        }
+        default: {
+            return false;
+        }
     }
+}
 
-    if (strlen(buffer) != buffer_len) {
-        return false;
+static inline bool packet_in_decoder_is_array(
+    packet_in_decoder_t const* decoder)
+{
+    return decoder->depth > 0UL &&
+           (decoder->array_mask & (1UL << (decoder->depth - 1UL))) != 0UL;
+}
+
+static inline void packet_in_decoder_fail(packet_in_decoder_t* decoder,
+                                          packet_in_err_t err)
+{
+    decoder->err = err;
+}
+
+static void packet_in_decoder_open(packet_in_decoder_t* decoder,
+                                   bool is_array)
+{
+    if (decoder->depth >= PACKET_IN_DECODER_MAX_DEPTH) {
+        packet_in_decoder_fail(decoder, PACKET_IN_ERR_NESTING);
+        return;
     }
 
-    char const* str = strstr(buffer, "\"packet_type\"");
-    if (str == NULL) {
-        return false;
+    if (decoder->target == PACKET_IN_DECODER_TARGET_TYPE ||
+        decoder->target == PACKET_IN_DECODER_TARGET_FIELD ||
+        (decoder->target == PACKET_IN_DECODER_TARGET_PAYLOAD && is_array)) {
+        packet_in_decoder_fail(decoder, PACKET_IN_ERR_VALUE);
+        return;
     }
 
-    int type;
-    int scanned_num = sscanf(str, "\"packet_type\": %d", &type);
-    if (scanned_num != 1) {
-        return false;
+    if (is_array) {
+        decoder->array_mask |= (1UL << decoder->depth);
+    } else {
+        decoder->array_mask &= ~(1UL << decoder->depth);
     }
+    decoder->depth++;
 
-    packet->type = (packet_in_type_t)type;
+    if (decoder->target == PACKET_IN_DECODER_TARGET_PAYLOAD) {
+        decoder->payload_depth = decoder->depth;
+    }
 
-    if (packet->type == PACKET_IN_TYPE_REFERENCE) {
-        str = strstr(buffer, "\"temperature\"");
-        if (str == NULL) {
-            return false;
+    decoder->target = PACKET_IN_DECODER_TARGET_NONE;
+    decoder->state = is_array ? PACKET_IN_DECODER_STATE_VALUE
+                              : PACKET_IN_DECODER_STATE_KEY_OR_END;
+}
+
+static void packet_in_decoder_close(packet_in_decoder_t* decoder, char byte)
+{
+    if (decoder->depth == 0UL ||
+        packet_in_decoder_is_array(decoder) != (byte == ']')) {
+        packet_in_decoder_fail(decoder, PACKET_IN_ERR_SYNTAX);
+        return;
+    }
+
+    if (decoder->depth == decoder->payload_depth) {
+        decoder->payload_depth = 0UL;
+    }
+    decoder->depth--;
+
+    decoder->target = PACKET_IN_DECODER_TARGET_NONE;
+    decoder->state = decoder->depth == 0UL
+                         ? PACKET_IN_DECODER_STATE_DONE
+                         : PACKET_IN_DECODER_STATE_NEXT_OR_END;
+}
+
+static void packet_in_decoder_resolve_key(packet_in_decoder_t* decoder)
+{
+    decoder->target = PACKET_IN_DECODER_TARGET_NONE;
+
+    if (decoder->key_len >= sizeof(decoder->key)) {
+        return;
+    }
+    decoder->key[decoder->key_len] = '\0';
+
+    if (decoder->depth == 1UL) {
+        if (strcmp(decoder->key, "packet_type") == 0) {
+            decoder->target = PACKET_IN_DECODER_TARGET_TYPE;
+        } else if (strcmp(decoder->key, "packet_payload") == 0) {
+            decoder->target = PACKET_IN_DECODER_TARGET_PAYLOAD;
+        }
+    } else if (decoder->depth == decoder->payload_depth) {
+        for (size_t field = 0UL; field < TERMO_ARRAY_SIZE(packet_in_fields);
+             ++field) {
+            if (strcmp(decoder->key, packet_in_fields[field].key) != 0) {
+                continue;
+            }
+            // the payloads share their storage, a field of another type
+            // would overwrite one of this type
+            if (decoder->has_type &&
+                packet_in_fields[field].type != decoder->packet.type) {
+                packet_in_decoder_fail(decoder, PACKET_IN_ERR_FOREIGN_FIELD);
+                return;
+            }
+            decoder->target = PACKET_IN_DECODER_TARGET_FIELD;
+            decoder->field = field;
+            break;
         }
+    }
+}
+
+static float packet_in_decoder_number_to_float(
+    packet_in_decoder_number_t const* number)
+{
+    int32_t exponent =
+        number->exponent + (number->is_exponent_negative
+                                ? -number->exponent_value
+                                : number->exponent_value);
+
+    float scale = 1.0F;
+    float base = 10.0F;
+    for (uint32_t power = (uint32_t)(exponent < 0 ? -exponent : exponent);
+         power > 0U;
+         power >>= 1U) {
+        if ((power & 1U) != 0U) {
+            scale *= base;
+        }
+        base *= base;
+    }
 
-        float temperature = 0.0F;
-        // scanned_num = sscanf(str, "\"temperature\": %f", &temperature);
-        // if (scanned_num != 1) {
-        //     return false;
-        // }
-        temperature = parse_float_field(str, "temperature");
+    float value = (float)number->mantissa;
+    value = exponent < 0 ? value / scale : value * scale;
+
+    return number->is_negative ? -value : value;
+}
 
-        packet->payload.reference.temperature = temperature;
+static void packet_in_decoder_assign_number(packet_in_decoder_t* decoder)
+{
+    packet_in_decoder_number_t const* number = &decoder->number;
+
+    if (!number->has_digits || number->is_part_empty) {
+        packet_in_decoder_fail(decoder, PACKET_IN_ERR_NUMBER);
+        return;
+    }
+
+    switch (decoder->target) {
+        case PACKET_IN_DECODER_TARGET_TYPE: {
+            if (!number->is_integer || number->is_negative) {
+                packet_in_decoder_fail(decoder, PACKET_IN_ERR_VALUE);
+                return;
+            }
+            if (!packet_in_is_type_valid(number->mantissa)) {
+                packet_in_decoder_fail(decoder, PACKET_IN_ERR_UNKNOWN_TYPE);
+                return;
+            }
+            decoder->packet.type = (packet_in_type_t)number->mantissa;
+            decoder->has_type = true;
+            break;
+        }
+        case PACKET_IN_DECODER_TARGET_FIELD: {
+            packet_in_field_t const* field = &packet_in_fields[decoder->field];
+            uint8_t* target =
+                (uint8_t*)&decoder->packet.payload + field->offset;
+            if (field->format == PACKET_IN_FIELD_FORMAT_UINT) {
+                if (!number->is_integer || number->is_negative ||
+                    number->exponent != 0) {
+                    packet_in_decoder_fail(decoder, PACKET_IN_ERR_VALUE);
+                    return;
+                }
+                memcpy(target, &number->mantissa, sizeof(number->mantissa));
+            } else {
+                float value = packet_in_decoder_number_to_float(number);
+                memcpy(target, &value, sizeof(value));
+            }
+            decoder->field_mask |= (1UL << decoder->field);
+            break;
+        }
+        case PACKET_IN_DECODER_TARGET_PAYLOAD: {
+            packet_in_decoder_fail(decoder, PACKET_IN_ERR_VALUE);
+            return;
+        }
+        default: {
+            break;
+        }
+    }
+
+    decoder->target = PACKET_IN_DECODER_TARGET_NONE;
+    decoder->state = PACKET_IN_DECODER_STATE_NEXT_OR_END;
+}
 
-        str = strstr(buffer, "\"update_time\"");
-        if (str == NULL) {
+static inline void packet_in_decoder_number_digit(
+    packet_in_decoder_number_t* number,
+    char byte,
+    bool is_fraction)
+{
+    uint32_t digit = (uint32_t)(byte - '0');
+
+    if (number->mantissa <= (UINT32_MAX - 9U) / 10U) {
+        number->mantissa = number->mantissa * 10U + digit;
+        if (is_fraction) {
+            number->exponent--;
+        }
+    } else if (!is_fraction) {
+        number->exponent++;
+    }
+
+    number->has_digits = true;
+    number->is_part_empty = false;
+}
+
+static bool packet_in_decoder_step_number(packet_in_decoder_t* decoder,
+                                          char byte)
+{
+    packet_in_decoder_number_t* number = &decoder->number;
+
+    switch (number->phase) {
+        case PACKET_IN_DECODER_NUMBER_SIGN: {
+            number->phase = PACKET_IN_DECODER_NUMBER_INTEGER;
+            if (byte == '-') {
+                number->is_negative = true;
+                return true;
+            }
+            return false;
+        }
+        case PACKET_IN_DECODER_NUMBER_INTEGER: {
+            if (packet_in_is_digit(byte)) {
+                packet_in_decoder_number_digit(number, byte, false);
+                return true;
+            }
+            if (byte == '.') {
+                number->is_integer = false;
+                number->is_part_empty = true;
+                number->phase = PACKET_IN_DECODER_NUMBER_FRACTION;
+                return true;
+            }
+            break;
+        }
+        case PACKET_IN_DECODER_NUMBER_FRACTION: {
+            if (packet_in_is_digit(byte)) {
+                packet_in_decoder_number_digit(number, byte, true);
+                return true;
+            }
+            break;
+        }
+        case PACKET_IN_DECODER_NUMBER_EXPONENT_SIGN: {
+            number->phase = PACKET_IN_DECODER_NUMBER_EXPONENT;
+            if (byte == '-' || byte == '+') {
+                number->is_exponent_negative = byte == '-';
+                return true;
+            }
+            return false;
+        }
+        case PACKET_IN_DECODER_NUMBER_EXPONENT: {
+            if (packet_in_is_digit(byte)) {
+                if (number->exponent_value < 100) {
+                    number->exponent_value =
+                        number->exponent_value * 10 + (byte - '0');
+                }
+                number->is_part_empty = false;
+                return true;
+            }
+            packet_in_decoder_assign_number(decoder);
             return false;
         }
+        default: {
+            break;
+        }
+    }
+
+    // every part needs a digit, so 1.e5 and 1e} fail like 1. does
+    if ((byte == 'e' || byte == 'E') &&
+        number->phase != PACKET_IN_DECODER_NUMBER_EXPONENT &&
+        !number->is_part_empty) {
+        number->is_integer = false;
+        number->is_part_empty = true;
+        number->phase = PACKET_IN_DECODER_NUMBER_EXPONENT_SIGN;
+        return true;
+    }
 
-        float update_time = 0.0F;
-        // scanned_num = sscanf(str, "\"update_time\": %f", &update_time);
-        // if (scanned_num != 1) {
-        //       return false;
-        // }
-        update_time = parse_float_field(str, "update_time");
+    packet_in_decoder_assign_number(decoder);
+    return false;
+}
 
-        packet->payload.reference.update_time = update_time;
+// only the json literals, and only as values of keys nobody reads
+static char const* packet_in_decoder_find_literal(char byte)
+{
+    static char const* const literals[] = {"true", "false", "null"};
+
+    for (size_t index = 0UL; index < TERMO_ARRAY_SIZE(literals); ++index) {
+        if (literals[index][0] == byte) {
+            return literals[index];
+        }
     }
 
+    return NULL;
+}
+
+static bool packet_in_decoder_step_value(packet_in_decoder_t* decoder,
+                                         char byte)
+{
+    if (packet_in_is_space(byte)) {
+        return true;
+    }
+
+    if (decoder->depth == 0UL && byte != '{') {
+        packet_in_decoder_fail(decoder, PACKET_IN_ERR_SYNTAX);
+        return true;
+    }
+
+    if (byte == '{' || byte == '[') {
+        packet_in_decoder_open(decoder, byte == '[');
+        return true;
+    }
+
+    if (byte == ']') {
+        packet_in_decoder_close(decoder, byte);
+        return true;
+    }
+
+    if (byte == '"' || (byte >= 'a' && byte <= 'z')) {
+        if (decoder->target != PACKET_IN_DECODER_TARGET_NONE) {
+            packet_in_decoder_fail(decoder, PACKET_IN_ERR_VALUE);
+            return true;
+        }
+        if (byte == '"') {
+            decoder->state = PACKET_IN_DECODER_STATE_STRING;
+            return true;
+        }
+        decoder->literal = packet_in_decoder_find_literal(byte);
+        if (decoder->literal == NULL) {
+            packet_in_decoder_fail(decoder, PACKET_IN_ERR_SYNTAX);
+            return true;
+        }
+        decoder->literal_len = 1UL;
+        decoder->state = PACKET_IN_DECODER_STATE_LITERAL;
+        return true;
+    }
+
+    if (byte == '-' || packet_in_is_digit(byte)) {
+        memset(&decoder->number, 0, sizeof(decoder->number));
+        decoder->number.phase = PACKET_IN_DECODER_NUMBER_SIGN;
+        decoder->number.is_integer = true;
+        decoder->state = PACKET_IN_DECODER_STATE_NUMBER;
+        return false;
+    }
+
+    packet_in_decoder_fail(decoder, PACKET_IN_ERR_SYNTAX);
     return true;
 }
 
+static bool packet_in_decoder_step(packet_in_decoder_t* decoder, char byte)
+{
+    switch (decoder->state) {
+        case PACKET_IN_DECODER_STATE_VALUE: {
+            return packet_in_decoder_step_value(decoder, byte);
+        }
+        case PACKET_IN_DECODER_STATE_KEY_OR_END: {
+            if (byte == '"') {
+                decoder->key_len = 0UL;
+                decoder->state = PACKET_IN_DECODER_STATE_KEY;
+            } else if (byte == '}') {
+                packet_in_decoder_close(decoder, byte);
+            } else if (!packet_in_is_space(byte)) {
+                packet_in_decoder_fail(decoder, PACKET_IN_ERR_SYNTAX);
+            }
+            return true;
+        }
+        case PACKET_IN_DECODER_STATE_KEY:
+        case PACKET_IN_DECODER_STATE_KEY_ESCAPE: {
+            if (decoder->state == PACKET_IN_DECODER_STATE_KEY) {
+                if (byte == '\\') {
+                    decoder->state = PACKET_IN_DECODER_STATE_KEY_ESCAPE;
+                    return true;
+                }
+                if (byte == '"') {
+                    packet_in_decoder_resolve_key(decoder);
+                    decoder->state = PACKET_IN_DECODER_STATE_COLON;
+                    return true;
+                }
+            }
+            decoder->state = PACKET_IN_DECODER_STATE_KEY;
+            if (decoder->key_len < sizeof(decoder->key) - 1UL) {
+                decoder->key[decoder->key_len++] = byte;
+            } else {
+                decoder->key_len = sizeof(decoder->key);
+            }
+            return true;
+        }
+        case PACKET_IN_DECODER_STATE_COLON: {
+            if (byte == ':') {
+                decoder->state = PACKET_IN_DECODER_STATE_VALUE;
+            } else if (!packet_in_is_space(byte)) {
+                packet_in_decoder_fail(decoder, PACKET_IN_ERR_SYNTAX);
+            }
+            return true;
+        }
+        case PACKET_IN_DECODER_STATE_STRING: {
+            if (byte == '\\') {
+                decoder->state = PACKET_IN_DECODER_STATE_STRING_ESCAPE;
+            } else if (byte == '"') {
+                decoder->state = PACKET_IN_DECODER_STATE_NEXT_OR_END;
+            }
+            return true;
+        }
+        case PACKET_IN_DECODER_STATE_STRING_ESCAPE: {
+            decoder->state = PACKET_IN_DECODER_STATE_STRING;
+            return true;
+        }
+        case PACKET_IN_DECODER_STATE_NUMBER: {
+            return packet_in_decoder_step_number(decoder, byte);
+        }
+        case PACKET_IN_DECODER_STATE_LITERAL: {
+            char expected = decoder->literal[decoder->literal_len];
+            if (expected == '\0') {
+                decoder->state = PACKET_IN_DECODER_STATE_NEXT_OR_END;
+                return false;
+            }
+            if (byte != expected) {
+                packet_in_decoder_fail(decoder, PACKET_IN_ERR_SYNTAX);
+                return true;
+            }
+            decoder->literal_len++;
+            return true;
+        }
+        case PACKET_IN_DECODER_STATE_NEXT_OR_END: {
+            if (byte == ',') {
+                decoder->state = packet_in_decoder_is_array(decoder)
+                                     ? PACKET_IN_DECODER_STATE_VALUE
+                                     : PACKET_IN_DECODER_STATE_KEY_OR_END;
+            } else if (byte == '}' || byte == ']') {
+                packet_in_decoder_close(decoder, byte);
+            } else if (!packet_in_is_space(byte)) {
+                packet_in_decoder_fail(decoder, PACKET_IN_ERR_SYNTAX);
+            }
+            return true;
+        }
+        case PACKET_IN_DECODER_STATE_DONE: {
+            if (!packet_in_is_space(byte)) {
+                packet_in_decoder_fail(decoder, PACKET_IN_ERR_TRAILING);
+            }
+            return true;
+        }
+        default: {
+            packet_in_decoder_fail(decoder, PACKET_IN_ERR_SYNTAX);
+            return true;
+        }
+    }
+}
+
+// a run of plain key bytes, up to the closing quote or an escape
+static size_t packet_in_decoder_take_key(packet_in_decoder_t* decoder,
+                                         char const* buffer,
+                                         size_t buffer_len)
+{
+    size_t index = 0UL;
+    while (index < buffer_len && buffer[index] != '"' &&
+           buffer[index] != '\\') {
+        if (decoder->key_len < sizeof(decoder->key) - 1UL) {
+            decoder->key[decoder->key_len++] = buffer[index];
+        } else {
+            decoder->key_len = sizeof(decoder->key);
+        }
+        index++;
+    }
+
+    return index;
+}
+
+// a run of digits within the integer or the fraction part
+static size_t packet_in_decoder_take_digits(packet_in_decoder_t* decoder,
+                                            char const* buffer,
+                                            size_t buffer_len)
+{
+    packet_in_decoder_number_t* number = &decoder->number;
+    if (number->phase != PACKET_IN_DECODER_NUMBER_INTEGER &&
+        number->phase != PACKET_IN_DECODER_NUMBER_FRACTION) {
+        return 0UL;
+    }
+
+    bool is_fraction = number->phase == PACKET_IN_DECODER_NUMBER_FRACTION;
+    size_t index = 0UL;
+    while (index < buffer_len && packet_in_is_digit(buffer[index])) {
+        packet_in_decoder_number_digit(number, buffer[index], is_fraction);
+        index++;
+    }
+
+    return index;
+}
+
+// the whitespace between tokens, where a step would only skip it
+static size_t packet_in_decoder_take_space(packet_in_decoder_t* decoder,
+                                           char const* buffer,
+                                           size_t buffer_len)
+{
+    switch (decoder->state) {
+        case PACKET_IN_DECODER_STATE_VALUE:
+        case PACKET_IN_DECODER_STATE_KEY_OR_END:
+        case PACKET_IN_DECODER_STATE_COLON:
+        case PACKET_IN_DECODER_STATE_NEXT_OR_END:
+        case PACKET_IN_DECODER_STATE_DONE: {
+            break;
+        }
+        default: {
+            return 0UL;
+        }
+    }
+
+    size_t index = 0UL;
+    while (index < buffer_len && packet_in_is_space(buffer[index])) {
+        index++;
+    }
+
+    return index;
+}
+
+void packet_in_decoder_reset(packet_in_decoder_t* decoder)
+{
+    if (decoder == NULL) {
+        return;
+    }
+
+    memset(decoder, 0, sizeof(*decoder));
+    decoder->err = PACKET_IN_ERR_INCOMPLETE;
+    decoder->state = PACKET_IN_DECODER_STATE_VALUE;
+    decoder->target = PACKET_IN_DECODER_TARGET_NONE;
+}
+
+packet_in_err_t packet_in_decoder_feed(packet_in_decoder_t* decoder, char byte)
+{
+    return packet_in_decoder_feed_buffer(decoder, &byte, 1UL);
+}
+
+packet_in_err_t packet_in_decoder_feed_buffer(packet_in_decoder_t* decoder,
+                                              char const* buffer,
+                                              size_t buffer_len)
+{
+    if (decoder == NULL || buffer == NULL) {
+        return PACKET_IN_ERR_SYNTAX;
+    }
+
+    size_t index = 0UL;
+    while (index < buffer_len && decoder->err == PACKET_IN_ERR_INCOMPLETE) {
+        // runs of key bytes, digits and whitespace go without a step each
+        if (decoder->state == PACKET_IN_DECODER_STATE_KEY) {
+            index += packet_in_decoder_take_key(decoder,
+                                                buffer + index,
+                                                buffer_len - index);
+        } else if (decoder->state == PACKET_IN_DECODER_STATE_NUMBER) {
+            index += packet_in_decoder_take_digits(decoder,
+                                                   buffer + index,
+                                                   buffer_len - index);
+        } else {
+            index += packet_in_decoder_take_space(decoder,
+                                                  buffer + index,
+                                                  buffer_len - index);
+        }
+
+        if (index < buffer_len &&
+            packet_in_decoder_step(decoder, buffer[index])) {
+            index++;
+        }
+    }
+
+    if (decoder->err == PACKET_IN_ERR_INCOMPLETE &&
+        decoder->state == PACKET_IN_DECODER_STATE_DONE) {
+        return PACKET_IN_ERR_OK;
+    }
+
+    return decoder->err;
+}
+
+packet_in_err_t packet_in_decoder_finish(packet_in_decoder_t const* decoder,
+                                         packet_in_t* packet)
+{
+    if (decoder == NULL || packet == NULL) {
+        return PACKET_IN_ERR_SYNTAX;
+    }
+
+    if (decoder->err != PACKET_IN_ERR_INCOMPLETE) {
+        return decoder->err;
+    }
+
+    if (decoder->state != PACKET_IN_DECODER_STATE_DONE) {
+        return PACKET_IN_ERR_INCOMPLETE;
+    }
+
+    if (!decoder->has_type) {
+        return PACKET_IN_ERR_MISSING_TYPE;
+    }
+
+    // a payload ahead of its type is only checked here
+    uint32_t type_mask = packet_in_field_mask(decoder->packet.type, false);
+    if ((decoder->field_mask & ~type_mask) != 0UL) {
+        return PACKET_IN_ERR_FOREIGN_FIELD;
+    }
+
+    uint32_t required_mask = packet_in_field_mask(decoder->packet.type, true);
+    if ((decoder->field_mask & required_mask) != required_mask) {
+        return PACKET_IN_ERR_MISSING_FIELD;
+    }
+
+    *packet = decoder->packet;
+
+    return PACKET_IN_ERR_OK;
+}
+
+char const* packet_in_err_to_string(packet_in_err_t err)
+{
+    switch (err) {
+        case PACKET_IN_ERR_OK: {
+            return "PACKET_IN_ERR_OK";
+        }
+        case PACKET_IN_ERR_INCOMPLETE: {
+            return "PACKET_IN_ERR_INCOMPLETE";
+        }
+        case PACKET_IN_ERR_SYNTAX: {
+            return "PACKET_IN_ERR_SYNTAX";
+        }
+        case PACKET_IN_ERR_NESTING: {
+            return "PACKET_IN_ERR_NESTING";
+        }
+        case PACKET_IN_ERR_NUMBER: {
+            return "PACKET_IN_ERR_NUMBER";
+        }
+        case PACKET_IN_ERR_VALUE: {
+            return "PACKET_IN_ERR_VALUE";
+        }
+        case PACKET_IN_ERR_UNKNOWN_TYPE: {
+            return "PACKET_IN_ERR_UNKNOWN_TYPE";
+        }
+        case PACKET_IN_ERR_MISSING_TYPE: {
+            return "PACKET_IN_ERR_MISSING_TYPE";
+        }
+        case PACKET_IN_ERR_MISSING_FIELD: {
+            return "PACKET_IN_ERR_MISSING_FIELD";
+        }
+        case PACKET_IN_ERR_TRAILING: {
+            return "PACKET_IN_ERR_TRAILING";
+        }
+        case PACKET_IN_ERR_FOREIGN_FIELD: {
+            return "PACKET_IN_ERR_FOREIGN_FIELD";
+        }
+        default: {
+            return "PACKET_IN_ERR_UNKNOWN";
+        }
+    }
+}
+
+bool packet_in_decode(char const* buffer,
+                      size_t buffer_len,
+                      packet_in_t* packet)
+{
+    if (buffer == NULL || buffer_len == 0UL || packet == NULL) {
+        return false;
+    }
+
+    packet_in_decoder_t decoder;
+    packet_in_decoder_reset(&decoder);
+
+    packet_in_err_t err =
+        packet_in_decoder_feed_buffer(&decoder, buffer, buffer_len);
+    if (err != PACKET_IN_ERR_OK && err != PACKET_IN_ERR_INCOMPLETE) {
+        return false;
+    }
+
+    return packet_in_decoder_finish(&decoder, packet) == PACKET_IN_ERR_OK;
+}
+
 #endif
\ No newline at end of file
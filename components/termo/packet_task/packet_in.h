@@ -7,15 +7,30 @@
 
 typedef enum {
     PACKET_IN_TYPE_REFERENCE,
+    PACKET_IN_TYPE_TRACE_DUMP,
+    PACKET_IN_TYPE_AUTOTUNE,
 } packet_in_type_t;
 
 typedef struct {
     float temperature;
     float update_time;
+    uint32_t zone;
 } packet_in_payload_reference_t;
 
+typedef struct {
+} packet_in_payload_trace_dump_t;
+
+// the rule is a termo_tuning_rule_t, an amplitude of 0 keeps the default
+typedef struct {
+    float setpoint;
+    float amplitude;
+    uint32_t rule;
+} packet_in_payload_autotune_t;
+
 typedef union {
     packet_in_payload_reference_t reference;
+    packet_in_payload_trace_dump_t trace_dump;
+    packet_in_payload_autotune_t autotune;
 } packet_in_payload_t;
 
 typedef struct {
@@ -41,6 +56,101 @@ bool packet_in_decode(const uint8_t (*buffer)[PACKET_IN_SIZE],
 
 #else
 
+#define PACKET_IN_DECODER_KEY_SIZE (16U)
+#define PACKET_IN_DECODER_MAX_DEPTH (8U)
+
+typedef enum {
+    PACKET_IN_ERR_OK = 0,
+    PACKET_IN_ERR_INCOMPLETE,
+    PACKET_IN_ERR_SYNTAX,
+    PACKET_IN_ERR_NESTING,
+    PACKET_IN_ERR_NUMBER,
+    PACKET_IN_ERR_VALUE,
+    PACKET_IN_ERR_UNKNOWN_TYPE,
+    PACKET_IN_ERR_MISSING_TYPE,
+    PACKET_IN_ERR_MISSING_FIELD,
+    PACKET_IN_ERR_TRAILING,
+    PACKET_IN_ERR_FOREIGN_FIELD,
+} packet_in_err_t;
+
+typedef enum {
+    PACKET_IN_DECODER_STATE_VALUE,
+    PACKET_IN_DECODER_STATE_KEY_OR_END,
+    PACKET_IN_DECODER_STATE_KEY,
+    PACKET_IN_DECODER_STATE_KEY_ESCAPE,
+    PACKET_IN_DECODER_STATE_COLON,
+    PACKET_IN_DECODER_STATE_STRING,
+    PACKET_IN_DECODER_STATE_STRING_ESCAPE,
+    PACKET_IN_DECODER_STATE_NUMBER,
+    PACKET_IN_DECODER_STATE_LITERAL,
+    PACKET_IN_DECODER_STATE_NEXT_OR_END,
+    PACKET_IN_DECODER_STATE_DONE,
+} packet_in_decoder_state_t;
+
+typedef enum {
+    PACKET_IN_DECODER_TARGET_NONE,
+    PACKET_IN_DECODER_TARGET_TYPE,
+    PACKET_IN_DECODER_TARGET_PAYLOAD,
+    PACKET_IN_DECODER_TARGET_FIELD,
+} packet_in_decoder_target_t;
+
+typedef enum {
+    PACKET_IN_DECODER_NUMBER_SIGN,
+    PACKET_IN_DECODER_NUMBER_INTEGER,
+    PACKET_IN_DECODER_NUMBER_FRACTION,
+    PACKET_IN_DECODER_NUMBER_EXPONENT_SIGN,
+    PACKET_IN_DECODER_NUMBER_EXPONENT,
+} packet_in_decoder_number_phase_t;
+
+typedef struct {
+    packet_in_decoder_number_phase_t phase;
+    bool is_negative;
+    bool is_exponent_negative;
+    bool has_digits;
+    bool is_part_empty;
+    bool is_integer;
+    uint32_t mantissa;
+    int32_t exponent;
+    int32_t exponent_value;
+} packet_in_decoder_number_t;
+
+typedef struct {
+    packet_in_err_t err;
+    packet_in_decoder_state_t state;
+    packet_in_decoder_target_t target;
+    size_t field;
+
+    size_t depth;
+    size_t payload_depth;
+    uint32_t array_mask;
+
+    char key[PACKET_IN_DECODER_KEY_SIZE];
+    size_t key_len;
+
+    packet_in_decoder_number_t number;
+
+    char const* literal;
+    size_t literal_len;
+
+    bool has_type;
+    uint32_t field_mask;
+    packet_in_t packet;
+} packet_in_decoder_t;
+
+void packet_in_decoder_reset(packet_in_decoder_t* decoder);
+
+packet_in_err_t packet_in_decoder_feed(packet_in_decoder_t* decoder,
+                                       char byte);
+
+packet_in_err_t packet_in_decoder_feed_buffer(packet_in_decoder_t* decoder,
+                                              char const* buffer,
+                                              size_t buffer_len);
+
+packet_in_err_t packet_in_decoder_finish(packet_in_decoder_t const* decoder,
+                                         packet_in_t* packet);
+
+char const* packet_in_err_to_string(packet_in_err_t err);
+
 bool packet_in_encode(packet_in_t const* packet,
                       char* buffer,
                       size_t buffer_len);
@@ -12,15 +12,73 @@ static inline bool packet_manager_prepare_packet_out(packet_manager_t* manager,
     TERMO_ASSERT(manager != NULL);
     TERMO_ASSERT(packet != NULL);
 
-    bool result = packet_out_encode(packet,
-                                    (char*)manager->transmit_buffer,
-                                    sizeof(manager->transmit_buffer));
+    size_t index = manager->transmit_index;
 
-    if (result) {
-        manager->is_transmit_pending = true;
+    if (manager->transmit_lengths[index] > 0UL) {
+        manager->transmit_dropped++;
     }
 
-    return result;
+#ifdef USE_BINARY_PACKETS
+    static_assert(sizeof(manager->transmit_buffers[0]) >= PACKET_OUT_SIZE,
+                  "transmit buffer holds a binary packet");
+
+    size_t encoded_len = 0UL;
+    if (!packet_out_encode(
+            packet,
+            (uint8_t(*)[PACKET_OUT_SIZE])manager->transmit_buffers[index],
+            &encoded_len)) {
+        manager->transmit_lengths[index] = 0UL;
+        return false;
+    }
+#else
+    size_t encoded_len = 0UL;
+    if (!packet_out_encode(packet,
+                           (char*)manager->transmit_buffers[index],
+                           sizeof(manager->transmit_buffers[index]),
+                           &encoded_len)) {
+        manager->transmit_lengths[index] = 0UL;
+        return false;
+    }
+#endif
+
+    manager->transmit_lengths[index] = encoded_len;
+
+    return true;
+}
+
+static inline bool packet_manager_is_uart_busy(packet_manager_t const* manager,
+                                               HAL_UART_StateTypeDef state)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    return (HAL_UART_GetState(manager->config.packet_uart_bus) & state) ==
+           state;
+}
+
+static inline bool packet_manager_start_transmit(packet_manager_t* manager)
+{
+    TERMO_TRACE_FUNC();
+    TERMO_ASSERT(manager != NULL);
+
+    size_t index = manager->transmit_index;
+    size_t length = manager->transmit_lengths[index];
+
+    if (manager->is_transmit_pending || length == 0UL) {
+        return true;
+    }
+
+    if (HAL_UART_Transmit_DMA(manager->config.packet_uart_bus,
+                              manager->transmit_buffers[index],
+                              (uint16_t)length) != HAL_OK) {
+        return false;
+    }
+
+    manager->transmit_lengths[index] = 0UL;
+    manager->transmit_index =
+        (index + 1UL) % TERMO_ARRAY_SIZE(manager->transmit_buffers);
+    manager->is_transmit_pending = true;
+
+    return true;
 }
 
 static inline bool packet_manager_transmit_packet_out(
@@ -34,103 +92,219 @@ static inline bool packet_manager_transmit_packet_out(
         return false;
     }
 
-    HAL_StatusTypeDef err =
-        HAL_UART_Transmit(manager->config.packet_uart_bus,
-                          manager->transmit_buffer,
-                          strlen((char*)manager->transmit_buffer),
-                          HAL_MAX_DELAY);
+    return packet_manager_start_transmit(manager);
+}
 
-    memset(manager->transmit_buffer, 0, sizeof(manager->transmit_buffer));
+static inline bool packet_manager_has_free_transmit_buffer(
+    packet_manager_t const* manager)
+{
+    TERMO_ASSERT(manager != NULL);
 
-    return err == HAL_OK;
+    return manager->transmit_lengths[manager->transmit_index] == 0UL;
 }
 
-static inline bool packet_manager_parse_packet_in(packet_manager_t* manager,
-                                                  packet_in_t* packet)
+static inline void packet_manager_stop_trace_dump(packet_manager_t* manager)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    if (manager->is_trace_dumping) {
+        manager->is_trace_dumping = false;
+        termo_trace_resume();
+    }
+}
+
+// one slice per free transmit buffer, so the dump never drops its own slices
+static bool packet_manager_transmit_trace(packet_manager_t* manager)
 {
     TERMO_ASSERT(manager != NULL);
-    TERMO_ASSERT(packet != NULL);
 
-    bool result = packet_in_decode((char*)manager->receive_buffer,
-                                   strlen((char*)manager->receive_buffer),
-                                   packet);
+    if (!manager->is_trace_dumping ||
+        !packet_manager_has_free_transmit_buffer(manager)) {
+        return true;
+    }
+
+    packet_out_t packet = {.type = PACKET_OUT_TYPE_TRACE,
+                           .payload.trace = {.clock = termo_trace_get_clock(),
+                                             .index = manager->trace_index,
+                                             .total = manager->trace_total,
+                                             .count = 0U}};
+
+    packet_out_payload_trace_t* trace = &packet.payload.trace;
+    while (trace->count < PACKET_OUT_TRACE_BATCH_SIZE &&
+           manager->trace_index < manager->trace_total) {
+        termo_trace_event_t event;
+        if (!termo_trace_get_event(manager->trace_index++, &event)) {
+            break;
+        }
+
+        trace->events[trace->count++] =
+            (packet_out_trace_event_t){.timestamp = event.timestamp,
+                                       .phase = event.phase,
+                                       .name = event.name,
+                                       .task = event.task};
+    }
 
-    if (result) {
-        manager->is_receive_pending = true;
+    if (manager->trace_index >= manager->trace_total) {
+        packet_manager_stop_trace_dump(manager);
     }
 
-    return result;
+    return packet_manager_transmit_packet_out(manager, &packet);
 }
 
-static inline bool packet_manager_receive_packet_in(packet_manager_t* manager,
-                                                    packet_in_t* packet)
+static inline bool packet_manager_start_receive(packet_manager_t* manager)
 {
+    TERMO_TRACE_FUNC();
     TERMO_ASSERT(manager != NULL);
+
+    manager->receive_position = 0UL;
+
+    if (HAL_UARTEx_ReceiveToIdle_DMA(manager->config.packet_uart_bus,
+                                     manager->receive_buffer,
+                                     sizeof(manager->receive_buffer)) !=
+        HAL_OK) {
+        return false;
+    }
+
+    atomic_store(&manager->is_receive_pending, true);
+
+    return true;
+}
+
+static inline bool packet_manager_stop_receive(packet_manager_t* manager)
+{
+    TERMO_TRACE_FUNC();
+    TERMO_ASSERT(manager != NULL);
+
+    atomic_store(&manager->is_receive_pending, false);
+
+    return HAL_UART_AbortReceive_IT(manager->config.packet_uart_bus) ==
+           HAL_OK;
+}
+
+static inline void packet_manager_reset_packet_in(packet_manager_t* manager)
+{
+    TERMO_ASSERT(manager != NULL);
+
+#ifndef USE_BINARY_PACKETS
+    packet_in_decoder_reset(&manager->receive_decoder);
+#endif
+    manager->receive_index = 0UL;
+}
+
+#ifdef USE_BINARY_PACKETS
+
+// binary packets have a fixed size and no delimiter, so every full frame is
+// decoded as it comes
+bool packet_manager_frame_packet_in(packet_manager_t* manager,
+                                    uint8_t const* chunk,
+                                    size_t chunk_size,
+                                    size_t* offset,
+                                    packet_in_t* packet)
+{
+    TERMO_ASSERT(manager != NULL);
+    TERMO_ASSERT(chunk != NULL);
+    TERMO_ASSERT(offset != NULL && *offset < chunk_size);
     TERMO_ASSERT(packet != NULL);
 
-    memset(manager->receive_buffer, 0, sizeof(manager->receive_buffer));
+    size_t size = sizeof(manager->receive_frame) - manager->receive_index;
+    if (size > chunk_size - *offset) {
+        size = chunk_size - *offset;
+    }
+
+    memcpy(manager->receive_frame + manager->receive_index,
+           chunk + *offset,
+           size);
+    manager->receive_index += size;
+    *offset += size;
+
+    if (manager->receive_index < sizeof(manager->receive_frame)) {
+        return false;
+    }
+
+    manager->receive_index = 0UL;
 
-    uint32_t start_tick = HAL_GetTick();
-    uint32_t total_timeout_ms = 10000U;
-    uint32_t inter_byte_timeout_ms = 100U;
+    if (!packet_in_decode(&manager->receive_frame, packet)) {
+        manager->receive_invalid++;
+        return false;
+    }
 
-    size_t index = 0UL;
-    uint8_t byte = 0U;
+    return true;
+}
 
-    bool got_first_byte = false;
-    uint32_t last_byte_tick = start_tick;
+#else
 
-    while (1) {
-        uint32_t now = HAL_GetTick();
+// the bytes up to the end of the line go to the decoder in one go, the
+// line ending finishes the packet
+bool packet_manager_frame_packet_in(packet_manager_t* manager,
+                                    uint8_t const* chunk,
+                                    size_t chunk_size,
+                                    size_t* offset,
+                                    packet_in_t* packet)
+{
+    TERMO_ASSERT(manager != NULL);
+    TERMO_ASSERT(chunk != NULL);
+    TERMO_ASSERT(offset != NULL && *offset < chunk_size);
+    TERMO_ASSERT(packet != NULL);
 
-        if (!got_first_byte && (now - start_tick >= total_timeout_ms)) {
-            break;
-        }
+    uint8_t const* line = chunk + *offset;
+    uint8_t const* end = memchr(line, '\n', chunk_size - *offset);
+    size_t size = end != NULL ? (size_t)(end - line) : chunk_size - *offset;
 
-        if (got_first_byte && (now - last_byte_tick >= inter_byte_timeout_ms)) {
-            break;
-        }
+    packet_in_decoder_feed_buffer(&manager->receive_decoder,
+                                  (char const*)line,
+                                  size);
+    manager->receive_index += size;
+    *offset += size;
 
-        if (HAL_UART_Receive(manager->config.packet_uart_bus, &byte, 1, 100U) ==
-            HAL_OK) {
-            got_first_byte = true;
-            last_byte_tick = HAL_GetTick();
+    if (end == NULL) {
+        return false;
+    }
+    (*offset)++;
 
-            if (byte == '\n') {
-                break;
-            }
+    packet_in_err_t err =
+        packet_in_decoder_finish(&manager->receive_decoder, packet);
+    bool is_empty = manager->receive_index == 0UL;
 
-            if (index >= (sizeof(manager->receive_buffer) - 1U)) {
-                break;
-            }
+    packet_in_decoder_reset(&manager->receive_decoder);
+    manager->receive_index = 0UL;
 
-            manager->receive_buffer[index++] = byte;
+    if (err != PACKET_IN_ERR_OK) {
+        if (!is_empty) {
+            TERMO_LOG(TAG, "%s", packet_in_err_to_string(err));
+            manager->receive_invalid++;
         }
+        return false;
     }
 
-    manager->receive_buffer[index] = '\0';
-    TERMO_LOG(TAG, "received: %s", (char*)manager->receive_buffer);
-
-    return packet_manager_parse_packet_in(manager, packet);
+    return true;
 }
 
+#endif
+
 static inline bool packet_manager_send_system_event(system_event_t const* event)
 {
     TERMO_ASSERT(event != NULL);
 
-    return xQueueSend(termo_queue_manager_get(TERMO_QUEUE_TYPE_SYSTEM),
-                      event,
-                      pdMS_TO_TICKS(10)) == pdPASS;
+    if (!termo_stats_queue_send(TERMO_QUEUE_TYPE_SYSTEM,
+                                event,
+                                pdMS_TO_TICKS(10))) {
+        return false;
+    }
+
+    return xTaskNotify(termo_task_manager_get(TERMO_TASK_TYPE_SYSTEM),
+                       SYSTEM_NOTIFY_EVENT,
+                       eSetBits) == pdPASS;
 }
 
-static inline bool packet_manager_receive_packet_notify(packet_notify_t* notify)
+static inline bool packet_manager_receive_packet_notify(packet_notify_t* notify,
+                                                        TickType_t timeout)
 {
     TERMO_ASSERT(notify != NULL);
 
     return xTaskNotifyWait(0x00,
                            PACKET_NOTIFY_ALL,
                            (uint32_t*)notify,
-                           pdMS_TO_TICKS(10)) == pdPASS;
+                           timeout) == pdPASS;
 }
 
 static inline bool packet_manager_has_packet_event(void)
@@ -145,37 +319,25 @@ static inline bool packet_manager_receive_packet_event(packet_event_t* event)
 
     return xQueueReceive(termo_queue_manager_get(TERMO_QUEUE_TYPE_PACKET),
                          event,
-                         pdMS_TO_TICKS(10)) == pdPASS;
-}
-
-static termo_err_t packet_manager_notify_rx_complete_handler(
-    packet_manager_t* manager)
-{
-    TERMO_LOG_FUNC(TAG);
-    TERMO_ASSERT(manager != NULL);
-
-    // HAL_UART_Receive_IT(manager->config.packet_uart_bus,
-    //                     manager->receive_buffer,
-    //                     sizeof(manager->receive_buffer));
-
-    return TERMO_ERR_OK;
+                         0U) == pdPASS;
 }
 
-static termo_err_t packet_manager_notify_handler(packet_manager_t* manager,
-                                                 packet_notify_t notify)
+// undoes a start that failed half way, the STOP2 lock included
+static inline void packet_manager_abort_start(packet_manager_t* manager)
 {
     TERMO_ASSERT(manager != NULL);
 
-    if ((notify & PACKET_NOTIFY_RX_COMPLETE) == PACKET_NOTIFY_RX_COMPLETE) {
-    }
+    manager->is_running = false;
+    packet_manager_stop_receive(manager);
 
-    return TERMO_ERR_OK;
+    termo_power_unlock_stop();
 }
 
 static termo_err_t packet_manager_event_start_handler(
     packet_manager_t* manager,
     packet_event_payload_start_t const* start)
 {
+    TERMO_TRACE_FUNC();
     TERMO_LOG_FUNC(TAG);
     TERMO_ASSERT(manager != NULL);
     TERMO_ASSERT(start != NULL);
@@ -184,15 +346,29 @@ static termo_err_t packet_manager_event_start_handler(
         return TERMO_ERR_ALREADY_RUNNING;
     }
 
+    termo_power_lock_stop();
+
+    packet_manager_reset_packet_in(manager);
+    termo_ring_reset(&manager->receive_ring);
+
+    manager->measure_batch.count = 0U;
+
+    // set before the reception starts, an error right away restarts it
+    manager->is_running = true;
+
+    if (!packet_manager_start_receive(manager)) {
+        packet_manager_abort_start(manager);
+        return TERMO_ERR_FAIL;
+    }
+
     system_event_t event = {.origin = SYSTEM_EVENT_ORIGIN_PACKET,
                             .type = SYSTEM_EVENT_TYPE_PACKET_STARTED,
                             .payload.packet_started = {}};
     if (!packet_manager_send_system_event(&event)) {
+        packet_manager_abort_start(manager);
         return TERMO_ERR_FAIL;
     }
 
-    manager->is_running = true;
-
     return TERMO_ERR_OK;
 }
 
@@ -200,6 +376,7 @@ static termo_err_t packet_manager_event_stop_handler(
     packet_manager_t* manager,
     packet_event_payload_stop_t const* stop)
 {
+    TERMO_TRACE_FUNC();
     TERMO_LOG_FUNC(TAG);
     TERMO_ASSERT(manager != NULL);
     TERMO_ASSERT(stop != NULL);
@@ -215,16 +392,80 @@ static termo_err_t packet_manager_event_stop_handler(
         return TERMO_ERR_FAIL;
     }
 
+    termo_power_unlock_stop();
     manager->is_running = false;
 
+    packet_manager_stop_trace_dump(manager);
+
+    if (!packet_manager_stop_receive(manager)) {
+        return TERMO_ERR_FAIL;
+    }
+
     return TERMO_ERR_OK;
 }
 
-static termo_err_t packet_manager_event_measure_handler(
+static inline bool packet_manager_has_measure_batch_expired(
+    packet_manager_t* manager)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    packet_out_payload_measure_batch_t const* measure_batch =
+        &manager->measure_batch;
+
+    if (measure_batch->count == 0U) {
+        return false;
+    }
+
+    if (measure_batch->count >= manager->config.measure_batch_size ||
+        measure_batch->count >= PACKET_OUT_MEASURE_BATCH_SIZE) {
+        return true;
+    }
+
+    uint32_t elapsed = HAL_GetTick() - measure_batch->samples[0].timestamp;
+
+    return manager->config.measure_batch_window > 0U &&
+           elapsed >= manager->config.measure_batch_window;
+}
+
+static inline TickType_t packet_manager_get_notify_timeout(
+    packet_manager_t const* manager)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    packet_out_payload_measure_batch_t const* measure_batch =
+        &manager->measure_batch;
+
+    if (measure_batch->count == 0U ||
+        manager->config.measure_batch_window == 0U) {
+        return portMAX_DELAY;
+    }
+
+    uint32_t elapsed = HAL_GetTick() - measure_batch->samples[0].timestamp;
+    if (elapsed >= manager->config.measure_batch_window) {
+        return 0U;
+    }
+
+    return pdMS_TO_TICKS(manager->config.measure_batch_window - elapsed);
+}
+
+static inline bool packet_manager_transmit_measure_batch(
+    packet_manager_t* manager)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    packet_out_t packet = {.type = PACKET_OUT_TYPE_MEASURE_BATCH,
+                           .payload.measure_batch = manager->measure_batch};
+
+    manager->measure_batch.count = 0U;
+
+    return packet_manager_transmit_packet_out(manager, &packet);
+}
+
+static termo_err_t packet_manager_bus_measure_handler(
     packet_manager_t* manager,
-    packet_event_payload_measure_t const* measure)
+    termo_bus_payload_measure_t const* measure)
 {
-    TERMO_LOG_FUNC(TAG);
+    TERMO_TRACE_FUNC();
     TERMO_ASSERT(manager != NULL);
     TERMO_ASSERT(measure != NULL);
 
@@ -232,11 +473,179 @@ static termo_err_t packet_manager_event_measure_handler(
         return TERMO_ERR_NOT_RUNNING;
     }
 
+    // a duplicate repeats the previous conversion, the host already has it
+    if (measure->is_duplicate) {
+        return TERMO_ERR_OK;
+    }
+
+    if (manager->config.measure_batch_size > 1U) {
+        packet_out_payload_measure_batch_t* measure_batch =
+            &manager->measure_batch;
+
+        // a sample too far from the first one starts a batch of its own
+        if (measure_batch->count > 0U &&
+            measure->timestamp - measure_batch->samples[0].timestamp >
+                PACKET_OUT_MEASURE_BATCH_SPAN) {
+            if (!packet_manager_transmit_measure_batch(manager)) {
+                return TERMO_ERR_FAIL;
+            }
+        }
+
+        measure_batch->samples[measure_batch->count++] =
+            (packet_out_measure_sample_t){.timestamp = measure->timestamp,
+                                          .temperature = measure->temperature,
+                                          .humidity = measure->humidity,
+                                          .pressure = measure->pressure};
+
+        if (packet_manager_has_measure_batch_expired(manager)) {
+            if (!packet_manager_transmit_measure_batch(manager)) {
+                return TERMO_ERR_FAIL;
+            }
+        }
+    } else {
+        packet_out_t packet = {
+            .type = PACKET_OUT_TYPE_MEASURE,
+            .payload.measure = {.temperature = measure->temperature,
+                                .humidity = measure->humidity,
+                                .pressure = measure->pressure}};
+
+        if (!packet_manager_transmit_packet_out(manager, &packet)) {
+            return TERMO_ERR_FAIL;
+        }
+    }
+
+    termo_stats_set_measure_latency(HAL_GetTick() - measure->timestamp);
+
+    return TERMO_ERR_OK;
+}
+
+static termo_err_t packet_manager_bus_control_handler(
+    packet_manager_t* manager,
+    termo_bus_payload_control_t const* control)
+{
+    TERMO_TRACE_FUNC();
+    TERMO_ASSERT(manager != NULL);
+    TERMO_ASSERT(control != NULL);
+
+    if (!manager->is_running) {
+        return TERMO_ERR_NOT_RUNNING;
+    }
+
+    // without an estimator the control step adds nothing the host needs
+    if (!control->has_estimate) {
+        return TERMO_ERR_OK;
+    }
+
+    packet_out_t packet = {
+        .type = PACKET_OUT_TYPE_ESTIMATE,
+        .payload.estimate = {.timestamp = control->timestamp,
+                             .temperature = control->estimate,
+                             .variance = control->variance,
+                             .duty = control->duty}};
+
+    if (!packet_manager_transmit_packet_out(manager, &packet)) {
+        return TERMO_ERR_FAIL;
+    }
+
+    return TERMO_ERR_OK;
+}
+
+static inline packet_out_step_metrics_t packet_manager_step_metrics(
+    termo_bus_step_metrics_t const* metrics)
+{
+    TERMO_ASSERT(metrics != NULL);
+
+    return (packet_out_step_metrics_t){.rise_time = metrics->rise_time,
+                                       .overshoot = metrics->overshoot,
+                                       .settling_time = metrics->settling_time,
+                                       .iae = metrics->iae};
+}
+
+static termo_err_t packet_manager_bus_autotune_handler(
+    packet_manager_t* manager,
+    termo_bus_payload_autotune_t const* autotune)
+{
+    TERMO_TRACE_FUNC();
+    TERMO_LOG_FUNC(TAG);
+    TERMO_ASSERT(manager != NULL);
+    TERMO_ASSERT(autotune != NULL);
+
+    if (!manager->is_running) {
+        return TERMO_ERR_NOT_RUNNING;
+    }
+
     packet_out_t packet = {
-        .type = PACKET_OUT_TYPE_MEASURE,
-        .payload.measure = {.temperature = measure->temperature,
-                            .humidity = measure->humidity,
-                            .pressure = measure->pressure}};
+        .type = PACKET_OUT_TYPE_AUTOTUNE,
+        .payload.autotune = {
+            .timestamp = autotune->timestamp,
+            .rule = autotune->rule,
+            .is_identified = autotune->is_identified,
+            .ultimate_gain = autotune->ultimate_gain,
+            .ultimate_period = autotune->ultimate_period,
+            .kp = autotune->kp,
+            .ki = autotune->ki,
+            .kd = autotune->kd,
+            .has_before = autotune->has_before,
+            .before = packet_manager_step_metrics(&autotune->before),
+            .has_after = autotune->has_after,
+            .after = packet_manager_step_metrics(&autotune->after)}};
+
+    if (!packet_manager_transmit_packet_out(manager, &packet)) {
+        return TERMO_ERR_FAIL;
+    }
+
+    return TERMO_ERR_OK;
+}
+
+static termo_err_t packet_manager_event_stats_handler(
+    packet_manager_t* manager,
+    packet_event_payload_stats_t const* stats)
+{
+    TERMO_TRACE_FUNC();
+    TERMO_LOG_FUNC(TAG);
+    TERMO_ASSERT(manager != NULL);
+    TERMO_ASSERT(stats != NULL);
+
+    if (!manager->is_running) {
+        return TERMO_ERR_NOT_RUNNING;
+    }
+
+    termo_stats_t sample;
+    termo_stats_sample(&sample);
+
+    static_assert(TERMO_TASK_TYPE_NUM <= PACKET_OUT_STATS_TASK_NUM);
+    static_assert(TERMO_QUEUE_TYPE_NUM <= PACKET_OUT_STATS_QUEUE_NUM);
+
+    packet_out_t packet = {
+        .type = PACKET_OUT_TYPE_STATS,
+        .payload.stats = {.period = sample.period,
+                          .task_count = TERMO_TASK_TYPE_NUM,
+                          .queue_count = TERMO_QUEUE_TYPE_NUM,
+                          .sensor = {.errors = sample.sensor.errors,
+                                     .timeouts = sample.sensor.timeouts,
+                                     .duplicates = sample.sensor.duplicates,
+                                     .resolution = sample.sensor.resolution,
+                                     .sample_rate =
+                                         sample.sensor.sample_rate},
+                          .display = {.superseded = sample.display.superseded,
+                                      .bytes_sent = sample.display.bytes_sent,
+                                      .bytes_per_second =
+                                          sample.display.bytes_per_second},
+                          .latency = {.reference = sample.latency.reference,
+                                      .measure = sample.latency.measure}}};
+
+    for (size_t index = 0UL; index < TERMO_TASK_TYPE_NUM; ++index) {
+        packet.payload.stats.tasks[index] = (packet_out_stats_task_t){
+            .cpu_load = sample.tasks[index].cpu_load,
+            .stack_free = sample.tasks[index].stack_free};
+    }
+    for (size_t index = 0UL; index < TERMO_QUEUE_TYPE_NUM; ++index) {
+        packet.payload.stats.queues[index] = (packet_out_stats_queue_t){
+            .depth = sample.queues[index].depth,
+            .peak_depth = sample.queues[index].peak_depth,
+            .length = sample.queues[index].length,
+            .send_failed = sample.queues[index].send_failed};
+    }
 
     if (!packet_manager_transmit_packet_out(manager, &packet)) {
         return TERMO_ERR_FAIL;
@@ -248,6 +657,7 @@ static termo_err_t packet_manager_event_measure_handler(
 static termo_err_t packet_manager_event_handler(packet_manager_t* manager,
                                                 packet_event_t const* event)
 {
+    TERMO_TRACE_FUNC();
     TERMO_ASSERT(manager != NULL);
     TERMO_ASSERT(event != NULL);
 
@@ -260,10 +670,39 @@ static termo_err_t packet_manager_event_handler(packet_manager_t* manager,
             return packet_manager_event_stop_handler(manager,
                                                      &event->payload.stop);
         }
-        case PACKET_EVENT_TYPE_MEASURE: {
-            return packet_manager_event_measure_handler(
+        case PACKET_EVENT_TYPE_STATS: {
+            return packet_manager_event_stats_handler(manager,
+                                                      &event->payload.stats);
+        }
+        default: {
+            return TERMO_ERR_UNKNOWN_EVENT;
+        }
+    }
+}
+
+static termo_err_t packet_manager_bus_handler(
+    packet_manager_t* manager,
+    termo_bus_message_t const* message)
+{
+    TERMO_TRACE_FUNC();
+    TERMO_ASSERT(manager != NULL);
+    TERMO_ASSERT(message != NULL);
+
+    switch (message->topic) {
+        case TERMO_BUS_TOPIC_MEASURE: {
+            return packet_manager_bus_measure_handler(
+                manager,
+                &message->payload.measure);
+        }
+        case TERMO_BUS_TOPIC_CONTROL: {
+            return packet_manager_bus_control_handler(
+                manager,
+                &message->payload.control);
+        }
+        case TERMO_BUS_TOPIC_AUTOTUNE: {
+            return packet_manager_bus_autotune_handler(
                 manager,
-                &event->payload.measure);
+                &message->payload.autotune);
         }
         default: {
             return TERMO_ERR_UNKNOWN_EVENT;
@@ -275,7 +714,7 @@ static termo_err_t packet_manager_packet_in_reference_handler(
     packet_manager_t* manager,
     packet_in_payload_reference_t const* reference)
 {
-    TERMO_LOG_FUNC(TAG);
+    TERMO_TRACE_FUNC();
     TERMO_ASSERT(manager != NULL);
     TERMO_ASSERT(reference != NULL);
 
@@ -287,7 +726,65 @@ static termo_err_t packet_manager_packet_in_reference_handler(
         .origin = SYSTEM_EVENT_ORIGIN_PACKET,
         .type = SYSTEM_EVENT_TYPE_TERMO_REFERENCE,
         .payload.termo_reference = {.temperature = reference->temperature,
-                                    .update_time = reference->update_time}};
+                                    .update_time = reference->update_time,
+                                    .timestamp = HAL_GetTick(),
+                                    .zone = reference->zone}};
+    if (!packet_manager_send_system_event(&event)) {
+        return TERMO_ERR_FAIL;
+    }
+
+    return TERMO_ERR_OK;
+}
+
+static termo_err_t packet_manager_packet_in_trace_dump_handler(
+    packet_manager_t* manager,
+    packet_in_payload_trace_dump_t const* trace_dump)
+{
+    TERMO_TRACE_FUNC();
+    TERMO_LOG_FUNC(TAG);
+    TERMO_ASSERT(manager != NULL);
+    TERMO_ASSERT(trace_dump != NULL);
+
+    if (!manager->is_running) {
+        return TERMO_ERR_NOT_RUNNING;
+    }
+
+    if (manager->is_trace_dumping) {
+        return TERMO_ERR_ALREADY_RUNNING;
+    }
+
+    termo_trace_pause();
+
+    manager->is_trace_dumping = true;
+    manager->trace_index = 0U;
+    manager->trace_total = (uint32_t)termo_trace_get_count();
+
+    if (!packet_manager_transmit_trace(manager)) {
+        return TERMO_ERR_FAIL;
+    }
+
+    return TERMO_ERR_OK;
+}
+
+static termo_err_t packet_manager_packet_in_autotune_handler(
+    packet_manager_t* manager,
+    packet_in_payload_autotune_t const* autotune)
+{
+    TERMO_TRACE_FUNC();
+    TERMO_LOG_FUNC(TAG);
+    TERMO_ASSERT(manager != NULL);
+    TERMO_ASSERT(autotune != NULL);
+
+    if (!manager->is_running) {
+        return TERMO_ERR_NOT_RUNNING;
+    }
+
+    system_event_t event = {
+        .origin = SYSTEM_EVENT_ORIGIN_PACKET,
+        .type = SYSTEM_EVENT_TYPE_TERMO_AUTOTUNE,
+        .payload.termo_autotune = {.setpoint = autotune->setpoint,
+                                   .amplitude = autotune->amplitude,
+                                   .rule = autotune->rule}};
     if (!packet_manager_send_system_event(&event)) {
         return TERMO_ERR_FAIL;
     }
@@ -298,7 +795,7 @@ static termo_err_t packet_manager_packet_in_reference_handler(
 static termo_err_t packet_manager_packet_in_handler(packet_manager_t* manager,
                                                     packet_in_t const* packet)
 {
-    TERMO_LOG_FUNC(TAG);
+    TERMO_TRACE_FUNC();
     TERMO_ASSERT(manager != NULL);
     TERMO_ASSERT(packet != NULL);
 
@@ -308,18 +805,123 @@ static termo_err_t packet_manager_packet_in_handler(packet_manager_t* manager,
                 manager,
                 &packet->payload.reference);
         }
+        case PACKET_IN_TYPE_TRACE_DUMP: {
+            return packet_manager_packet_in_trace_dump_handler(
+                manager,
+                &packet->payload.trace_dump);
+        }
+        case PACKET_IN_TYPE_AUTOTUNE: {
+            return packet_manager_packet_in_autotune_handler(
+                manager,
+                &packet->payload.autotune);
+        }
         default: {
             return TERMO_ERR_UNKNOWN_EVENT;
         }
     }
 }
 
+static termo_err_t packet_manager_notify_rx_complete_handler(
+    packet_manager_t* manager)
+{
+    TERMO_TRACE_FUNC();
+    TERMO_ASSERT(manager != NULL);
+
+    uint8_t chunk[sizeof(manager->receive_buffer)];
+    size_t chunk_size;
+    while ((chunk_size = termo_ring_read(&manager->receive_ring,
+                                         chunk,
+                                         sizeof(chunk))) > 0UL) {
+        size_t offset = 0UL;
+        while (offset < chunk_size) {
+            packet_in_t packet;
+            if (packet_manager_frame_packet_in(manager,
+                                               chunk,
+                                               chunk_size,
+                                               &offset,
+                                               &packet)) {
+                TERMO_LOG_ON_ERR(
+                    TAG,
+                    packet_manager_packet_in_handler(manager, &packet));
+            }
+        }
+    }
+
+    if (!atomic_load(&manager->is_receive_pending) && manager->is_running) {
+        if (!packet_manager_start_receive(manager)) {
+            return TERMO_ERR_FAIL;
+        }
+    }
+
+    return TERMO_ERR_OK;
+}
+
+static termo_err_t packet_manager_notify_tx_complete_handler(
+    packet_manager_t* manager)
+{
+    TERMO_TRACE_FUNC();
+    TERMO_ASSERT(manager != NULL);
+
+    manager->is_transmit_pending = false;
+
+    if (!packet_manager_start_transmit(manager)) {
+        return TERMO_ERR_FAIL;
+    }
+
+    if (!packet_manager_transmit_trace(manager)) {
+        return TERMO_ERR_FAIL;
+    }
+
+    return TERMO_ERR_OK;
+}
+
+// the frame in flight is lost, the next one goes out once the uart is free
+static termo_err_t packet_manager_notify_tx_error_handler(
+    packet_manager_t* manager)
+{
+    TERMO_TRACE_FUNC();
+    TERMO_ASSERT(manager != NULL);
+
+    if (!manager->is_transmit_pending ||
+        packet_manager_is_uart_busy(manager, HAL_UART_STATE_BUSY_TX)) {
+        return TERMO_ERR_OK;
+    }
+
+    manager->transmit_errors++;
+
+    return packet_manager_notify_tx_complete_handler(manager);
+}
+
+static termo_err_t packet_manager_notify_handler(packet_manager_t* manager,
+                                                 packet_notify_t notify)
+{
+    TERMO_TRACE_FUNC();
+    TERMO_ASSERT(manager != NULL);
+
+    if ((notify & PACKET_NOTIFY_TX_COMPLETE) == PACKET_NOTIFY_TX_COMPLETE) {
+        TERMO_RET_ON_ERR(packet_manager_notify_tx_complete_handler(manager));
+    }
+    if ((notify & PACKET_NOTIFY_TX_ERROR) == PACKET_NOTIFY_TX_ERROR) {
+        TERMO_RET_ON_ERR(packet_manager_notify_tx_error_handler(manager));
+    }
+    if ((notify & PACKET_NOTIFY_RX_COMPLETE) == PACKET_NOTIFY_RX_COMPLETE) {
+        TERMO_RET_ON_ERR(packet_manager_notify_rx_complete_handler(manager));
+    }
+
+    return TERMO_ERR_OK;
+}
+
 termo_err_t packet_manager_process(packet_manager_t* manager)
 {
     TERMO_ASSERT(manager != NULL);
 
     packet_notify_t notify;
-    if (packet_manager_receive_packet_notify(&notify)) {
+    bool has_notify = packet_manager_receive_packet_notify(
+        &notify,
+        packet_manager_get_notify_timeout(manager));
+
+    TERMO_TRACE_FUNC();
+    if (has_notify) {
         TERMO_RET_ON_ERR(packet_manager_notify_handler(manager, notify));
     }
 
@@ -330,14 +932,56 @@ termo_err_t packet_manager_process(packet_manager_t* manager)
         }
     }
 
-    packet_in_t packet;
-    if (packet_manager_receive_packet_in(manager, &packet)) {
-        packet_manager_packet_in_handler(manager, &packet);
+    termo_bus_message_t const* message;
+    while ((message = termo_bus_receive(TERMO_BUS_SUBSCRIBER_PACKET)) != NULL) {
+        termo_err_t message_err = packet_manager_bus_handler(manager, message);
+        termo_bus_release(message);
+        TERMO_RET_ON_ERR(message_err);
+    }
+
+    if (packet_manager_has_measure_batch_expired(manager)) {
+        if (!packet_manager_transmit_measure_batch(manager)) {
+            return TERMO_ERR_FAIL;
+        }
     }
 
     return TERMO_ERR_OK;
 }
 
+// the dma keeps running, every half, full and idle line event reports the
+// position it has written up to and the bytes since the last event are new
+void packet_manager_receive_event(packet_manager_t* manager, size_t position)
+{
+    TERMO_ASSERT(manager != NULL);
+    TERMO_ASSERT(position <= sizeof(manager->receive_buffer));
+
+    if (termo_ring_write_circular(&manager->receive_ring,
+                                  manager->receive_buffer,
+                                  sizeof(manager->receive_buffer),
+                                  &manager->receive_position,
+                                  position) > 0UL) {
+        manager->receive_dropped++;
+    }
+}
+
+// errors abort the dma, the bytes since the last event are lost
+void packet_manager_receive_error(packet_manager_t* manager)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    // a transmit error leaves the reception running
+    if (packet_manager_is_uart_busy(manager, HAL_UART_STATE_BUSY_RX)) {
+        return;
+    }
+
+    atomic_store(&manager->is_receive_pending, false);
+    manager->receive_errors++;
+
+    if (manager->is_running) {
+        packet_manager_start_receive(manager);
+    }
+}
+
 termo_err_t packet_manager_initialize(packet_manager_t* manager,
                                       packet_config_t const* config)
 {
@@ -346,11 +990,32 @@ termo_err_t packet_manager_initialize(packet_manager_t* manager,
 
     manager->is_running = false;
     manager->is_transmit_pending = false;
-    manager->is_receive_pending = false;
+    atomic_init(&manager->is_receive_pending, false);
     manager->config = *config;
 
-    memset(manager->transmit_buffer, 0, sizeof(manager->transmit_buffer));
-    memset(manager->receive_buffer, 0, sizeof(manager->receive_buffer));
+    memset(manager->transmit_buffers, 0, sizeof(manager->transmit_buffers));
+    memset(manager->transmit_lengths, 0, sizeof(manager->transmit_lengths));
+    manager->transmit_index = 0UL;
+    manager->transmit_dropped = 0UL;
+    manager->transmit_errors = 0UL;
+
+    manager->measure_batch.count = 0U;
+
+    manager->is_trace_dumping = false;
+    manager->trace_index = 0U;
+    manager->trace_total = 0U;
+
+    packet_manager_reset_packet_in(manager);
+    manager->receive_dropped = 0UL;
+    manager->receive_invalid = 0UL;
+    manager->receive_errors = 0UL;
+    manager->receive_position = 0UL;
+
+    if (!termo_ring_initialize(&manager->receive_ring,
+                               manager->receive_ring_storage,
+                               sizeof(manager->receive_ring_storage))) {
+        return TERMO_ERR_FAIL;
+    }
 
     system_event_t event = {.origin = SYSTEM_EVENT_ORIGIN_PACKET,
                             .type = SYSTEM_EVENT_TYPE_PACKET_READY,
@@ -4,31 +4,73 @@
 #include "stm32l476xx.h"
 #include "stm32l4xx_hal.h"
 #include "termo_common.h"
+#include "packet_in.h"
+#include "packet_out.h"
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stdint.h>
 
 typedef struct {
     UART_HandleTypeDef* packet_uart_bus;
+    uint32_t measure_batch_size;
+    uint32_t measure_batch_window;
 } packet_config_t;
 
-#define TRANSMIT_BUFFER_SIZE (150U)
-#define RECEIVE_BUFFER_SIZE (150U)
+// a text stats frame with every counter at its widest
+#define TRANSMIT_BUFFER_SIZE (640U)
+#define RECEIVE_BUFFER_SIZE (64U)
+#define RECEIVE_RING_SIZE (256U)
+#define TRANSMIT_BUFFER_NUM (2U)
 
 typedef struct {
     bool is_running;
     bool is_transmit_pending;
-    bool is_receive_pending;
+    atomic_bool is_receive_pending;
 
-    uint8_t transmit_buffer[TRANSMIT_BUFFER_SIZE];
+    uint8_t transmit_buffers[TRANSMIT_BUFFER_NUM][TRANSMIT_BUFFER_SIZE];
+    size_t transmit_lengths[TRANSMIT_BUFFER_NUM];
+    size_t transmit_index;
+    size_t transmit_dropped;
+    size_t transmit_errors;
+
+    packet_out_payload_measure_batch_t measure_batch;
+
+    bool is_trace_dumping;
+    uint32_t trace_index;
+    uint32_t trace_total;
+
+#ifdef USE_BINARY_PACKETS
+    uint8_t receive_frame[PACKET_IN_SIZE];
+#else
+    packet_in_decoder_t receive_decoder;
+#endif
+    size_t receive_index;
+    size_t receive_dropped;
+    size_t receive_invalid;
+    size_t receive_errors;
+
+    // circular dma target, the position is where the last event ended
     uint8_t receive_buffer[RECEIVE_BUFFER_SIZE];
+    size_t receive_position;
+    uint8_t receive_ring_storage[RECEIVE_RING_SIZE];
+    termo_ring_t receive_ring;
 
     packet_config_t config;
 } packet_manager_t;
 
 #undef TRANSMIT_BUFFER_SIZE
 #undef RECEIVE_BUFFER_SIZE
+#undef RECEIVE_RING_SIZE
+#undef TRANSMIT_BUFFER_NUM
 
 termo_err_t packet_manager_process(packet_manager_t* manager);
+void packet_manager_receive_event(packet_manager_t* manager, size_t size);
+void packet_manager_receive_error(packet_manager_t* manager);
+bool packet_manager_frame_packet_in(packet_manager_t* manager,
+                                    uint8_t const* chunk,
+                                    size_t chunk_size,
+                                    size_t* offset,
+                                    packet_in_t* packet);
 termo_err_t packet_manager_initialize(packet_manager_t* manager,
                                       packet_config_t const* config);
 
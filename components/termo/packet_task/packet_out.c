@@ -4,6 +4,60 @@
 
 #ifdef USE_BINARY_PACKETS
 
+// wire size of every payload type, the batches without their entries, which
+// add their own size each
+static size_t const packet_out_payload_sizes[] = {
+    [PACKET_OUT_TYPE_MEASURE] = 12UL,
+    [PACKET_OUT_TYPE_MEASURE_BATCH] = 8UL,
+    [PACKET_OUT_TYPE_TRACE] = 16UL,
+    [PACKET_OUT_TYPE_STATS] = 52UL,
+    [PACKET_OUT_TYPE_ESTIMATE] = 16UL,
+    [PACKET_OUT_TYPE_AUTOTUNE] = 64UL,
+};
+
+#define PACKET_OUT_MEASURE_SAMPLE_SIZE (14UL)
+#define PACKET_OUT_TRACE_EVENT_SIZE (16UL)
+#define PACKET_OUT_STATS_TASK_SIZE (8UL)
+#define PACKET_OUT_STATS_QUEUE_SIZE (16UL)
+
+static inline uint32_t packet_out_count_clamp(uint32_t count, uint32_t max)
+{
+    return count > max ? max : count;
+}
+
+static size_t packet_out_payload_size(packet_out_t const* packet)
+{
+    size_t size = packet_out_payload_sizes[packet->type];
+
+    switch (packet->type) {
+        case PACKET_OUT_TYPE_MEASURE_BATCH: {
+            return size + PACKET_OUT_MEASURE_SAMPLE_SIZE *
+                              packet_out_count_clamp(
+                                  packet->payload.measure_batch.count,
+                                  PACKET_OUT_MEASURE_BATCH_SIZE);
+        }
+        case PACKET_OUT_TYPE_TRACE: {
+            return size + PACKET_OUT_TRACE_EVENT_SIZE *
+                              packet_out_count_clamp(
+                                  packet->payload.trace.count,
+                                  PACKET_OUT_TRACE_BATCH_SIZE);
+        }
+        case PACKET_OUT_TYPE_STATS: {
+            return size +
+                   PACKET_OUT_STATS_TASK_SIZE *
+                       packet_out_count_clamp(packet->payload.stats.task_count,
+                                              PACKET_OUT_STATS_TASK_NUM) +
+                   PACKET_OUT_STATS_QUEUE_SIZE *
+                       packet_out_count_clamp(
+                           packet->payload.stats.queue_count,
+                           PACKET_OUT_STATS_QUEUE_NUM);
+        }
+        default: {
+            return size;
+        }
+    }
+}
+
 static inline void packet_out_type_encode(packet_out_type_t type,
                                           uint8_t* buffer)
 {
@@ -39,6 +93,176 @@ static inline void packet_out_payload_measure_encode(
     buffer[11] = humidity & 0xFFU;
 }
 
+static inline void packet_out_uint32_encode(uint32_t value, uint8_t* buffer)
+{
+    buffer[0] = (value >> 24U) & 0xFFU;
+    buffer[1] = (value >> 16U) & 0xFFU;
+    buffer[2] = (value >> 8U) & 0xFFU;
+    buffer[3] = value & 0xFFU;
+}
+
+static inline void packet_out_uint16_encode(uint16_t value, uint8_t* buffer)
+{
+    buffer[0] = (value >> 8U) & 0xFFU;
+    buffer[1] = value & 0xFFU;
+}
+
+static inline void packet_out_float_encode(float value, uint8_t* buffer)
+{
+    uint32_t raw;
+    memcpy(&raw, &value, sizeof(raw));
+    packet_out_uint32_encode(raw, buffer);
+}
+
+// the first timestamp goes out whole, every sample carries its offset from
+// it in milliseconds
+static inline void packet_out_payload_measure_batch_encode(
+    packet_out_payload_measure_batch_t const* measure_batch,
+    uint8_t* buffer)
+{
+    uint32_t count = packet_out_count_clamp(measure_batch->count,
+                                            PACKET_OUT_MEASURE_BATCH_SIZE);
+    uint32_t timestamp = count > 0U ? measure_batch->samples[0].timestamp : 0U;
+
+    packet_out_uint32_encode(count, buffer);
+    packet_out_uint32_encode(timestamp, buffer + 4U);
+    buffer += 8U;
+
+    for (uint32_t index = 0U; index < count; ++index) {
+        packet_out_measure_sample_t const* sample =
+            &measure_batch->samples[index];
+
+        uint32_t offset = packet_out_count_clamp(sample->timestamp - timestamp,
+                                                 PACKET_OUT_MEASURE_BATCH_SPAN);
+        packet_out_uint16_encode((uint16_t)offset, buffer);
+        packet_out_float_encode(sample->temperature, buffer + 2U);
+        packet_out_float_encode(sample->pressure, buffer + 6U);
+        packet_out_float_encode(sample->humidity, buffer + 10U);
+        buffer += PACKET_OUT_MEASURE_SAMPLE_SIZE;
+    }
+}
+
+// binary slices carry only the name addresses, scripts/trace_to_chrome.py
+// reads the names from text slices, so a trace dump needs the text codec
+static inline void packet_out_payload_trace_encode(
+    packet_out_payload_trace_t const* trace,
+    uint8_t* buffer)
+{
+    uint32_t count = trace->count;
+    if (count > PACKET_OUT_TRACE_BATCH_SIZE) {
+        count = PACKET_OUT_TRACE_BATCH_SIZE;
+    }
+
+    packet_out_uint32_encode(trace->clock, buffer);
+    packet_out_uint32_encode(trace->index, buffer + 4U);
+    packet_out_uint32_encode(trace->total, buffer + 8U);
+    packet_out_uint32_encode(count, buffer + 12U);
+    buffer += 16U;
+
+    for (uint32_t index = 0U; index < count; ++index) {
+        packet_out_trace_event_t const* event = &trace->events[index];
+
+        packet_out_uint32_encode(event->timestamp, buffer);
+        packet_out_uint32_encode(event->phase, buffer + 4U);
+        packet_out_uint32_encode((uint32_t)(uintptr_t)event->name,
+                                 buffer + 8U);
+        packet_out_uint32_encode((uint32_t)(uintptr_t)event->task,
+                                 buffer + 12U);
+        buffer += PACKET_OUT_TRACE_EVENT_SIZE;
+    }
+}
+
+static inline void packet_out_payload_stats_encode(
+    packet_out_payload_stats_t const* stats,
+    uint8_t* buffer)
+{
+    uint32_t task_count = stats->task_count;
+    if (task_count > PACKET_OUT_STATS_TASK_NUM) {
+        task_count = PACKET_OUT_STATS_TASK_NUM;
+    }
+
+    uint32_t queue_count = stats->queue_count;
+    if (queue_count > PACKET_OUT_STATS_QUEUE_NUM) {
+        queue_count = PACKET_OUT_STATS_QUEUE_NUM;
+    }
+
+    packet_out_uint32_encode(stats->period, buffer);
+    packet_out_uint32_encode(task_count, buffer + 4U);
+    buffer += 8U;
+
+    for (uint32_t index = 0U; index < task_count; ++index) {
+        packet_out_stats_task_t const* task = &stats->tasks[index];
+
+        packet_out_float_encode(task->cpu_load, buffer);
+        packet_out_uint32_encode(task->stack_free, buffer + 4U);
+        buffer += PACKET_OUT_STATS_TASK_SIZE;
+    }
+
+    packet_out_uint32_encode(queue_count, buffer);
+    buffer += 4U;
+
+    for (uint32_t index = 0U; index < queue_count; ++index) {
+        packet_out_stats_queue_t const* queue = &stats->queues[index];
+
+        packet_out_uint32_encode(queue->depth, buffer);
+        packet_out_uint32_encode(queue->peak_depth, buffer + 4U);
+        packet_out_uint32_encode(queue->length, buffer + 8U);
+        packet_out_uint32_encode(queue->send_failed, buffer + 12U);
+        buffer += PACKET_OUT_STATS_QUEUE_SIZE;
+    }
+
+    packet_out_uint32_encode(stats->sensor.errors, buffer);
+    packet_out_uint32_encode(stats->sensor.timeouts, buffer + 4U);
+    packet_out_uint32_encode(stats->sensor.duplicates, buffer + 8U);
+    packet_out_float_encode(stats->sensor.resolution, buffer + 12U);
+    packet_out_float_encode(stats->sensor.sample_rate, buffer + 16U);
+    packet_out_uint32_encode(stats->display.superseded, buffer + 20U);
+    packet_out_uint32_encode(stats->display.bytes_sent, buffer + 24U);
+    packet_out_uint32_encode(stats->display.bytes_per_second, buffer + 28U);
+    packet_out_uint32_encode(stats->latency.reference, buffer + 32U);
+    packet_out_uint32_encode(stats->latency.measure, buffer + 36U);
+}
+
+static inline void packet_out_payload_estimate_encode(
+    packet_out_payload_estimate_t const* estimate,
+    uint8_t* buffer)
+{
+    packet_out_uint32_encode(estimate->timestamp, buffer);
+    packet_out_float_encode(estimate->temperature, buffer + 4U);
+    packet_out_float_encode(estimate->variance, buffer + 8U);
+    packet_out_float_encode(estimate->duty, buffer + 12U);
+}
+
+static inline void packet_out_step_metrics_encode(
+    packet_out_step_metrics_t const* metrics,
+    uint8_t* buffer)
+{
+    packet_out_float_encode(metrics->rise_time, buffer);
+    packet_out_float_encode(metrics->overshoot, buffer + 4U);
+    packet_out_float_encode(metrics->settling_time, buffer + 8U);
+    packet_out_float_encode(metrics->iae, buffer + 12U);
+}
+
+static inline void packet_out_payload_autotune_encode(
+    packet_out_payload_autotune_t const* autotune,
+    uint8_t* buffer)
+{
+    uint32_t flags = (autotune->is_identified ? 0x01U : 0x00U) |
+                     (autotune->has_before ? 0x02U : 0x00U) |
+                     (autotune->has_after ? 0x04U : 0x00U);
+
+    packet_out_uint32_encode(autotune->timestamp, buffer);
+    packet_out_uint32_encode(autotune->rule, buffer + 4U);
+    packet_out_uint32_encode(flags, buffer + 8U);
+    packet_out_float_encode(autotune->ultimate_gain, buffer + 12U);
+    packet_out_float_encode(autotune->ultimate_period, buffer + 16U);
+    packet_out_float_encode(autotune->kp, buffer + 20U);
+    packet_out_float_encode(autotune->ki, buffer + 24U);
+    packet_out_float_encode(autotune->kd, buffer + 28U);
+    packet_out_step_metrics_encode(&autotune->before, buffer + 32U);
+    packet_out_step_metrics_encode(&autotune->after, buffer + 48U);
+}
+
 static inline void packet_out_payload_encode(
     packet_out_type_t type,
     packet_out_payload_t const* payload,
@@ -49,6 +273,27 @@ static inline void packet_out_payload_encode(
             packet_out_payload_measure_encode(&payload->measure, buffer);
             break;
         }
+        case PACKET_OUT_TYPE_MEASURE_BATCH: {
+            packet_out_payload_measure_batch_encode(&payload->measure_batch,
+                                                    buffer);
+            break;
+        }
+        case PACKET_OUT_TYPE_TRACE: {
+            packet_out_payload_trace_encode(&payload->trace, buffer);
+            break;
+        }
+        case PACKET_OUT_TYPE_STATS: {
+            packet_out_payload_stats_encode(&payload->stats, buffer);
+            break;
+        }
+        case PACKET_OUT_TYPE_ESTIMATE: {
+            packet_out_payload_estimate_encode(&payload->estimate, buffer);
+            break;
+        }
+        case PACKET_OUT_TYPE_AUTOTUNE: {
+            packet_out_payload_autotune_encode(&payload->autotune, buffer);
+            break;
+        }
         default: {
             break;
         }
@@ -56,9 +301,11 @@ static inline void packet_out_payload_encode(
 }
 
 bool packet_out_encode(packet_out_t const* packet,
-                       uint8_t (*buffer)[PACKET_OUT_SIZE])
+                       uint8_t (*buffer)[PACKET_OUT_SIZE],
+                       size_t* encoded_len)
 {
-    if (packet == NULL || buffer == NULL) {
+    if (packet == NULL || buffer == NULL || encoded_len == NULL ||
+        (size_t)packet->type >= TERMO_ARRAY_SIZE(packet_out_payload_sizes)) {
         return false;
     }
 
@@ -68,6 +315,8 @@ bool packet_out_encode(packet_out_t const* packet,
     uint8_t* payload_buffer = *buffer + PACKET_OUT_PAYLOAD_OFFSET;
     packet_out_payload_encode(packet->type, &packet->payload, payload_buffer);
 
+    *encoded_len = PACKET_OUT_PAYLOAD_OFFSET + packet_out_payload_size(packet);
+
     return true;
 }
 
@@ -98,6 +347,164 @@ static inline void packet_out_payload_measure_decode(
     memcpy(&measure->humidity, &humidity, sizeof(humidity));
 }
 
+static inline uint32_t packet_out_uint32_decode(uint8_t const* buffer)
+{
+    return ((buffer[0] & 0xFFU) << 24U) | ((buffer[1] & 0xFFU) << 16U) |
+           ((buffer[2] & 0xFFU) << 8U) | (buffer[3] & 0xFFU);
+}
+
+static inline uint16_t packet_out_uint16_decode(uint8_t const* buffer)
+{
+    return (uint16_t)(((buffer[0] & 0xFFU) << 8U) | (buffer[1] & 0xFFU));
+}
+
+static inline float packet_out_float_decode(uint8_t const* buffer)
+{
+    uint32_t raw = packet_out_uint32_decode(buffer);
+    float value;
+    memcpy(&value, &raw, sizeof(value));
+    return value;
+}
+
+static inline void packet_out_payload_measure_batch_decode(
+    uint8_t const* buffer,
+    packet_out_payload_measure_batch_t* measure_batch)
+{
+    uint32_t count = packet_out_count_clamp(packet_out_uint32_decode(buffer),
+                                            PACKET_OUT_MEASURE_BATCH_SIZE);
+    uint32_t timestamp = packet_out_uint32_decode(buffer + 4U);
+    buffer += 8U;
+
+    measure_batch->count = count;
+    for (uint32_t index = 0U; index < count; ++index) {
+        packet_out_measure_sample_t* sample = &measure_batch->samples[index];
+
+        sample->timestamp = timestamp + packet_out_uint16_decode(buffer);
+        sample->temperature = packet_out_float_decode(buffer + 2U);
+        sample->pressure = packet_out_float_decode(buffer + 6U);
+        sample->humidity = packet_out_float_decode(buffer + 10U);
+        buffer += PACKET_OUT_MEASURE_SAMPLE_SIZE;
+    }
+}
+
+static inline void packet_out_payload_trace_decode(
+    uint8_t const* buffer,
+    packet_out_payload_trace_t* trace)
+{
+    trace->clock = packet_out_uint32_decode(buffer);
+    trace->index = packet_out_uint32_decode(buffer + 4U);
+    trace->total = packet_out_uint32_decode(buffer + 8U);
+
+    uint32_t count = packet_out_uint32_decode(buffer + 12U);
+    if (count > PACKET_OUT_TRACE_BATCH_SIZE) {
+        count = PACKET_OUT_TRACE_BATCH_SIZE;
+    }
+    buffer += 16U;
+
+    trace->count = count;
+    for (uint32_t index = 0U; index < count; ++index) {
+        packet_out_trace_event_t* event = &trace->events[index];
+
+        event->timestamp = packet_out_uint32_decode(buffer);
+        event->phase = packet_out_uint32_decode(buffer + 4U);
+        event->name =
+            (char const*)(uintptr_t)packet_out_uint32_decode(buffer + 8U);
+        event->task =
+            (char const*)(uintptr_t)packet_out_uint32_decode(buffer + 12U);
+        buffer += PACKET_OUT_TRACE_EVENT_SIZE;
+    }
+}
+
+static inline void packet_out_payload_stats_decode(
+    uint8_t const* buffer,
+    packet_out_payload_stats_t* stats)
+{
+    stats->period = packet_out_uint32_decode(buffer);
+
+    uint32_t task_count = packet_out_uint32_decode(buffer + 4U);
+    if (task_count > PACKET_OUT_STATS_TASK_NUM) {
+        task_count = PACKET_OUT_STATS_TASK_NUM;
+    }
+    buffer += 8U;
+
+    stats->task_count = task_count;
+    for (uint32_t index = 0U; index < task_count; ++index) {
+        packet_out_stats_task_t* task = &stats->tasks[index];
+
+        task->cpu_load = packet_out_float_decode(buffer);
+        task->stack_free = packet_out_uint32_decode(buffer + 4U);
+        buffer += PACKET_OUT_STATS_TASK_SIZE;
+    }
+
+    uint32_t queue_count = packet_out_uint32_decode(buffer);
+    if (queue_count > PACKET_OUT_STATS_QUEUE_NUM) {
+        queue_count = PACKET_OUT_STATS_QUEUE_NUM;
+    }
+    buffer += 4U;
+
+    stats->queue_count = queue_count;
+    for (uint32_t index = 0U; index < queue_count; ++index) {
+        packet_out_stats_queue_t* queue = &stats->queues[index];
+
+        queue->depth = packet_out_uint32_decode(buffer);
+        queue->peak_depth = packet_out_uint32_decode(buffer + 4U);
+        queue->length = packet_out_uint32_decode(buffer + 8U);
+        queue->send_failed = packet_out_uint32_decode(buffer + 12U);
+        buffer += PACKET_OUT_STATS_QUEUE_SIZE;
+    }
+
+    stats->sensor.errors = packet_out_uint32_decode(buffer);
+    stats->sensor.timeouts = packet_out_uint32_decode(buffer + 4U);
+    stats->sensor.duplicates = packet_out_uint32_decode(buffer + 8U);
+    stats->sensor.resolution = packet_out_float_decode(buffer + 12U);
+    stats->sensor.sample_rate = packet_out_float_decode(buffer + 16U);
+    stats->display.superseded = packet_out_uint32_decode(buffer + 20U);
+    stats->display.bytes_sent = packet_out_uint32_decode(buffer + 24U);
+    stats->display.bytes_per_second = packet_out_uint32_decode(buffer + 28U);
+    stats->latency.reference = packet_out_uint32_decode(buffer + 32U);
+    stats->latency.measure = packet_out_uint32_decode(buffer + 36U);
+}
+
+static inline void packet_out_payload_estimate_decode(
+    uint8_t const* buffer,
+    packet_out_payload_estimate_t* estimate)
+{
+    estimate->timestamp = packet_out_uint32_decode(buffer);
+    estimate->temperature = packet_out_float_decode(buffer + 4U);
+    estimate->variance = packet_out_float_decode(buffer + 8U);
+    estimate->duty = packet_out_float_decode(buffer + 12U);
+}
+
+static inline void packet_out_step_metrics_decode(
+    uint8_t const* buffer,
+    packet_out_step_metrics_t* metrics)
+{
+    metrics->rise_time = packet_out_float_decode(buffer);
+    metrics->overshoot = packet_out_float_decode(buffer + 4U);
+    metrics->settling_time = packet_out_float_decode(buffer + 8U);
+    metrics->iae = packet_out_float_decode(buffer + 12U);
+}
+
+static inline void packet_out_payload_autotune_decode(
+    uint8_t const* buffer,
+    packet_out_payload_autotune_t* autotune)
+{
+    uint32_t flags = packet_out_uint32_decode(buffer + 8U);
+
+    autotune->timestamp = packet_out_uint32_decode(buffer);
+    autotune->rule = packet_out_uint32_decode(buffer + 4U);
+    autotune->is_identified = (flags & 0x01U) != 0U;
+    autotune->has_before = (flags & 0x02U) != 0U;
+    autotune->has_after = (flags & 0x04U) != 0U;
+    autotune->ultimate_gain = packet_out_float_decode(buffer + 12U);
+    autotune->ultimate_period = packet_out_float_decode(buffer + 16U);
+    autotune->kp = packet_out_float_decode(buffer + 20U);
+    autotune->ki = packet_out_float_decode(buffer + 24U);
+    autotune->kd = packet_out_float_decode(buffer + 28U);
+    packet_out_step_metrics_decode(buffer + 32U, &autotune->before);
+    packet_out_step_metrics_decode(buffer + 48U, &autotune->after);
+}
+
 static inline void packet_out_payload_decode(uint8_t const* buffer,
                                              packet_out_type_t type,
                                              packet_out_payload_t* payload)
@@ -107,6 +514,27 @@ static inline void packet_out_payload_decode(uint8_t const* buffer,
             packet_out_payload_measure_decode(buffer, &payload->measure);
             break;
         }
+        case PACKET_OUT_TYPE_MEASURE_BATCH: {
+            packet_out_payload_measure_batch_decode(buffer,
+                                                    &payload->measure_batch);
+            break;
+        }
+        case PACKET_OUT_TYPE_TRACE: {
+            packet_out_payload_trace_decode(buffer, &payload->trace);
+            break;
+        }
+        case PACKET_OUT_TYPE_STATS: {
+            packet_out_payload_stats_decode(buffer, &payload->stats);
+            break;
+        }
+        case PACKET_OUT_TYPE_ESTIMATE: {
+            packet_out_payload_estimate_decode(buffer, &payload->estimate);
+            break;
+        }
+        case PACKET_OUT_TYPE_AUTOTUNE: {
+            packet_out_payload_autotune_decode(buffer, &payload->autotune);
+            break;
+        }
         default: {
             break;
         }
@@ -129,35 +557,326 @@ bool packet_out_decode(const uint8_t (*buffer)[PACKET_OUT_SIZE],
     return true;
 }
 
+#undef PACKET_OUT_MEASURE_SAMPLE_SIZE
+#undef PACKET_OUT_TRACE_EVENT_SIZE
+#undef PACKET_OUT_STATS_TASK_SIZE
+#undef PACKET_OUT_STATS_QUEUE_SIZE
+
 #else
 
+#define PACKET_OUT_FLOAT_DECIMALS (4U)
+
+typedef struct {
+    char* buffer;
+    size_t buffer_len;
+    size_t written_len;
+    bool has_overflow;
+} packet_out_writer_t;
+
+static inline void packet_out_write_string(packet_out_writer_t* writer,
+                                           char const* string)
+{
+    size_t len = termo_format_string(writer->buffer + writer->written_len,
+                                     writer->buffer_len - writer->written_len,
+                                     string);
+    writer->has_overflow |= (len == 0UL && string[0] != '\0');
+    writer->written_len += len;
+}
+
+static inline void packet_out_write_uint(packet_out_writer_t* writer,
+                                         uint32_t value)
+{
+    size_t len = termo_format_uint(writer->buffer + writer->written_len,
+                                   writer->buffer_len - writer->written_len,
+                                   value);
+    writer->has_overflow |= (len == 0UL);
+    writer->written_len += len;
+}
+
+static inline void packet_out_write_float(packet_out_writer_t* writer,
+                                          float value)
+{
+    size_t len = termo_format_float(writer->buffer + writer->written_len,
+                                    writer->buffer_len - writer->written_len,
+                                    value,
+                                    PACKET_OUT_FLOAT_DECIMALS);
+    writer->has_overflow |= (len == 0UL);
+    writer->written_len += len;
+}
+
+static void packet_out_measure_encode(
+    packet_out_payload_measure_t const* measure,
+    packet_out_writer_t* writer)
+{
+    packet_out_write_string(writer, "{\"packet_type\": ");
+    packet_out_write_uint(writer, PACKET_OUT_TYPE_MEASURE);
+    packet_out_write_string(writer,
+                            ",\"packet_payload\": {\"temperature\": ");
+    packet_out_write_float(writer, measure->temperature);
+    packet_out_write_string(writer, ",\"pressure\": ");
+    packet_out_write_float(writer, measure->pressure);
+    packet_out_write_string(writer, ",\"humidity\": ");
+    packet_out_write_float(writer, measure->humidity);
+    packet_out_write_string(writer, "}}\n");
+}
+
+static void packet_out_measure_batch_encode(
+    packet_out_payload_measure_batch_t const* measure_batch,
+    packet_out_writer_t* writer)
+{
+    uint32_t count = measure_batch->count;
+    if (count > PACKET_OUT_MEASURE_BATCH_SIZE) {
+        count = PACKET_OUT_MEASURE_BATCH_SIZE;
+    }
+
+    packet_out_write_string(writer, "{\"packet_type\": ");
+    packet_out_write_uint(writer, PACKET_OUT_TYPE_MEASURE_BATCH);
+    packet_out_write_string(writer, ",\"packet_payload\": {\"samples\": [");
+
+    for (uint32_t index = 0U; index < count; ++index) {
+        packet_out_measure_sample_t const* sample =
+            &measure_batch->samples[index];
+
+        packet_out_write_string(writer, index > 0U ? ",[" : "[");
+        packet_out_write_uint(writer, sample->timestamp);
+        packet_out_write_string(writer, ",");
+        packet_out_write_float(writer, sample->temperature);
+        packet_out_write_string(writer, ",");
+        packet_out_write_float(writer, sample->pressure);
+        packet_out_write_string(writer, ",");
+        packet_out_write_float(writer, sample->humidity);
+        packet_out_write_string(writer, "]");
+    }
+
+    packet_out_write_string(writer, "]}}\n");
+}
+
+static void packet_out_trace_encode(packet_out_payload_trace_t const* trace,
+                                    packet_out_writer_t* writer)
+{
+    uint32_t count = trace->count;
+    if (count > PACKET_OUT_TRACE_BATCH_SIZE) {
+        count = PACKET_OUT_TRACE_BATCH_SIZE;
+    }
+
+    packet_out_write_string(writer, "{\"packet_type\": ");
+    packet_out_write_uint(writer, PACKET_OUT_TYPE_TRACE);
+    packet_out_write_string(writer, ",\"packet_payload\": {\"clock\": ");
+    packet_out_write_uint(writer, trace->clock);
+    packet_out_write_string(writer, ",\"index\": ");
+    packet_out_write_uint(writer, trace->index);
+    packet_out_write_string(writer, ",\"total\": ");
+    packet_out_write_uint(writer, trace->total);
+    packet_out_write_string(writer, ",\"events\": [");
+
+    for (uint32_t index = 0U; index < count; ++index) {
+        packet_out_trace_event_t const* event = &trace->events[index];
+
+        packet_out_write_string(writer, index > 0U ? ",[\"" : "[\"");
+        packet_out_write_string(writer, event->name);
+        packet_out_write_string(writer, "\",\"");
+        packet_out_write_string(writer, event->task);
+        packet_out_write_string(writer, "\",");
+        packet_out_write_uint(writer, event->timestamp);
+        packet_out_write_string(writer, ",");
+        packet_out_write_uint(writer, event->phase);
+        packet_out_write_string(writer, "]");
+    }
+
+    packet_out_write_string(writer, "]}}\n");
+}
+
+static void packet_out_stats_encode(packet_out_payload_stats_t const* stats,
+                                    packet_out_writer_t* writer)
+{
+    uint32_t task_count = stats->task_count;
+    if (task_count > PACKET_OUT_STATS_TASK_NUM) {
+        task_count = PACKET_OUT_STATS_TASK_NUM;
+    }
+
+    uint32_t queue_count = stats->queue_count;
+    if (queue_count > PACKET_OUT_STATS_QUEUE_NUM) {
+        queue_count = PACKET_OUT_STATS_QUEUE_NUM;
+    }
+
+    packet_out_write_string(writer, "{\"packet_type\": ");
+    packet_out_write_uint(writer, PACKET_OUT_TYPE_STATS);
+    packet_out_write_string(writer, ",\"packet_payload\": {\"period\": ");
+    packet_out_write_uint(writer, stats->period);
+    packet_out_write_string(writer, ",\"tasks\": [");
+
+    for (uint32_t index = 0U; index < task_count; ++index) {
+        packet_out_stats_task_t const* task = &stats->tasks[index];
+
+        packet_out_write_string(writer, index > 0U ? ",[" : "[");
+        packet_out_write_float(writer, task->cpu_load);
+        packet_out_write_string(writer, ",");
+        packet_out_write_uint(writer, task->stack_free);
+        packet_out_write_string(writer, "]");
+    }
+
+    packet_out_write_string(writer, "],\"queues\": [");
+
+    for (uint32_t index = 0U; index < queue_count; ++index) {
+        packet_out_stats_queue_t const* queue = &stats->queues[index];
+
+        packet_out_write_string(writer, index > 0U ? ",[" : "[");
+        packet_out_write_uint(writer, queue->depth);
+        packet_out_write_string(writer, ",");
+        packet_out_write_uint(writer, queue->peak_depth);
+        packet_out_write_string(writer, ",");
+        packet_out_write_uint(writer, queue->length);
+        packet_out_write_string(writer, ",");
+        packet_out_write_uint(writer, queue->send_failed);
+        packet_out_write_string(writer, "]");
+    }
+
+    packet_out_write_string(writer, "],\"sensor\": [");
+    packet_out_write_uint(writer, stats->sensor.errors);
+    packet_out_write_string(writer, ",");
+    packet_out_write_uint(writer, stats->sensor.timeouts);
+    packet_out_write_string(writer, ",");
+    packet_out_write_uint(writer, stats->sensor.duplicates);
+    packet_out_write_string(writer, ",");
+    packet_out_write_float(writer, stats->sensor.resolution);
+    packet_out_write_string(writer, ",");
+    packet_out_write_float(writer, stats->sensor.sample_rate);
+    packet_out_write_string(writer, "],\"display\": [");
+    packet_out_write_uint(writer, stats->display.superseded);
+    packet_out_write_string(writer, ",");
+    packet_out_write_uint(writer, stats->display.bytes_sent);
+    packet_out_write_string(writer, ",");
+    packet_out_write_uint(writer, stats->display.bytes_per_second);
+    packet_out_write_string(writer, "],\"latency\": [");
+    packet_out_write_uint(writer, stats->latency.reference);
+    packet_out_write_string(writer, ",");
+    packet_out_write_uint(writer, stats->latency.measure);
+    packet_out_write_string(writer, "]}}\n");
+}
+
+static void packet_out_estimate_encode(
+    packet_out_payload_estimate_t const* estimate,
+    packet_out_writer_t* writer)
+{
+    packet_out_write_string(writer, "{\"packet_type\": ");
+    packet_out_write_uint(writer, PACKET_OUT_TYPE_ESTIMATE);
+    packet_out_write_string(writer, ",\"packet_payload\": {\"timestamp\": ");
+    packet_out_write_uint(writer, estimate->timestamp);
+    packet_out_write_string(writer, ",\"temperature\": ");
+    packet_out_write_float(writer, estimate->temperature);
+    packet_out_write_string(writer, ",\"variance\": ");
+    packet_out_write_float(writer, estimate->variance);
+    packet_out_write_string(writer, ",\"duty\": ");
+    packet_out_write_float(writer, estimate->duty);
+    packet_out_write_string(writer, "}}\n");
+}
+
+// a step without metrics is written as an empty array
+static void packet_out_step_metrics_encode(
+    bool has_metrics,
+    packet_out_step_metrics_t const* metrics,
+    packet_out_writer_t* writer)
+{
+    if (!has_metrics) {
+        packet_out_write_string(writer, "[]");
+        return;
+    }
+
+    packet_out_write_string(writer, "[");
+    packet_out_write_float(writer, metrics->rise_time);
+    packet_out_write_string(writer, ",");
+    packet_out_write_float(writer, metrics->overshoot);
+    packet_out_write_string(writer, ",");
+    packet_out_write_float(writer, metrics->settling_time);
+    packet_out_write_string(writer, ",");
+    packet_out_write_float(writer, metrics->iae);
+    packet_out_write_string(writer, "]");
+}
+
+static void packet_out_autotune_encode(
+    packet_out_payload_autotune_t const* autotune,
+    packet_out_writer_t* writer)
+{
+    packet_out_write_string(writer, "{\"packet_type\": ");
+    packet_out_write_uint(writer, PACKET_OUT_TYPE_AUTOTUNE);
+    packet_out_write_string(writer, ",\"packet_payload\": {\"timestamp\": ");
+    packet_out_write_uint(writer, autotune->timestamp);
+    packet_out_write_string(writer, ",\"rule\": ");
+    packet_out_write_uint(writer, autotune->rule);
+    packet_out_write_string(writer, ",\"identified\": ");
+    packet_out_write_uint(writer, autotune->is_identified ? 1U : 0U);
+    packet_out_write_string(writer, ",\"ultimate_gain\": ");
+    packet_out_write_float(writer, autotune->ultimate_gain);
+    packet_out_write_string(writer, ",\"ultimate_period\": ");
+    packet_out_write_float(writer, autotune->ultimate_period);
+    packet_out_write_string(writer, ",\"gains\": [");
+    packet_out_write_float(writer, autotune->kp);
+    packet_out_write_string(writer, ",");
+    packet_out_write_float(writer, autotune->ki);
+    packet_out_write_string(writer, ",");
+    packet_out_write_float(writer, autotune->kd);
+    packet_out_write_string(writer, "],\"before\": ");
+    packet_out_step_metrics_encode(autotune->has_before,
+                                   &autotune->before,
+                                   writer);
+    packet_out_write_string(writer, ",\"after\": ");
+    packet_out_step_metrics_encode(autotune->has_after,
+                                   &autotune->after,
+                                   writer);
+    packet_out_write_string(writer, "}}\n");
+}
+
 bool packet_out_encode(packet_out_t const* packet,
                        char* buffer,
-                       size_t buffer_len)
+                       size_t buffer_len,
+                       size_t* encoded_len)
 {
-    if (packet == NULL || buffer == NULL || buffer_len == 0UL) {
+    if (packet == NULL || buffer == NULL || buffer_len == 0UL ||
+        encoded_len == NULL) {
         return false;
     }
 
-    int written_len = 0;
-    if (packet->type == PACKET_OUT_TYPE_MEASURE) {
-        written_len = snprintf(buffer,
-                               buffer_len,
-                               "{\"packet_type\": %d,"
-                               "\"packet_payload\": {"
-                               "\"temperature\": %f,"
-                               "\"pressure\": %f,"
-                               "\"humidity\": %f}}\n",
-                               packet->type,
-                               packet->payload.measure.temperature,
-                               packet->payload.measure.pressure,
-                               packet->payload.measure.humidity);
-    }
-    if (written_len < 0) {
+    packet_out_writer_t writer = {.buffer = buffer,
+                                  .buffer_len = buffer_len,
+                                  .written_len = 0UL,
+                                  .has_overflow = false};
+
+    switch (packet->type) {
+        case PACKET_OUT_TYPE_MEASURE: {
+            packet_out_measure_encode(&packet->payload.measure, &writer);
+            break;
+        }
+        case PACKET_OUT_TYPE_MEASURE_BATCH: {
+            packet_out_measure_batch_encode(&packet->payload.measure_batch,
+                                            &writer);
+            break;
+        }
+        case PACKET_OUT_TYPE_TRACE: {
+            packet_out_trace_encode(&packet->payload.trace, &writer);
+            break;
+        }
+        case PACKET_OUT_TYPE_STATS: {
+            packet_out_stats_encode(&packet->payload.stats, &writer);
+            break;
+        }
+        case PACKET_OUT_TYPE_ESTIMATE: {
+            packet_out_estimate_encode(&packet->payload.estimate, &writer);
+            break;
+        }
+        case PACKET_OUT_TYPE_AUTOTUNE: {
+            packet_out_autotune_encode(&packet->payload.autotune, &writer);
+            break;
+        }
+        default: {
+            return false;
+        }
+    }
+
+    if (writer.has_overflow || writer.written_len == 0UL) {
         return false;
     }
 
-    buffer[written_len] = '\0';
+    *encoded_len = writer.written_len;
     return true;
 }
 
@@ -224,9 +943,69 @@ bool packet_out_decode(char const* buffer,
             return false;
         }
         packet->payload.measure.humidity = humidity;
+    } else if (packet->type == PACKET_OUT_TYPE_MEASURE_BATCH) {
+        str = strstr(buffer, "\"samples\"");
+        if (str == NULL) {
+            return false;
+        }
+
+        str = strchr(str, '[');
+        if (str == NULL) {
+            return false;
+        }
+        str++;
+
+        packet_out_payload_measure_batch_t* measure_batch =
+            &packet->payload.measure_batch;
+        measure_batch->count = 0U;
+
+        while (measure_batch->count < PACKET_OUT_MEASURE_BATCH_SIZE) {
+            packet_out_measure_sample_t sample;
+            unsigned long timestamp;
+            scanned_num = sscanf(str,
+                                 " [%lu,%f,%f,%f]",
+                                 &timestamp,
+                                 &sample.temperature,
+                                 &sample.pressure,
+                                 &sample.humidity);
+            if (scanned_num != 4) {
+                break;
+            }
+
+            sample.timestamp = (uint32_t)timestamp;
+            measure_batch->samples[measure_batch->count++] = sample;
+
+            str = strchr(str, ']');
+            if (str == NULL || *(++str) != ',') {
+                break;
+            }
+            str++;
+        }
+    } else if (packet->type == PACKET_OUT_TYPE_ESTIMATE) {
+        str = strstr(buffer, "\"timestamp\"");
+        if (str == NULL) {
+            return false;
+        }
+
+        packet_out_payload_estimate_t* estimate = &packet->payload.estimate;
+        unsigned long timestamp;
+        scanned_num = sscanf(str,
+                             "\"timestamp\": %lu,\"temperature\": %f,"
+                             "\"variance\": %f,\"duty\": %f",
+                             &timestamp,
+                             &estimate->temperature,
+                             &estimate->variance,
+                             &estimate->duty);
+        if (scanned_num != 4) {
+            return false;
+        }
+
+        estimate->timestamp = (uint32_t)timestamp;
     }
 
     return true;
 }
 
+#undef PACKET_OUT_FLOAT_DECIMALS
+
 #endif
@@ -5,8 +5,22 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#define PACKET_OUT_MEASURE_BATCH_SIZE (8U)
+#define PACKET_OUT_TRACE_BATCH_SIZE (4U)
+#define PACKET_OUT_STATS_TASK_NUM (8U)
+#define PACKET_OUT_STATS_QUEUE_NUM (8U)
+
+// the longest a measure batch may span in ms, binary samples carry their
+// timestamps as 16 bit offsets from the first one
+#define PACKET_OUT_MEASURE_BATCH_SPAN (UINT16_MAX)
+
 typedef enum {
     PACKET_OUT_TYPE_MEASURE,
+    PACKET_OUT_TYPE_MEASURE_BATCH,
+    PACKET_OUT_TYPE_TRACE,
+    PACKET_OUT_TYPE_STATS,
+    PACKET_OUT_TYPE_ESTIMATE,
+    PACKET_OUT_TYPE_AUTOTUNE,
 } packet_out_type_t;
 
 typedef struct {
@@ -15,8 +29,118 @@ typedef struct {
     float humidity;
 } packet_out_payload_measure_t;
 
+typedef struct {
+    uint32_t timestamp;
+    float temperature;
+    float pressure;
+    float humidity;
+} packet_out_measure_sample_t;
+
+typedef struct {
+    uint32_t count;
+    packet_out_measure_sample_t samples[PACKET_OUT_MEASURE_BATCH_SIZE];
+} packet_out_payload_measure_batch_t;
+
+typedef struct {
+    uint32_t timestamp;
+    uint32_t phase;
+    char const* name;
+    char const* task;
+} packet_out_trace_event_t;
+
+// one slice of a trace dump - index and total locate it within the dump,
+// clock is the timestamp rate in Hz
+typedef struct {
+    uint32_t clock;
+    uint32_t index;
+    uint32_t total;
+    uint32_t count;
+    packet_out_trace_event_t events[PACKET_OUT_TRACE_BATCH_SIZE];
+} packet_out_payload_trace_t;
+
+// state estimate of the controlled temperature with its variance, and the
+// duty in percent it was predicted with
+typedef struct {
+    uint32_t timestamp;
+    float temperature;
+    float variance;
+    float duty;
+} packet_out_payload_estimate_t;
+
+typedef struct {
+    float rise_time;
+    float overshoot;
+    float settling_time;
+    float iae;
+} packet_out_step_metrics_t;
+
+// relay experiment result and the gains it gave, with the response to a
+// reference step before the experiment and after the new gains took over
+typedef struct {
+    uint32_t timestamp;
+    uint32_t rule;
+    bool is_identified;
+    float ultimate_gain;
+    float ultimate_period;
+    float kp;
+    float ki;
+    float kd;
+    bool has_before;
+    packet_out_step_metrics_t before;
+    bool has_after;
+    packet_out_step_metrics_t after;
+} packet_out_payload_autotune_t;
+
+typedef struct {
+    float cpu_load;
+    uint32_t stack_free;
+} packet_out_stats_task_t;
+
+typedef struct {
+    uint32_t depth;
+    uint32_t peak_depth;
+    uint32_t length;
+    uint32_t send_failed;
+} packet_out_stats_queue_t;
+
+typedef struct {
+    uint32_t errors;
+    uint32_t timeouts;
+    uint32_t duplicates;
+    float resolution;
+    float sample_rate;
+} packet_out_stats_sensor_t;
+
+typedef struct {
+    uint32_t superseded;
+    uint32_t bytes_sent;
+    uint32_t bytes_per_second;
+} packet_out_stats_display_t;
+
+typedef struct {
+    uint32_t reference;
+    uint32_t measure;
+} packet_out_stats_latency_t;
+
+// tasks and queues are indexed by termo_task_type_t and termo_queue_type_t
+typedef struct {
+    uint32_t period;
+    uint32_t task_count;
+    packet_out_stats_task_t tasks[PACKET_OUT_STATS_TASK_NUM];
+    uint32_t queue_count;
+    packet_out_stats_queue_t queues[PACKET_OUT_STATS_QUEUE_NUM];
+    packet_out_stats_sensor_t sensor;
+    packet_out_stats_display_t display;
+    packet_out_stats_latency_t latency;
+} packet_out_payload_stats_t;
+
 typedef union {
     packet_out_payload_measure_t measure;
+    packet_out_payload_measure_batch_t measure_batch;
+    packet_out_payload_trace_t trace;
+    packet_out_payload_stats_t stats;
+    packet_out_payload_estimate_t estimate;
+    packet_out_payload_autotune_t autotune;
 } packet_out_payload_t;
 
 typedef struct {
@@ -36,7 +160,8 @@ typedef struct {
 #define PACKET_OUT_SIZE (PACKET_OUT_TYPE_SIZE + PACKET_OUT_PAYLOAD_SIZE)
 
 bool packet_out_encode(packet_out_t const* packet,
-                       uint8_t (*buffer)[PACKET_OUT_SIZE]);
+                       uint8_t (*buffer)[PACKET_OUT_SIZE],
+                       size_t* encoded_len);
 
 bool packet_out_decode(const uint8_t (*buffer)[PACKET_OUT_SIZE],
                        packet_out_t* packet);
@@ -45,7 +170,8 @@ bool packet_out_decode(const uint8_t (*buffer)[PACKET_OUT_SIZE],
 
 bool packet_out_encode(packet_out_t const* packet,
                        char* buffer,
-                       size_t buffer_len);
+                       size_t buffer_len,
+                       size_t* encoded_len);
 
 bool packet_out_decode(char const* buffer,
                        size_t buffer_len,
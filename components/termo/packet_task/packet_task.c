@@ -13,17 +13,19 @@
 #define PACKET_QUEUE_LENGTH (10U)
 #define PACKET_QUEUE_STORAGE_SIZE (PACKET_QUEUE_ITEM_SIZE * PACKET_QUEUE_LENGTH)
 
+static packet_manager_t packet_manager;
+
 static void packet_task_func(void* ctx)
 {
     packet_task_ctx_t* task_ctx = (packet_task_ctx_t*)ctx;
 
-    packet_manager_t manager;
-    TERMO_LOG_ON_ERR(pcTaskGetName(NULL),
-                     packet_manager_initialize(&manager, &task_ctx->config));
+    TERMO_LOG_ON_ERR(
+        pcTaskGetName(NULL),
+        packet_manager_initialize(&packet_manager, &task_ctx->config));
 
     while (1) {
-        TERMO_LOG_ON_ERR(pcTaskGetName(NULL), packet_manager_process(&manager));
-        TERMO_DELAY(10);
+        TERMO_LOG_ON_ERR(pcTaskGetName(NULL),
+                         packet_manager_process(&packet_manager));
     }
 }
 
@@ -71,8 +73,23 @@ termo_err_t packet_task_initialize(packet_task_ctx_t const* task_ctx)
     return TERMO_ERR_OK;
 }
 
-void packet_task_rx_complete_callback(void)
+void packet_task_rx_complete_callback(uint16_t size)
+{
+    packet_manager_receive_event(&packet_manager, size);
+
+    BaseType_t task_woken = pdFALSE;
+    xTaskNotifyFromISR(termo_task_manager_get(TERMO_TASK_TYPE_PACKET),
+                       PACKET_NOTIFY_RX_COMPLETE,
+                       eSetBits,
+                       &task_woken);
+    portYIELD_FROM_ISR(task_woken);
+}
+
+// the task retries the restart if it failed here
+void packet_task_rx_error_callback(void)
 {
+    packet_manager_receive_error(&packet_manager);
+
     BaseType_t task_woken = pdFALSE;
     xTaskNotifyFromISR(termo_task_manager_get(TERMO_TASK_TYPE_PACKET),
                        PACKET_NOTIFY_RX_COMPLETE,
@@ -80,3 +97,23 @@ void packet_task_rx_complete_callback(void)
                        &task_woken);
     portYIELD_FROM_ISR(task_woken);
 }
+
+void packet_task_tx_complete_callback(void)
+{
+    BaseType_t task_woken = pdFALSE;
+    xTaskNotifyFromISR(termo_task_manager_get(TERMO_TASK_TYPE_PACKET),
+                       PACKET_NOTIFY_TX_COMPLETE,
+                       eSetBits,
+                       &task_woken);
+    portYIELD_FROM_ISR(task_woken);
+}
+
+void packet_task_tx_error_callback(void)
+{
+    BaseType_t task_woken = pdFALSE;
+    xTaskNotifyFromISR(termo_task_manager_get(TERMO_TASK_TYPE_PACKET),
+                       PACKET_NOTIFY_TX_ERROR,
+                       eSetBits,
+                       &task_woken);
+    portYIELD_FROM_ISR(task_woken);
+}
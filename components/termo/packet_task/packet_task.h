@@ -10,6 +10,9 @@ typedef struct {
 
 termo_err_t packet_task_initialize(packet_task_ctx_t const* task_ctx);
 
-void packet_task_rx_complete_callback(void);
+void packet_task_rx_complete_callback(uint16_t size);
+void packet_task_rx_error_callback(void);
+void packet_task_tx_complete_callback(void);
+void packet_task_tx_error_callback(void);
 
 #endif // PACKET_TASK_PACKET_TASK_H
\ No newline at end of file
@@ -4,23 +4,30 @@
 
 static char const* const TAG = "system_manager";
 
-static inline bool system_manager_receive_system_notify(system_notify_t* notify)
+static inline bool system_manager_receive_system_notify(system_notify_t* notify,
+                                                        TickType_t timeout)
 {
     TERMO_ASSERT(notify != NULL);
 
     return xTaskNotifyWait(0x00,
                            SYSTEM_NOTIFY_ALL,
                            (uint32_t*)notify,
-                           pdMS_TO_TICKS(10)) == pdPASS;
+                           timeout) == pdPASS;
 }
 
 static inline bool system_manager_send_termo_event(termo_event_t const* event)
 {
     TERMO_ASSERT(event != NULL);
 
-    return xQueueSend(termo_queue_manager_get(TERMO_QUEUE_TYPE_TERMO),
-                      event,
-                      pdMS_TO_TICKS(10)) == pdPASS;
+    if (!termo_stats_queue_send(TERMO_QUEUE_TYPE_TERMO,
+                                event,
+                                pdMS_TO_TICKS(10))) {
+        return false;
+    }
+
+    return xTaskNotify(termo_task_manager_get(TERMO_TASK_TYPE_TERMO),
+                       TERMO_NOTIFY_EVENT,
+                       eSetBits) == pdPASS;
 }
 
 static inline bool system_manager_send_display_event(
@@ -28,18 +35,30 @@ static inline bool system_manager_send_display_event(
 {
     TERMO_ASSERT(event != NULL);
 
-    return xQueueSend(termo_queue_manager_get(TERMO_QUEUE_TYPE_DISPLAY),
-                      event,
-                      pdMS_TO_TICKS(10)) == pdPASS;
+    if (!termo_stats_queue_send(TERMO_QUEUE_TYPE_DISPLAY,
+                                event,
+                                pdMS_TO_TICKS(10))) {
+        return false;
+    }
+
+    return xTaskNotify(termo_task_manager_get(TERMO_TASK_TYPE_DISPLAY),
+                       DISPLAY_NOTIFY_EVENT,
+                       eSetBits) == pdPASS;
 }
 
 static inline bool system_manager_send_packet_event(packet_event_t const* event)
 {
     TERMO_ASSERT(event != NULL);
 
-    return xQueueSend(termo_queue_manager_get(TERMO_QUEUE_TYPE_PACKET),
-                      event,
-                      pdMS_TO_TICKS(10)) == pdPASS;
+    if (!termo_stats_queue_send(TERMO_QUEUE_TYPE_PACKET,
+                                event,
+                                pdMS_TO_TICKS(10))) {
+        return false;
+    }
+
+    return xTaskNotify(termo_task_manager_get(TERMO_TASK_TYPE_PACKET),
+                       PACKET_NOTIFY_EVENT,
+                       eSetBits) == pdPASS;
 }
 
 static inline bool system_manager_has_system_event(void)
@@ -54,12 +73,88 @@ static inline bool system_manager_receive_system_event(system_event_t* event)
 
     return xQueueReceive(termo_queue_manager_get(TERMO_QUEUE_TYPE_SYSTEM),
                          event,
-                         pdMS_TO_TICKS(10)) == pdPASS;
+                         0U) == pdPASS;
+}
+
+static inline TickType_t system_manager_get_period_timeout(
+    uint32_t period,
+    TickType_t timestamp)
+{
+    if (period == 0U) {
+        return portMAX_DELAY;
+    }
+
+    TickType_t period_ticks = pdMS_TO_TICKS(period);
+    TickType_t elapsed = xTaskGetTickCount() - timestamp;
+
+    return elapsed < period_ticks ? period_ticks - elapsed : 0U;
+}
+
+static inline TickType_t system_manager_get_notify_timeout(
+    system_manager_t const* manager)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    TickType_t power_stats_timeout =
+        system_manager_get_period_timeout(manager->config.power_stats_period,
+                                          manager->power_stats_timestamp);
+    TickType_t stats_timeout =
+        system_manager_get_period_timeout(manager->config.stats_period,
+                                          manager->stats_timestamp);
+
+    return power_stats_timeout < stats_timeout ? power_stats_timeout
+                                               : stats_timeout;
+}
+
+static void system_manager_log_power_stats(system_manager_t* manager)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    if (system_manager_get_period_timeout(manager->config.power_stats_period,
+                                          manager->power_stats_timestamp) >
+        0U) {
+        return;
+    }
+    manager->power_stats_timestamp = xTaskGetTickCount();
+
+    termo_power_stats_t stats;
+    termo_power_get_stats(&stats);
+
+    TERMO_LOG(TAG,
+              "%s: %lu ms, %s: %lu ms, %s: %lu ms (%lu entries)",
+              termo_power_mode_to_string(TERMO_POWER_MODE_RUN),
+              stats.mode_times[TERMO_POWER_MODE_RUN],
+              termo_power_mode_to_string(TERMO_POWER_MODE_SLEEP),
+              stats.mode_times[TERMO_POWER_MODE_SLEEP],
+              termo_power_mode_to_string(TERMO_POWER_MODE_STOP2),
+              stats.mode_times[TERMO_POWER_MODE_STOP2],
+              stats.stop2_entries);
+}
+
+static bool system_manager_request_stats(system_manager_t* manager)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    if (system_manager_get_period_timeout(manager->config.stats_period,
+                                          manager->stats_timestamp) > 0U) {
+        return true;
+    }
+    manager->stats_timestamp = xTaskGetTickCount();
+
+    if (!manager->is_packet_running) {
+        return true;
+    }
+
+    packet_event_t event = {.type = PACKET_EVENT_TYPE_STATS,
+                            .payload.stats = {}};
+
+    return system_manager_send_packet_event(&event);
 }
 
 static termo_err_t system_manager_notify_handler(system_manager_t* manager,
                                                  system_notify_t notify)
 {
+    TERMO_TRACE_FUNC();
     TERMO_ASSERT(manager != NULL);
 
     return TERMO_ERR_OK;
@@ -69,6 +164,7 @@ static termo_err_t system_manager_event_termo_ready_handler(
     system_manager_t* manager,
     system_event_payload_termo_ready_t const* termo_ready)
 {
+    TERMO_TRACE_FUNC();
     TERMO_LOG_FUNC(TAG);
     TERMO_ASSERT(manager != NULL);
     TERMO_ASSERT(termo_ready != NULL);
@@ -88,6 +184,7 @@ static termo_err_t system_manager_event_termo_started_handler(
     system_manager_t* manager,
     system_event_payload_termo_started_t const* termo_started)
 {
+    TERMO_TRACE_FUNC();
     TERMO_LOG_FUNC(TAG);
     TERMO_ASSERT(manager != NULL);
     TERMO_ASSERT(termo_started != NULL);
@@ -101,6 +198,7 @@ static termo_err_t system_manager_event_termo_stopped_handler(
     system_manager_t* manager,
     system_event_payload_termo_stopped_t const* termo_stopped)
 {
+    TERMO_TRACE_FUNC();
     TERMO_LOG_FUNC(TAG);
     TERMO_ASSERT(manager != NULL);
     TERMO_ASSERT(termo_stopped != NULL);
@@ -114,6 +212,7 @@ static termo_err_t system_manager_termo_reference_handler(
     system_manager_t* manager,
     system_event_payload_termo_reference_t const* termo_reference)
 {
+    TERMO_TRACE_FUNC();
     TERMO_LOG_FUNC(TAG);
     TERMO_ASSERT(manager != NULL);
     TERMO_ASSERT(termo_reference != NULL);
@@ -130,24 +229,13 @@ static termo_err_t system_manager_termo_reference_handler(
         update_time = manager->update_time;
     }
 
-    if (manager->is_termo_running) {
-        termo_event_t event = {
-            .type = TERMO_EVENT_TYPE_REFERENCE,
-            .payload.reference = {.temperature = temperature,
-                                  .update_time = update_time}};
-        if (!system_manager_send_termo_event(&event)) {
-            return TERMO_ERR_FAIL;
-        }
-    }
-
-    if (manager->is_display_running) {
-        display_event_t event = {
-            .type = DISPLAY_EVENT_TYPE_REFERENCE,
-            .payload.reference = {.temperature = temperature,
-                                  .update_time = update_time}};
-        if (!system_manager_send_display_event(&event)) {
-            return TERMO_ERR_FAIL;
-        }
+    termo_bus_payload_t payload = {
+        .reference = {.temperature = temperature,
+                      .update_time = update_time,
+                      .timestamp = termo_reference->timestamp,
+                      .zone = termo_reference->zone}};
+    if (!termo_bus_publish(TERMO_BUS_TOPIC_REFERENCE, &payload)) {
+        return TERMO_ERR_FAIL;
     }
 
     manager->reference_temperature = temperature;
@@ -156,53 +244,28 @@ static termo_err_t system_manager_termo_reference_handler(
     return TERMO_ERR_OK;
 }
 
-static termo_err_t system_manager_termo_measure_handler(
+static termo_err_t system_manager_termo_autotune_handler(
     system_manager_t* manager,
-    system_event_payload_termo_measure_t const* termo_measure)
+    system_event_payload_termo_autotune_t const* termo_autotune)
 {
+    TERMO_TRACE_FUNC();
     TERMO_LOG_FUNC(TAG);
     TERMO_ASSERT(manager != NULL);
-    TERMO_ASSERT(termo_measure != NULL);
-
-    if (manager->measure_humidity == termo_measure->humidity &&
-        manager->measure_pressure == termo_measure->pressure &&
-        manager->measure_temperature == termo_measure->temperature) {
-        // return TERMO_ERR_OK;
-    }
+    TERMO_ASSERT(termo_autotune != NULL);
 
-    if (manager->is_display_running) {
-        display_event_t event = {
-            .type = DISPLAY_EVENT_TYPE_MEASURE,
-            .payload.measure = {.humidity = termo_measure->humidity,
-                                .pressure = termo_measure->pressure,
-                                .temperature = termo_measure->temperature}};
-        if (!system_manager_send_display_event(&event)) {
-            return TERMO_ERR_FAIL;
-        }
+    if (!manager->is_termo_running) {
+        return TERMO_ERR_NOT_RUNNING;
     }
 
-    if (manager->is_packet_running) {
-        packet_event_t event = {
-            .type = PACKET_EVENT_TYPE_MEASURE,
-            .payload.measure = {.humidity = termo_measure->humidity,
-                                .pressure = termo_measure->pressure,
-                                .temperature = termo_measure->temperature}};
-        if (!system_manager_send_packet_event(&event)) {
-            return TERMO_ERR_FAIL;
-        }
+    termo_event_t event = {
+        .type = TERMO_EVENT_TYPE_AUTOTUNE,
+        .payload.autotune = {.setpoint = termo_autotune->setpoint,
+                             .amplitude = termo_autotune->amplitude,
+                             .rule = termo_autotune->rule}};
+    if (!system_manager_send_termo_event(&event)) {
+        return TERMO_ERR_FAIL;
     }
 
-    manager->measure_humidity = termo_measure->humidity;
-    manager->measure_pressure = termo_measure->pressure;
-    manager->measure_temperature = termo_measure->temperature;
-
-    // TERMO_LOG(TAG,
-    //           "New measure: temperature = %.2f, humidity = %.2f, pressure = "
-    //           "%.2f",
-    //           termo_measure->temperature,
-    //           termo_measure->humidity,
-    //           termo_measure->pressure);
-
     return TERMO_ERR_OK;
 }
 
@@ -210,6 +273,7 @@ static termo_err_t system_manager_event_packet_ready_handler(
     system_manager_t* manager,
     system_event_payload_packet_ready_t const* packet_ready)
 {
+    TERMO_TRACE_FUNC();
     TERMO_LOG_FUNC(TAG);
     TERMO_ASSERT(manager != NULL);
     TERMO_ASSERT(packet_ready != NULL);
@@ -229,6 +293,7 @@ static termo_err_t system_manager_event_packet_started_handler(
     system_manager_t* manager,
     system_event_payload_packet_started_t const* packet_started)
 {
+    TERMO_TRACE_FUNC();
     TERMO_LOG_FUNC(TAG);
     TERMO_ASSERT(manager != NULL);
     TERMO_ASSERT(packet_started != NULL);
@@ -242,6 +307,7 @@ static termo_err_t system_manager_event_packet_stopped_handler(
     system_manager_t* manager,
     system_event_payload_packet_stopped_t const* packet_stopped)
 {
+    TERMO_TRACE_FUNC();
     TERMO_LOG_FUNC(TAG);
     TERMO_ASSERT(manager != NULL);
     TERMO_ASSERT(packet_stopped != NULL);
@@ -255,6 +321,7 @@ static termo_err_t system_manager_event_display_ready_handler(
     system_manager_t* manager,
     system_event_payload_display_ready_t const* display_ready)
 {
+    TERMO_TRACE_FUNC();
     TERMO_LOG_FUNC(TAG);
     TERMO_ASSERT(manager != NULL);
     TERMO_ASSERT(display_ready != NULL);
@@ -274,6 +341,7 @@ static termo_err_t system_manager_event_display_started_handler(
     system_manager_t* manager,
     system_event_payload_display_started_t const* display_started)
 {
+    TERMO_TRACE_FUNC();
     TERMO_LOG_FUNC(TAG);
     TERMO_ASSERT(manager != NULL);
     TERMO_ASSERT(display_started != NULL);
@@ -287,6 +355,7 @@ static termo_err_t system_manager_event_display_stopped_handler(
     system_manager_t* manager,
     system_event_payload_display_stopped_t const* display_stopped)
 {
+    TERMO_TRACE_FUNC();
     TERMO_LOG_FUNC(TAG);
     TERMO_ASSERT(manager != NULL);
     TERMO_ASSERT(display_stopped != NULL);
@@ -299,6 +368,7 @@ static termo_err_t system_manager_event_display_stopped_handler(
 static termo_err_t system_manager_event_handler(system_manager_t* manager,
                                                 system_event_t const* event)
 {
+    TERMO_TRACE_FUNC();
     TERMO_ASSERT(manager != NULL);
     TERMO_ASSERT(event != NULL);
 
@@ -323,10 +393,10 @@ static termo_err_t system_manager_event_handler(system_manager_t* manager,
                 manager,
                 &event->payload.termo_reference);
         }
-        case SYSTEM_EVENT_TYPE_TERMO_MEASURE: {
-            return system_manager_termo_measure_handler(
+        case SYSTEM_EVENT_TYPE_TERMO_AUTOTUNE: {
+            return system_manager_termo_autotune_handler(
                 manager,
-                &event->payload.termo_measure);
+                &event->payload.termo_autotune);
         }
         case SYSTEM_EVENT_TYPE_PACKET_READY: {
             return system_manager_event_packet_ready_handler(
@@ -369,7 +439,13 @@ termo_err_t system_manager_process(system_manager_t* manager)
     TERMO_ASSERT(manager != NULL);
 
     system_notify_t notify;
-    if (system_manager_receive_system_notify(&notify)) {
+    bool has_notify = system_manager_receive_system_notify(
+        &notify,
+        system_manager_get_notify_timeout(manager));
+
+    // the wait for a notify is idle time, not processing
+    TERMO_TRACE_FUNC();
+    if (has_notify) {
         TERMO_RET_ON_ERR(system_manager_notify_handler(manager, notify));
     }
 
@@ -380,6 +456,12 @@ termo_err_t system_manager_process(system_manager_t* manager)
         }
     }
 
+    system_manager_log_power_stats(manager);
+
+    if (!system_manager_request_stats(manager)) {
+        return TERMO_ERR_FAIL;
+    }
+
     return TERMO_ERR_OK;
 }
 
@@ -394,11 +476,11 @@ termo_err_t system_manager_initialize(system_manager_t* manager,
     manager->is_packet_running = false;
 
     manager->reference_temperature = 0.0F;
-    manager->measure_temperature = 0.0F;
-    manager->measure_humidity = 0.0F;
-    manager->measure_pressure = 0.0F;
     manager->update_time = 0.0F;
 
+    manager->power_stats_timestamp = xTaskGetTickCount();
+    manager->stats_timestamp = xTaskGetTickCount();
+
     manager->config = *config;
 
     return TERMO_ERR_OK;
@@ -7,6 +7,8 @@
 #include <stdint.h>
 
 typedef struct {
+    uint32_t power_stats_period;
+    uint32_t stats_period;
 } system_config_t;
 
 typedef struct {
@@ -15,11 +17,11 @@ typedef struct {
     bool is_packet_running;
 
     float reference_temperature;
-    float measure_temperature;
-    float measure_humidity;
-    float measure_pressure;
     float update_time;
 
+    uint32_t power_stats_timestamp;
+    uint32_t stats_timestamp;
+
     system_config_t config;
 } system_manager_t;
 
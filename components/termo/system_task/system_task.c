@@ -23,7 +23,6 @@ static void system_task_func(void* ctx)
 
     while (1) {
         TERMO_LOG_ON_ERR(pcTaskGetName(NULL), system_manager_process(&manager));
-        TERMO_DELAY(10);
     }
 }
 
@@ -7,10 +7,18 @@ void termo_initialize(termo_ctx_t const* config)
 {
     TERMO_ASSERT(config != NULL);
 
+#ifdef USE_TRACE
+    termo_trace_initialize();
+#endif
+
+    TERMO_ERR_CHECK(termo_bus_initialize());
     TERMO_ERR_CHECK(system_task_initialize(&config->system_ctx));
     TERMO_ERR_CHECK(termo_task_initialize(&config->termo_ctx));
     TERMO_ERR_CHECK(display_task_initialize(&config->display_ctx));
     TERMO_ERR_CHECK(packet_task_initialize(&config->packet_ctx));
+#ifdef USE_DEFERRED_LOG
+    TERMO_ERR_CHECK(log_task_initialize(&config->log_ctx));
+#endif
 
     vTaskStartScheduler();
 }
@@ -2,6 +2,7 @@
 #define TERMO_TERMO_H
 
 #include "display_task.h"
+#include "log_task.h"
 #include "packet_task.h"
 #include "system_task.h"
 #include "termo_common.h"
@@ -12,6 +13,7 @@ typedef struct {
     display_task_ctx_t display_ctx;
     termo_task_ctx_t termo_ctx;
     packet_task_ctx_t packet_ctx;
+    log_task_ctx_t log_ctx;
 } termo_ctx_t;
 
 void termo_initialize(termo_ctx_t const* config);
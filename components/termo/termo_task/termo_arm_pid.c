@@ -0,0 +1,265 @@
+#include "termo_arm_pid.h"
+#include <math.h>
+#include <stddef.h>
+
+// compare counts are carried as q31 shifted left by at most this, less when
+// the compare range and the compare of a zero control would not fit in a
+// quarter of the integral range otherwise
+#define TERMO_ARM_PID_Q31_MAX_OUTPUT_SHIFT (14U)
+#define TERMO_ARM_PID_Q31_MAX_COMPARE (0xFFFFUL)
+
+// sum of |A0| + |A1| + |A2| the q31 coefficients are scaled to and the
+// largest error fed in, both keep the 2.62 accumulator clear of overflow
+// and one step below 2^29
+#define TERMO_ARM_PID_Q31_MAX_GAIN (0.5F)
+#define TERMO_ARM_PID_Q31_MAX_INPUT (0.5F)
+
+// the integral stays within +-2^30, so the integral plus one step can not
+// wrap the output
+#define TERMO_ARM_PID_Q31_MAX_STATE (1073741824LL)
+
+#define TERMO_ARM_PID_Q31_ONE (2147483648.0F)
+
+static inline float32_t termo_arm_pid_clamp(float32_t value,
+                                            float32_t min,
+                                            float32_t max)
+{
+    return value < min ? min : value > max ? max : value;
+}
+
+static inline q31_t termo_arm_pid_clamp_q31(q31_t value, q31_t min, q31_t max)
+{
+    return value < min ? min : value > max ? max : value;
+}
+
+static inline q31_t termo_arm_pid_float_to_q31(float32_t value)
+{
+    float32_t scaled = value * TERMO_ARM_PID_Q31_ONE;
+    if (scaled >= TERMO_ARM_PID_Q31_ONE) {
+        return INT32_MAX;
+    }
+    if (scaled <= -TERMO_ARM_PID_Q31_ONE) {
+        return INT32_MIN;
+    }
+
+    return (q31_t)lroundf(scaled);
+}
+
+static inline q31_t termo_arm_pid_get_q31_integral(termo_arm_pid_t const* pid,
+                                                   q31_t integral,
+                                                   q31_t input,
+                                                   q31_t output,
+                                                   q31_t saturated)
+{
+    int64_t next =
+        (int64_t)integral + (((int64_t)pid->q31.instance.Ki * input) >> 31) +
+        (((int64_t)pid->q31.sat_gain * ((int64_t)saturated - output)) >> 31);
+
+    return (q31_t)(next < -TERMO_ARM_PID_Q31_MAX_STATE
+                       ? -TERMO_ARM_PID_Q31_MAX_STATE
+                   : next > TERMO_ARM_PID_Q31_MAX_STATE
+                       ? TERMO_ARM_PID_Q31_MAX_STATE
+                       : next);
+}
+
+static bool termo_arm_pid_initialize_f32(termo_arm_pid_t* pid,
+                                         termo_arm_pid_config_t const* config,
+                                         float32_t compare_gain,
+                                         float32_t reset_compare)
+{
+    pid->f32.instance.Kp = compare_gain * config->kp;
+    pid->f32.instance.Ki = compare_gain * config->ki * config->delta_time;
+    pid->f32.instance.Kd = compare_gain * config->kd / config->delta_time;
+    arm_pid_init_f32(&pid->f32.instance, 1);
+
+    // positional form: y = I + (kp + ki + kd) e[n] - kd e[n-1]
+    pid->f32.instance.A1 = -pid->f32.instance.Kd;
+    pid->f32.instance.A2 = 0.0F;
+
+    pid->f32.sat_gain = config->kc;
+    pid->f32.reset_output = reset_compare;
+    pid->f32.min_output = config->min_compare;
+    pid->f32.max_output = config->max_compare;
+    pid->f32.instance.state[2] = pid->f32.reset_output;
+
+    pid->error_scale = 1.0F;
+    pid->max_error = INFINITY;
+
+    return true;
+}
+
+static bool termo_arm_pid_initialize_q31(termo_arm_pid_t* pid,
+                                         termo_arm_pid_config_t const* config,
+                                         float32_t compare_gain,
+                                         float32_t reset_compare)
+{
+    if (config->min_compare < 0.0F ||
+        config->max_compare > (float32_t)TERMO_ARM_PID_Q31_MAX_COMPARE ||
+        config->kc < 0.0F || config->kc > 1.0F) {
+        return false;
+    }
+
+    float32_t max_output = fmaxf(config->max_compare, fabsf(reset_compare));
+    uint32_t output_shift = TERMO_ARM_PID_Q31_MAX_OUTPUT_SHIFT;
+    while (max_output * (float32_t)(1UL << output_shift) >
+           (float32_t)(TERMO_ARM_PID_Q31_MAX_STATE / 4LL)) {
+        if (output_shift == 0U) {
+            return false;
+        }
+        output_shift--;
+    }
+
+    float32_t kp = config->kp;
+    float32_t ki = config->ki * config->delta_time;
+    float32_t kd = config->kd / config->delta_time;
+
+    // A0 = kp + ki + kd, A1 = -kd, A2 = 0
+    float32_t gain_sum = fabsf(kp + ki + kd) + fabsf(kd);
+    float32_t output_scale = (float32_t)(1UL << output_shift);
+
+    // error to q31 scale: guard bits over the control span as recommended
+    // for arm_pid_q31, coarser only if the gains would not fit otherwise
+    float32_t control_span = config->max_control - config->min_control;
+    float32_t error_scale = TERMO_ARM_PID_Q31_ONE / (4.0F * control_span);
+    float32_t min_error_scale = fabsf(compare_gain) * gain_sum *
+                                output_scale / TERMO_ARM_PID_Q31_MAX_GAIN;
+    if (error_scale < min_error_scale) {
+        error_scale = min_error_scale;
+    }
+
+    float32_t coefficient_scale = compare_gain * output_scale / error_scale;
+    pid->q31.instance.Kp = termo_arm_pid_float_to_q31(coefficient_scale * kp);
+    pid->q31.instance.Ki = termo_arm_pid_float_to_q31(coefficient_scale * ki);
+    pid->q31.instance.Kd = termo_arm_pid_float_to_q31(coefficient_scale * kd);
+    arm_pid_init_q31(&pid->q31.instance, 1);
+
+    pid->q31.instance.A1 = -pid->q31.instance.Kd;
+    pid->q31.instance.A2 = 0;
+
+    pid->q31.sat_gain = termo_arm_pid_float_to_q31(config->kc);
+    pid->q31.output_shift = output_shift;
+    pid->q31.reset_output = (q31_t)lroundf(reset_compare * output_scale);
+    pid->q31.min_output = (q31_t)((uint32_t)config->min_compare
+                                  << output_shift);
+    pid->q31.max_output = (q31_t)((uint32_t)config->max_compare
+                                  << output_shift);
+    pid->q31.instance.state[2] = pid->q31.reset_output;
+
+    pid->error_scale = error_scale;
+    pid->max_error =
+        TERMO_ARM_PID_Q31_MAX_INPUT * TERMO_ARM_PID_Q31_ONE / error_scale;
+
+    return true;
+}
+
+bool termo_arm_pid_initialize(termo_arm_pid_t* pid,
+                              termo_arm_pid_config_t const* config)
+{
+    if (pid == NULL || config == NULL || config->delta_time <= 0.0F ||
+        config->max_control <= config->min_control ||
+        config->max_compare < config->min_compare) {
+        return false;
+    }
+
+    pid->format = config->format;
+
+    // the integral starts from a zero control, whose compare lies outside
+    // the compare range unless the control range includes zero
+    float32_t compare_gain = (config->max_compare - config->min_compare) /
+                             (config->max_control - config->min_control);
+    float32_t reset_compare =
+        config->min_compare - compare_gain * config->min_control;
+
+    switch (config->format) {
+        case TERMO_ARM_PID_FORMAT_F32: {
+            return termo_arm_pid_initialize_f32(pid,
+                                                config,
+                                                compare_gain,
+                                                reset_compare);
+        }
+        case TERMO_ARM_PID_FORMAT_Q31: {
+            return termo_arm_pid_initialize_q31(pid,
+                                                config,
+                                                compare_gain,
+                                                reset_compare);
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+void termo_arm_pid_reset(termo_arm_pid_t* pid)
+{
+    if (pid == NULL) {
+        return;
+    }
+
+    switch (pid->format) {
+        case TERMO_ARM_PID_FORMAT_F32: {
+            arm_pid_reset_f32(&pid->f32.instance);
+            pid->f32.instance.state[2] = pid->f32.reset_output;
+            break;
+        }
+        case TERMO_ARM_PID_FORMAT_Q31: {
+            arm_pid_reset_q31(&pid->q31.instance);
+            pid->q31.instance.state[2] = pid->q31.reset_output;
+            break;
+        }
+        default: {
+            break;
+        }
+    }
+}
+
+// arm_pid leaves its unclamped output in the output state, which is put
+// back to the integral with the saturation excess fed back
+uint32_t termo_arm_pid_get_compare(termo_arm_pid_t* pid, float32_t error)
+{
+    if (pid == NULL) {
+        return 0U;
+    }
+
+    switch (pid->format) {
+        case TERMO_ARM_PID_FORMAT_F32: {
+            float32_t integral = pid->f32.instance.state[2];
+            float32_t output = arm_pid_f32(&pid->f32.instance, error);
+            float32_t saturated = termo_arm_pid_clamp(output,
+                                                      pid->f32.min_output,
+                                                      pid->f32.max_output);
+            pid->f32.instance.state[2] =
+                integral + pid->f32.instance.Ki * error +
+                pid->f32.sat_gain * (saturated - output);
+
+            return (uint32_t)saturated;
+        }
+        case TERMO_ARM_PID_FORMAT_Q31: {
+            float32_t clamped_error =
+                termo_arm_pid_clamp(error, -pid->max_error, pid->max_error);
+            q31_t input = (q31_t)(clamped_error * pid->error_scale);
+            q31_t integral = pid->q31.instance.state[2];
+            q31_t output = arm_pid_q31(&pid->q31.instance, input);
+            q31_t saturated = termo_arm_pid_clamp_q31(output,
+                                                      pid->q31.min_output,
+                                                      pid->q31.max_output);
+            pid->q31.instance.state[2] = termo_arm_pid_get_q31_integral(
+                pid,
+                integral,
+                input,
+                output,
+                saturated);
+
+            return (uint32_t)saturated >> pid->q31.output_shift;
+        }
+        default: {
+            return 0U;
+        }
+    }
+}
+
+#undef TERMO_ARM_PID_Q31_MAX_OUTPUT_SHIFT
+#undef TERMO_ARM_PID_Q31_MAX_COMPARE
+#undef TERMO_ARM_PID_Q31_MAX_GAIN
+#undef TERMO_ARM_PID_Q31_MAX_INPUT
+#undef TERMO_ARM_PID_Q31_MAX_STATE
+#undef TERMO_ARM_PID_Q31_ONE
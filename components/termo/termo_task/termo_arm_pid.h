@@ -0,0 +1,63 @@
+#ifndef TERMO_TASK_TERMO_ARM_PID_H
+#define TERMO_TASK_TERMO_ARM_PID_H
+
+#include "arm_math.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef enum {
+    TERMO_ARM_PID_FORMAT_F32,
+    TERMO_ARM_PID_FORMAT_Q31,
+} termo_arm_pid_format_t;
+
+typedef struct {
+    termo_arm_pid_format_t format;
+    float32_t kp;
+    float32_t ki;
+    float32_t kd;
+    float32_t kc;
+    float32_t delta_time;
+    float32_t min_control;
+    float32_t max_control;
+    float32_t min_compare;
+    float32_t max_compare;
+} termo_arm_pid_config_t;
+
+// positional pid on top of arm_pid whose output already is the pwm compare -
+// the linear control to compare map is folded into the coefficients, the
+// output state carries the integral as a compare and the output is clamped
+// to the compare range, kc feeds the saturation excess back into the
+// integral the same way termo_zones does - q31 also holds the integral
+// within its state range, the float engine leaves it unbounded
+typedef struct {
+    termo_arm_pid_format_t format;
+
+    float32_t error_scale;
+    float32_t max_error;
+
+    union {
+        struct {
+            arm_pid_instance_f32 instance;
+            float32_t sat_gain;
+            float32_t reset_output;
+            float32_t min_output;
+            float32_t max_output;
+        } f32;
+        struct {
+            arm_pid_instance_q31 instance;
+            q31_t sat_gain;
+            q31_t reset_output;
+            q31_t min_output;
+            q31_t max_output;
+            uint32_t output_shift;
+        } q31;
+    };
+} termo_arm_pid_t;
+
+bool termo_arm_pid_initialize(termo_arm_pid_t* pid,
+                              termo_arm_pid_config_t const* config);
+void termo_arm_pid_reset(termo_arm_pid_t* pid);
+
+uint32_t termo_arm_pid_get_compare(termo_arm_pid_t* pid, float32_t error);
+
+#endif // TERMO_TASK_TERMO_ARM_PID_H
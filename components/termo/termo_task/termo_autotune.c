@@ -0,0 +1,185 @@
+#include "termo_autotune.h"
+#include <math.h>
+#include <stddef.h>
+
+typedef struct {
+    float32_t prop_factor;
+    float32_t int_factor;
+    float32_t dot_factor;
+} termo_autotune_rule_t;
+
+// kp as a fraction of the ultimate gain, ti and td as fractions of the
+// ultimate period - pessen's half period integral times leave the lower
+// gains underdamped on a lag dominant heater, so the overshoot rules
+// integrate slower until they overshoot less than ziegler-nichols, and
+// not at all for no overshoot
+static termo_autotune_rule_t const
+    termo_autotune_rules[TERMO_TUNING_RULE_NUM] = {
+        [TERMO_TUNING_RULE_ZIEGLER_NICHOLS] =
+            {.prop_factor = 0.6F, .int_factor = 0.5F, .dot_factor = 0.125F},
+        [TERMO_TUNING_RULE_TYREUS_LUYBEN] =
+            {.prop_factor = 0.4545F, .int_factor = 2.2F, .dot_factor = 0.1587F},
+        [TERMO_TUNING_RULE_SOME_OVERSHOOT] =
+            {.prop_factor = 0.33F, .int_factor = 1.5F, .dot_factor = 0.33F},
+        [TERMO_TUNING_RULE_NO_OVERSHOOT] =
+            {.prop_factor = 0.2F, .int_factor = 3.0F, .dot_factor = 0.33F},
+};
+
+bool termo_autotune_start(termo_autotune_t* autotune,
+                          termo_autotune_config_t const* config,
+                          uint32_t timestamp)
+{
+    if (autotune == NULL || config == NULL || config->cycles == 0U ||
+        config->amplitude <= 0.0F || config->hysteresis < 0.0F) {
+        return false;
+    }
+
+    autotune->config = *config;
+    autotune->high_duty = fminf(config->bias + config->amplitude, 1.0F);
+    autotune->low_duty = fmaxf(config->bias - config->amplitude, 0.0F);
+    if (autotune->high_duty <= autotune->low_duty) {
+        return false;
+    }
+
+    autotune->is_high = true;
+    autotune->start_timestamp = timestamp;
+    autotune->rise_timestamp = timestamp;
+    autotune->rise_count = 0U;
+    autotune->max = -INFINITY;
+    autotune->min = INFINITY;
+
+    autotune->cycle_count = 0U;
+    autotune->amplitude_sum = 0.0F;
+    autotune->period_sum = 0.0F;
+
+    autotune->ultimate_gain = 0.0F;
+    autotune->ultimate_period = 0.0F;
+
+    autotune->state = TERMO_AUTOTUNE_STATE_RUNNING;
+
+    return true;
+}
+
+void termo_autotune_cancel(termo_autotune_t* autotune)
+{
+    if (autotune == NULL) {
+        return;
+    }
+
+    autotune->state = TERMO_AUTOTUNE_STATE_IDLE;
+}
+
+// describing function of a relay with hysteresis
+static inline void termo_autotune_identify(termo_autotune_t* autotune)
+{
+    float32_t amplitude =
+        autotune->amplitude_sum / (float32_t)autotune->cycle_count;
+    float32_t hysteresis = autotune->config.hysteresis;
+
+    if (amplitude <= hysteresis) {
+        autotune->state = TERMO_AUTOTUNE_STATE_FAILED;
+        return;
+    }
+
+    float32_t relay = (autotune->high_duty - autotune->low_duty) / 2.0F;
+    autotune->ultimate_gain =
+        4.0F * relay /
+        (PI * sqrtf(amplitude * amplitude - hysteresis * hysteresis));
+    autotune->ultimate_period =
+        autotune->period_sum / (float32_t)autotune->cycle_count;
+    autotune->state = TERMO_AUTOTUNE_STATE_DONE;
+}
+
+float32_t termo_autotune_step(termo_autotune_t* autotune,
+                              float32_t measurement,
+                              uint32_t timestamp)
+{
+    if (autotune == NULL) {
+        return 0.0F;
+    }
+
+    if (autotune->state != TERMO_AUTOTUNE_STATE_RUNNING) {
+        return termo_autotune_get_mean_duty(autotune);
+    }
+
+    if (timestamp - autotune->start_timestamp >= autotune->config.timeout) {
+        autotune->state = TERMO_AUTOTUNE_STATE_FAILED;
+        return termo_autotune_get_mean_duty(autotune);
+    }
+
+    autotune->max = fmaxf(autotune->max, measurement);
+    autotune->min = fminf(autotune->min, measurement);
+
+    float32_t setpoint = autotune->config.setpoint;
+    float32_t hysteresis = autotune->config.hysteresis;
+
+    if (autotune->is_high && measurement > setpoint + hysteresis) {
+        autotune->is_high = false;
+    } else if (!autotune->is_high && measurement < setpoint - hysteresis) {
+        autotune->is_high = true;
+
+        // every switch up closes a cycle, the one before the second is the
+        // approach to the setpoint and not an oscillation yet
+        if (autotune->rise_count > 1U) {
+            autotune->amplitude_sum += (autotune->max - autotune->min) / 2.0F;
+            autotune->period_sum +=
+                (float32_t)(timestamp - autotune->rise_timestamp) / 1000.0F;
+            autotune->cycle_count++;
+        }
+
+        autotune->rise_count++;
+        autotune->rise_timestamp = timestamp;
+        autotune->max = measurement;
+        autotune->min = measurement;
+
+        if (autotune->cycle_count >= autotune->config.cycles) {
+            termo_autotune_identify(autotune);
+            return termo_autotune_get_mean_duty(autotune);
+        }
+    }
+
+    return autotune->is_high ? autotune->high_duty : autotune->low_duty;
+}
+
+float32_t termo_autotune_get_mean_duty(termo_autotune_t const* autotune)
+{
+    if (autotune == NULL) {
+        return 0.0F;
+    }
+
+    return (autotune->high_duty + autotune->low_duty) / 2.0F;
+}
+
+bool termo_autotune_get_gains(termo_autotune_t const* autotune,
+                              termo_tuning_rule_t rule,
+                              float32_t control_span,
+                              float32_t delta_time,
+                              float32_t* kp,
+                              float32_t* ki,
+                              float32_t* kd,
+                              float32_t* kc)
+{
+    if (autotune == NULL || kp == NULL || ki == NULL || kd == NULL ||
+        kc == NULL || autotune->state != TERMO_AUTOTUNE_STATE_DONE ||
+        rule >= TERMO_TUNING_RULE_NUM || delta_time <= 0.0F ||
+        autotune->ultimate_period <= 0.0F) {
+        return false;
+    }
+
+    termo_autotune_rule_t const* factors = &termo_autotune_rules[rule];
+
+    float32_t int_time = factors->int_factor * autotune->ultimate_period;
+    float32_t dot_time = factors->dot_factor * autotune->ultimate_period;
+
+    *kp = factors->prop_factor * autotune->ultimate_gain * control_span;
+    *ki = *kp / int_time;
+    *kd = *kp * dot_time;
+
+    // back-calculation tracking time of astrom and hagglund, the geometric
+    // mean of the integral and derivative times
+    float32_t tracking_time =
+        dot_time > 0.0F ? sqrtf(int_time * dot_time) : int_time;
+    *kc = fminf(delta_time / tracking_time, 1.0F);
+
+    return true;
+}
@@ -0,0 +1,85 @@
+#ifndef TERMO_TASK_TERMO_AUTOTUNE_H
+#define TERMO_TASK_TERMO_AUTOTUNE_H
+
+#include "arm_math.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef enum {
+    TERMO_TUNING_RULE_ZIEGLER_NICHOLS,
+    TERMO_TUNING_RULE_TYREUS_LUYBEN,
+    TERMO_TUNING_RULE_SOME_OVERSHOOT,
+    TERMO_TUNING_RULE_NO_OVERSHOOT,
+    TERMO_TUNING_RULE_NUM,
+} termo_tuning_rule_t;
+
+typedef enum {
+    TERMO_AUTOTUNE_STATE_IDLE,
+    TERMO_AUTOTUNE_STATE_RUNNING,
+    TERMO_AUTOTUNE_STATE_DONE,
+    TERMO_AUTOTUNE_STATE_FAILED,
+} termo_autotune_state_t;
+
+// duties are fractions of the full compare range, the hysteresis is in
+// degrees around the setpoint and the timeout in ms
+typedef struct {
+    float32_t setpoint;
+    float32_t bias;
+    float32_t amplitude;
+    float32_t hysteresis;
+    uint32_t cycles;
+    uint32_t timeout;
+} termo_autotune_config_t;
+
+// astrom-hagglund relay experiment - the duty switches between two levels
+// whenever the measurement leaves the hysteresis band, the first cycle is
+// dropped as transient and the rest give the ultimate gain in duty per
+// degree and the ultimate period in seconds
+typedef struct {
+    termo_autotune_state_t state;
+    termo_autotune_config_t config;
+
+    float32_t high_duty;
+    float32_t low_duty;
+    bool is_high;
+
+    uint32_t start_timestamp;
+    uint32_t rise_timestamp;
+    uint32_t rise_count;
+    float32_t max;
+    float32_t min;
+
+    uint32_t cycle_count;
+    float32_t amplitude_sum;
+    float32_t period_sum;
+
+    float32_t ultimate_gain;
+    float32_t ultimate_period;
+} termo_autotune_t;
+
+bool termo_autotune_start(termo_autotune_t* autotune,
+                          termo_autotune_config_t const* config,
+                          uint32_t timestamp);
+void termo_autotune_cancel(termo_autotune_t* autotune);
+
+// the duty to apply until the next step, the state tells when it is over
+float32_t termo_autotune_step(termo_autotune_t* autotune,
+                              float32_t measurement,
+                              uint32_t timestamp);
+
+// mean of the relay levels, the duty that held the setpoint
+float32_t termo_autotune_get_mean_duty(termo_autotune_t const* autotune);
+
+// parallel form gains for a controller whose output spans control_span
+// degrees over the whole duty range, with the saturation feedback gain kc
+// for a controller stepped every delta_time seconds
+bool termo_autotune_get_gains(termo_autotune_t const* autotune,
+                              termo_tuning_rule_t rule,
+                              float32_t control_span,
+                              float32_t delta_time,
+                              float32_t* kp,
+                              float32_t* ki,
+                              float32_t* kd,
+                              float32_t* kc);
+
+#endif // TERMO_TASK_TERMO_AUTOTUNE_H
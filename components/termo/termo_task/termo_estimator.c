@@ -0,0 +1,72 @@
+#include "termo_estimator.h"
+#include <math.h>
+#include <stddef.h>
+
+bool termo_estimator_initialize(termo_estimator_t* estimator,
+                                termo_estimator_config_t const* config)
+{
+    if (estimator == NULL || config == NULL || config->time_constant <= 0.0F ||
+        config->delta_time <= 0.0F || config->process_noise < 0.0F) {
+        return false;
+    }
+
+    estimator->decay = expf(-config->delta_time / config->time_constant);
+    estimator->input_gain = (1.0F - estimator->decay) * config->gain;
+    estimator->ambient_gain = (1.0F - estimator->decay) * config->ambient;
+    estimator->process_noise = config->process_noise;
+
+    termo_estimator_reset(estimator);
+
+    return true;
+}
+
+void termo_estimator_reset(termo_estimator_t* estimator)
+{
+    if (estimator == NULL) {
+        return;
+    }
+
+    estimator->has_estimate = false;
+    estimator->estimate = 0.0F;
+    estimator->variance = 0.0F;
+}
+
+void termo_estimator_predict(termo_estimator_t* estimator, float32_t duty)
+{
+    if (estimator == NULL || !estimator->has_estimate) {
+        return;
+    }
+
+    estimator->estimate = estimator->decay * estimator->estimate +
+                          estimator->input_gain * duty +
+                          estimator->ambient_gain;
+    estimator->variance = estimator->decay * estimator->decay *
+                              estimator->variance +
+                          estimator->process_noise;
+}
+
+void termo_estimator_correct(termo_estimator_t* estimator,
+                             float32_t measurement,
+                             float32_t noise)
+{
+    if (estimator == NULL) {
+        return;
+    }
+
+    // the first sample is all there is to start from
+    if (!estimator->has_estimate) {
+        estimator->estimate = measurement;
+        estimator->variance = noise;
+        estimator->has_estimate = true;
+        return;
+    }
+
+    float32_t innovation_variance = estimator->variance + noise;
+    if (innovation_variance <= 0.0F) {
+        return;
+    }
+
+    float32_t kalman_gain = estimator->variance / innovation_variance;
+    estimator->estimate += kalman_gain * (measurement - estimator->estimate);
+    estimator->variance *= 1.0F - kalman_gain;
+}
@@ -0,0 +1,43 @@
+#ifndef TERMO_TASK_TERMO_ESTIMATOR_H
+#define TERMO_TASK_TERMO_ESTIMATOR_H
+
+#include "arm_math.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct {
+    float32_t time_constant;
+    float32_t gain;
+    float32_t ambient;
+    float32_t process_noise;
+    float32_t delta_time;
+} termo_estimator_config_t;
+
+// scalar kalman filter on a first order thermal model - over one delta time
+// the temperature decays toward ambient plus gain times the applied duty,
+// predicted every control step and corrected by every fresh sensor sample
+typedef struct {
+    bool has_estimate;
+
+    float32_t decay;
+    float32_t input_gain;
+    float32_t ambient_gain;
+    float32_t process_noise;
+
+    float32_t estimate;
+    float32_t variance;
+} termo_estimator_t;
+
+bool termo_estimator_initialize(termo_estimator_t* estimator,
+                                termo_estimator_config_t const* config);
+void termo_estimator_reset(termo_estimator_t* estimator);
+
+// duty in the range 0 to 1, held over the whole delta time
+void termo_estimator_predict(termo_estimator_t* estimator, float32_t duty);
+
+// noise is the variance of the measurement in degrees squared
+void termo_estimator_correct(termo_estimator_t* estimator,
+                             float32_t measurement,
+                             float32_t noise);
+
+#endif // TERMO_TASK_TERMO_ESTIMATOR_H
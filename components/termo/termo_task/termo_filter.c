@@ -0,0 +1,125 @@
+#include "termo_filter.h"
+#include <math.h>
+#include <stddef.h>
+
+#define FILTER_SQRT2 (1.41421356F)
+
+bool termo_filter_initialize(termo_filter_t* filter,
+                             termo_filter_config_t const* config)
+{
+    if (filter == NULL || config == NULL ||
+        config->median_len > TERMO_FILTER_MEDIAN_MAX ||
+        config->decimation > TERMO_FILTER_DECIMATION_MAX ||
+        config->cutoff < 0.0F || config->cutoff >= 0.5F) {
+        return false;
+    }
+
+    filter->median_len = config->median_len > 1U ? config->median_len : 0U;
+    filter->decimation = config->decimation > 1U ? config->decimation : 1U;
+
+    // bilinear transform with the cutoff prewarped
+    filter->has_low_pass = config->cutoff > 0.0F;
+    if (filter->has_low_pass) {
+        float32_t k = tanf(PI * config->cutoff);
+        float32_t norm = 1.0F / (1.0F + FILTER_SQRT2 * k + k * k);
+
+        filter->b0 = k * k * norm;
+        filter->b1 = 2.0F * filter->b0;
+        filter->b2 = filter->b0;
+        filter->a1 = 2.0F * (k * k - 1.0F) * norm;
+        filter->a2 = (1.0F - FILTER_SQRT2 * k + k * k) * norm;
+    }
+
+    termo_filter_reset(filter);
+
+    return true;
+}
+
+void termo_filter_reset(termo_filter_t* filter)
+{
+    if (filter == NULL) {
+        return;
+    }
+
+    filter->median_count = 0U;
+    filter->median_index = 0U;
+
+    filter->is_primed = false;
+    filter->z1 = 0.0F;
+    filter->z2 = 0.0F;
+
+    filter->decimation_count = 0U;
+    filter->decimation_sum = 0.0F;
+}
+
+// insertion sort of a copy, the window is a handful of samples
+static inline float32_t termo_filter_median(termo_filter_t* filter,
+                                            float32_t sample)
+{
+    filter->median_window[filter->median_index] = sample;
+    filter->median_index = (filter->median_index + 1U) % filter->median_len;
+    if (filter->median_count < filter->median_len) {
+        filter->median_count++;
+    }
+
+    float32_t sorted[TERMO_FILTER_MEDIAN_MAX];
+    for (uint32_t index = 0U; index < filter->median_count; ++index) {
+        float32_t value = filter->median_window[index];
+        uint32_t position = index;
+        while (position > 0U && sorted[position - 1U] > value) {
+            sorted[position] = sorted[position - 1U];
+            position--;
+        }
+        sorted[position] = value;
+    }
+
+    return sorted[(filter->median_count - 1U) / 2U];
+}
+
+// transposed direct form II, primed with the first sample so the output
+// starts settled instead of rising from zero
+static inline float32_t termo_filter_low_pass(termo_filter_t* filter,
+                                              float32_t sample)
+{
+    if (!filter->is_primed) {
+        filter->z1 = sample * (1.0F - filter->b0);
+        filter->z2 = sample * (filter->b2 - filter->a2);
+        filter->is_primed = true;
+    }
+
+    float32_t output = filter->b0 * sample + filter->z1;
+    filter->z1 = filter->b1 * sample - filter->a1 * output + filter->z2;
+    filter->z2 = filter->b2 * sample - filter->a2 * output;
+
+    return output;
+}
+
+bool termo_filter_process(termo_filter_t* filter,
+                          float32_t sample,
+                          float32_t* output)
+{
+    if (filter == NULL || output == NULL) {
+        return false;
+    }
+
+    float32_t value = sample;
+    if (filter->median_len > 0U) {
+        value = termo_filter_median(filter, value);
+    }
+    if (filter->has_low_pass) {
+        value = termo_filter_low_pass(filter, value);
+    }
+
+    filter->decimation_sum += value;
+    if (++filter->decimation_count < filter->decimation) {
+        return false;
+    }
+
+    *output = filter->decimation_sum / (float32_t)filter->decimation;
+    filter->decimation_count = 0U;
+    filter->decimation_sum = 0.0F;
+
+    return true;
+}
+
+#undef FILTER_SQRT2
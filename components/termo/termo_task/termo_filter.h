@@ -0,0 +1,52 @@
+#ifndef TERMO_TASK_TERMO_FILTER_H
+#define TERMO_TASK_TERMO_FILTER_H
+
+#include "arm_math.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#define TERMO_FILTER_MEDIAN_MAX (7U)
+#define TERMO_FILTER_DECIMATION_MAX (16U)
+
+// every stage is optional - a median length below 2 skips the median, a
+// cutoff of 0 skips the low-pass and a decimation below 2 skips decimation,
+// the cutoff is a fraction of the sample rate below one half
+typedef struct {
+    uint32_t median_len;
+    float32_t cutoff;
+    uint32_t decimation;
+} termo_filter_config_t;
+
+// median for spikes, then a second order butterworth low-pass, then the
+// mean of every block of decimation samples
+typedef struct {
+    uint32_t median_len;
+    uint32_t median_count;
+    uint32_t median_index;
+    float32_t median_window[TERMO_FILTER_MEDIAN_MAX];
+
+    bool has_low_pass;
+    bool is_primed;
+    float32_t b0;
+    float32_t b1;
+    float32_t b2;
+    float32_t a1;
+    float32_t a2;
+    float32_t z1;
+    float32_t z2;
+
+    uint32_t decimation;
+    uint32_t decimation_count;
+    float32_t decimation_sum;
+} termo_filter_t;
+
+bool termo_filter_initialize(termo_filter_t* filter,
+                             termo_filter_config_t const* config);
+void termo_filter_reset(termo_filter_t* filter);
+
+// false while a decimation block is still filling
+bool termo_filter_process(termo_filter_t* filter,
+                          float32_t sample,
+                          float32_t* output);
+
+#endif // TERMO_TASK_TERMO_FILTER_H
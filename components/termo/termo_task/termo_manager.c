@@ -3,10 +3,38 @@
 #include "queue.h"
 #include "task.h"
 #include "termo_common.h"
+#include <math.h>
 #include <string.h>
 
+#define SENSOR_TEMP_REGISTER (0x05U)
+#define SENSOR_TEMP_MASK (0x1FFFU)
+#define SENSOR_TEMP_SIGN (0x1000U)
+#define SENSOR_TEMP_RANGE (0x2000)
+#define SENSOR_TEMP_SCALE (16.0F)
+#define SENSOR_SAMPLE_SLACK (5U)
+#define SENSOR_IDLE_RETRIES (10U)
+#define AUTOTUNE_BIAS (0.5F)
+#define AUTOTUNE_AMPLITUDE (0.5F)
+#define AUTOTUNE_HYSTERESIS (2.0F)
+#define AUTOTUNE_CYCLES (4U)
+#define AUTOTUNE_TIMEOUT (3600000U)
+
 static char const* const TAG = "termo_manager";
 
+typedef struct {
+    mcp9808_resolution_t resolution;
+    float32_t step;
+    uint32_t conversion_time;
+} termo_manager_resolution_t;
+
+// typical conversion times in ms from the datasheet, coarsest first
+static termo_manager_resolution_t const termo_manager_resolutions[] = {
+    {.resolution = 0x00, .step = 0.5F, .conversion_time = 30U},
+    {.resolution = 0x01, .step = 0.25F, .conversion_time = 65U},
+    {.resolution = 0x02, .step = 0.125F, .conversion_time = 130U},
+    {.resolution = 0x03, .step = 0.0625F, .conversion_time = 250U},
+};
+
 static inline bool frequency_to_prescaler_and_period(uint32_t frequency_hz,
                                                      uint32_t clock_hz,
                                                      uint32_t max_prescaler,
@@ -41,10 +69,11 @@ static inline bool frequency_to_prescaler_and_period(uint32_t frequency_hz,
 
 static mcp9808_err_t mcp9808_bus_initialize(void* user)
 {
-    termo_config_t* config = user;
+    TERMO_TRACE_FUNC();
+    termo_sensor_t* sensor = user;
 
-    return HAL_I2C_IsDeviceReady(config->mcp9808_i2c_bus,
-                                 config->mcp9808_i2c_address << 1U,
+    return HAL_I2C_IsDeviceReady(sensor->i2c_bus,
+                                 sensor->i2c_address << 1U,
                                  10,
                                  100) == HAL_OK
                ? MCP9808_ERR_OK
@@ -61,10 +90,11 @@ static mcp9808_err_t mcp9808_bus_write_data(void* user,
                                             uint8_t const* data,
                                             size_t data_size)
 {
-    termo_config_t* config = user;
+    TERMO_TRACE_FUNC();
+    termo_sensor_t* sensor = user;
 
-    return HAL_I2C_Mem_Write(config->mcp9808_i2c_bus,
-                             config->mcp9808_i2c_address << 1U,
+    return HAL_I2C_Mem_Write(sensor->i2c_bus,
+                             sensor->i2c_address << 1U,
                              address,
                              I2C_MEMADD_SIZE_8BIT,
                              data,
@@ -79,10 +109,11 @@ static mcp9808_err_t mcp9808_bus_read_data(void* user,
                                            uint8_t* data,
                                            size_t data_size)
 {
-    termo_config_t* config = user;
+    TERMO_TRACE_FUNC();
+    termo_sensor_t* sensor = user;
 
-    return HAL_I2C_Mem_Read(config->mcp9808_i2c_bus,
-                            config->mcp9808_i2c_address << 1U,
+    return HAL_I2C_Mem_Read(sensor->i2c_bus,
+                            sensor->i2c_address << 1U,
                             address,
                             I2C_MEMADD_SIZE_8BIT,
                             data,
@@ -92,7 +123,8 @@ static mcp9808_err_t mcp9808_bus_read_data(void* user,
                : MCP9808_ERR_FAIL;
 }
 
-static mcp9808_err_t mcp9808_initialize_chip(mcp9808_t const* mcp9808)
+static mcp9808_err_t mcp9808_initialize_chip(mcp9808_t const* mcp9808,
+                                             mcp9808_resolution_t resolution)
 {
     mcp9808_manufacturer_id_reg_t man_id = {0};
     mcp9808_device_id_reg_t dev_id = {0};
@@ -120,7 +152,7 @@ static mcp9808_err_t mcp9808_initialize_chip(mcp9808_t const* mcp9808)
 
     mcp9808_set_config_reg(mcp9808, &cfg);
 
-    mcp9808_resolution_reg_t res = {.resolution = 0x03};
+    mcp9808_resolution_reg_t res = {.resolution = resolution};
     mcp9808_set_resolution_reg(mcp9808, &res);
 
     mcp9808_t_upper_reg_t upper = {.t_upper = 30 << 4};
@@ -136,33 +168,161 @@ static mcp9808_err_t mcp9808_initialize_chip(mcp9808_t const* mcp9808)
 
 float32_t mcp9808_resolution_to_scale(mcp9808_resolution_t);
 
+// finest resolution that completes a conversion within every update period
+static inline termo_manager_resolution_t const*
+termo_manager_select_resolution(float32_t update_time)
+{
+    uint32_t period = (uint32_t)(update_time * 1000.0F);
+
+    termo_manager_resolution_t const* selected = &termo_manager_resolutions[0];
+    for (size_t index = 1UL;
+         index < TERMO_ARRAY_SIZE(termo_manager_resolutions);
+         ++index) {
+        if (termo_manager_resolutions[index].conversion_time <= period) {
+            selected = &termo_manager_resolutions[index];
+        }
+    }
+
+    return selected;
+}
+
+static inline void termo_manager_apply_resolution(
+    termo_manager_t* manager,
+    termo_manager_resolution_t const* resolution)
+{
+    TERMO_ASSERT(manager != NULL);
+    TERMO_ASSERT(resolution != NULL);
+
+    manager->resolution = resolution->resolution;
+    manager->resolution_step = resolution->step;
+    manager->conversion_time = resolution->conversion_time;
+
+    // the conversion running now was started with the previous settings
+    manager->sample_timestamp = HAL_GetTick();
+
+    termo_stats_set_sensor_resolution(resolution->step);
+}
+
+// the driver takes its config only when initialized, which keeps the bus
+// interface it already has
+static inline mcp9808_err_t termo_manager_set_sensor_resolution(
+    termo_sensor_t* sensor,
+    mcp9808_resolution_t resolution)
+{
+    TERMO_ASSERT(sensor != NULL);
+
+    mcp9808_resolution_reg_t res = {.resolution = resolution};
+    mcp9808_err_t err = mcp9808_set_resolution_reg(&sensor->mcp9808, &res);
+    if (err != MCP9808_ERR_OK) {
+        return err;
+    }
+
+    mcp9808_interface_t interface = sensor->mcp9808.interface;
+
+    return mcp9808_initialize(
+        &sensor->mcp9808,
+        &(mcp9808_config_t){.scale = mcp9808_resolution_to_scale(resolution)},
+        &interface);
+}
+
+// takes the bus from the async path, a read in flight finishes first - the
+// update timer skips its periods while the claim is held rather than count
+// them as sensor timeouts
+static inline bool termo_manager_claim_sensor(termo_manager_t* manager)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    atomic_store(&manager->is_sensor_claimed, true);
+
+    for (uint32_t retry = 0U; retry < SENSOR_IDLE_RETRIES; ++retry) {
+        if (!atomic_exchange(&manager->is_sensor_pending, true)) {
+            return true;
+        }
+        TERMO_DELAY(1U);
+    }
+
+    atomic_store(&manager->is_sensor_claimed, false);
+
+    return false;
+}
+
+static inline void termo_manager_release_sensor(termo_manager_t* manager)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    atomic_store(&manager->is_sensor_pending, false);
+    atomic_store(&manager->is_sensor_claimed, false);
+}
+
+static inline bool termo_manager_is_arm_pid_engine(
+    termo_control_engine_t control_engine)
+{
+    return control_engine == TERMO_CONTROL_ENGINE_ARM_PID_F32 ||
+           control_engine == TERMO_CONTROL_ENGINE_ARM_PID_Q31;
+}
+
 static inline bool termo_manager_start_pwm_timer(termo_manager_t* manager)
 {
     TERMO_ASSERT(manager != NULL);
 
-    return HAL_TIM_PWM_Start_IT(manager->config.pwm_timer,
-                                manager->config.pwm_channel) == HAL_OK;
+    for (uint32_t zone = 0U; zone < manager->config.zone_count; ++zone) {
+        if (HAL_TIM_PWM_Start_IT(manager->config.zones[zone].pwm_timer,
+                                 manager->config.zones[zone].pwm_channel) !=
+            HAL_OK) {
+            return false;
+        }
+    }
+
+    return true;
 }
 
+// every channel is stopped even when one of them fails to
 static inline bool termo_manager_stop_pwm_timer(termo_manager_t* manager)
 {
     TERMO_ASSERT(manager != NULL);
 
-    return HAL_TIM_PWM_Stop_IT(manager->config.pwm_timer,
-                               manager->config.pwm_channel) == HAL_OK;
+    bool result = true;
+    for (uint32_t zone = 0U; zone < manager->config.zone_count; ++zone) {
+        if (HAL_TIM_PWM_Stop_IT(manager->config.zones[zone].pwm_timer,
+                                manager->config.zones[zone].pwm_channel) !=
+            HAL_OK) {
+            result = false;
+        }
+    }
+
+    return result;
 }
 
 static inline bool termo_manager_set_pwm_timer_compare(termo_manager_t* manager,
+                                                       uint32_t zone,
                                                        uint32_t compare)
 {
     TERMO_ASSERT(manager != NULL);
 
-    __HAL_TIM_SET_COMPARE(manager->config.pwm_timer,
-                          manager->config.pwm_channel,
+    if (zone >= manager->config.zone_count) {
+        return false;
+    }
+
+    __HAL_TIM_SET_COMPARE(manager->config.zones[zone].pwm_timer,
+                          manager->config.zones[zone].pwm_channel,
                           compare & 0xFFFFU);
     return true;
 }
 
+static inline bool termo_manager_clear_pwm_timer_compares(
+    termo_manager_t* manager)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    for (uint32_t zone = 0U; zone < manager->config.zone_count; ++zone) {
+        if (!termo_manager_set_pwm_timer_compare(manager, zone, 0U)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 static inline bool termo_manager_start_update_timer(termo_manager_t* manager)
 {
     TERMO_ASSERT(manager != NULL);
@@ -225,6 +385,28 @@ static inline bool termo_manager_set_update_timer_period(
     return false;
 }
 
+// brings the next update to settle_time ms from now and keeps the period -
+// a period holds at least one conversion, so reads that start just after a
+// conversion keep finding fresh ones, if settle_time does not fit in the
+// period the update stays where it is
+static inline void termo_manager_align_update_timer(termo_manager_t* manager,
+                                                    float32_t update_time,
+                                                    uint32_t settle_time)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    uint32_t frequency = (uint32_t)(1.0F / update_time);
+    if (frequency == 0U || settle_time * frequency >= 1000U) {
+        return;
+    }
+
+    uint32_t period = __HAL_TIM_GET_AUTORELOAD(manager->config.update_timer);
+    uint32_t remaining = (uint32_t)((uint64_t)(period + 1U) * settle_time *
+                                    frequency / 1000U);
+
+    __HAL_TIM_SET_COUNTER(manager->config.update_timer, period - remaining);
+}
+
 static inline bool termo_manager_start_delta_timer(termo_manager_t* manager)
 {
     TERMO_ASSERT(manager != NULL);
@@ -243,9 +425,15 @@ static inline bool termo_manager_send_system_event(system_event_t const* event)
 {
     TERMO_ASSERT(event != NULL);
 
-    return xQueueSend(termo_queue_manager_get(TERMO_QUEUE_TYPE_SYSTEM),
-                      event,
-                      pdMS_TO_TICKS(10)) == pdPASS;
+    if (!termo_stats_queue_send(TERMO_QUEUE_TYPE_SYSTEM,
+                                event,
+                                pdMS_TO_TICKS(10))) {
+        return false;
+    }
+
+    return xTaskNotify(termo_task_manager_get(TERMO_TASK_TYPE_SYSTEM),
+                       SYSTEM_NOTIFY_EVENT,
+                       eSetBits) == pdPASS;
 }
 
 static inline bool termo_manager_receive_termo_notify(termo_notify_t* notify)
@@ -255,7 +443,7 @@ static inline bool termo_manager_receive_termo_notify(termo_notify_t* notify)
     return xTaskNotifyWait(0x00,
                            TERMO_NOTIFY_ALL,
                            (uint32_t*)notify,
-                           pdMS_TO_TICKS(10)) == pdPASS;
+                           portMAX_DELAY) == pdPASS;
 }
 
 static inline uint32_t termo_manager_control_temperature_to_compare(
@@ -269,7 +457,7 @@ static inline uint32_t termo_manager_control_temperature_to_compare(
             (float32_t)(manager->params.max_compare -
                         manager->params.min_compare) /
             (manager->params.max_temp - manager->params.min_temp) +
-        (float32_t)manager->params.max_compare;
+        (float32_t)manager->params.min_compare;
 
     if (compare < manager->params.min_compare) {
         compare = manager->params.min_compare;
@@ -281,6 +469,62 @@ static inline uint32_t termo_manager_control_temperature_to_compare(
     return (uint32_t)compare;
 }
 
+static inline uint32_t termo_manager_duty_to_compare(termo_manager_t* manager,
+                                                     float32_t duty)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    return (uint32_t)(manager->params.min_compare +
+                      duty * (manager->params.max_compare -
+                              manager->params.min_compare));
+}
+
+static inline float32_t termo_manager_compare_to_duty(termo_manager_t* manager,
+                                                      uint32_t compare)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    float32_t span = manager->params.max_compare - manager->params.min_compare;
+    if (span <= 0.0F) {
+        return 0.0F;
+    }
+
+    return ((float32_t)compare - manager->params.min_compare) / span;
+}
+
+// after a retune the output starts from where the relay left it, and the
+// difference to the engine output decays with the new integral time
+static inline void termo_manager_apply_bumpless_transfer(
+    termo_manager_t* manager,
+    uint32_t* compare)
+{
+    TERMO_ASSERT(manager != NULL);
+    TERMO_ASSERT(compare != NULL);
+
+    if (manager->has_bumpless_transfer) {
+        manager->bumpless_offset =
+            manager->bumpless_compare - (float32_t)*compare;
+        manager->has_bumpless_transfer = false;
+    }
+    if (manager->bumpless_offset == 0.0F) {
+        return;
+    }
+
+    float32_t shifted = (float32_t)*compare + manager->bumpless_offset;
+    if (shifted < manager->params.min_compare) {
+        shifted = manager->params.min_compare;
+    }
+    if (shifted > manager->params.max_compare) {
+        shifted = manager->params.max_compare;
+    }
+    *compare = (uint32_t)shifted;
+
+    manager->bumpless_offset *= manager->bumpless_decay;
+    if (fabsf(manager->bumpless_offset) < 1.0F) {
+        manager->bumpless_offset = 0.0F;
+    }
+}
+
 static inline bool termo_manager_has_termo_event(void)
 {
     return uxQueueMessagesWaiting(
@@ -293,25 +537,316 @@ static inline bool termo_manager_receive_termo_event(termo_event_t* event)
 
     return xQueueReceive(termo_queue_manager_get(TERMO_QUEUE_TYPE_TERMO),
                          event,
-                         pdMS_TO_TICKS(10)) == pdPASS;
+                         0U) == pdPASS;
 }
 
-static termo_err_t termo_manager_notify_delta_timer_handler(
-    termo_manager_t* manager)
+static inline bool termo_manager_get_control_compare(termo_manager_t* manager,
+                                                     float32_t error,
+                                                     uint32_t* compare)
 {
-    TERMO_LOG_FUNC(TAG);
     TERMO_ASSERT(manager != NULL);
+    TERMO_ASSERT(compare != NULL);
+
+    if (termo_manager_is_arm_pid_engine(manager->params.control_engine)) {
+        *compare = termo_arm_pid_get_compare(&manager->arm_pid, error);
+        return true;
+    }
 
     float32_t control_temperature = 0.0F;
-    float32_t error_temperature = manager->reference - manager->measurement;
     if (pid_regulator_get_sat_control(&manager->pid,
-                                      error_temperature,
+                                      error,
                                       manager->params.delta_time,
                                       &control_temperature) !=
         PID_REGULATOR_ERR_OK) {
-        termo_manager_set_pwm_timer_compare(manager, 0U);
+        return false;
+    }
+
+    *compare =
+        termo_manager_control_temperature_to_compare(manager,
+                                                     control_temperature);
+
+    return true;
+}
+
+static inline float32_t termo_manager_get_control_measurement(
+    termo_manager_t const* manager)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    return manager->estimator.has_estimate ? manager->estimator.estimate
+                                           : manager->measurement;
+}
+
+// leaves the error and the compare of every zone in the zone table
+static inline bool termo_manager_update_control(termo_manager_t* manager)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    termo_zones_t* zones = &manager->zones;
+
+    if (manager->autotune.state == TERMO_AUTOTUNE_STATE_RUNNING) {
+        zones->measurements[0] = termo_manager_get_control_measurement(manager);
+        zones->errors[0] =
+            manager->autotune.config.setpoint - zones->measurements[0];
+
+        float32_t duty = termo_autotune_step(&manager->autotune,
+                                             zones->measurements[0],
+                                             HAL_GetTick());
+        zones->compares[0] = termo_manager_duty_to_compare(manager, duty);
+
+        return true;
+    }
+
+    if (manager->params.control_engine != TERMO_CONTROL_ENGINE_ZONE_PID) {
+        zones->measurements[0] = termo_manager_get_control_measurement(manager);
+        zones->errors[0] = zones->references[0] - zones->measurements[0];
+
+        if (!termo_manager_get_control_compare(manager,
+                                               zones->errors[0],
+                                               &zones->compares[0])) {
+            return false;
+        }
+        termo_manager_apply_bumpless_transfer(manager, &zones->compares[0]);
+
+        return true;
+    }
+
+    // a zone whose sensor missed this update keeps its last measurement
+    for (uint32_t zone = 0U; zone < manager->config.zone_count; ++zone) {
+        uint32_t sensor = manager->config.zones[zone].sensor;
+        if (sensor < manager->config.mcp9808_count &&
+            (manager->temperature_valid & (1UL << sensor)) != 0UL) {
+            zones->measurements[zone] = manager->temperatures[sensor];
+        }
+    }
+    termo_zones_step(zones);
+
+    return true;
+}
+
+// builds the single loop engines from the gains in params
+static void termo_manager_initialize_control(termo_manager_t* manager)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    termo_params_t const* params = &manager->params;
+
+    if (pid_regulator_initialize(
+            &manager->pid,
+            &(pid_regulator_config_t){.prop_gain = params->kp,
+                                      .int_gain = params->ki,
+                                      .dot_gain = params->kd,
+                                      .min_control = params->min_temp,
+                                      .max_control = params->max_temp,
+                                      .sat_gain = params->kc,
+                                      .dead_error = 0.0F}) !=
+        PID_REGULATOR_ERR_OK) {
+        TERMO_LOG(TAG, "Failed pid_regulator_initialize!");
+    }
+
+    if (termo_manager_is_arm_pid_engine(params->control_engine) &&
+        !termo_arm_pid_initialize(
+            &manager->arm_pid,
+            &(termo_arm_pid_config_t){
+                .format = params->control_engine ==
+                                  TERMO_CONTROL_ENGINE_ARM_PID_Q31
+                              ? TERMO_ARM_PID_FORMAT_Q31
+                              : TERMO_ARM_PID_FORMAT_F32,
+                .kp = params->kp,
+                .ki = params->ki,
+                .kd = params->kd,
+                .kc = params->kc,
+                .delta_time = params->delta_time,
+                .min_control = params->min_temp,
+                .max_control = params->max_temp,
+                .min_compare = params->min_compare,
+                .max_compare = params->max_compare})) {
+        TERMO_LOG(TAG, "Failed termo_arm_pid_initialize!");
+        manager->params.control_engine = TERMO_CONTROL_ENGINE_PID_REGULATOR;
+    }
+}
+
+static inline void termo_manager_reset_autotune(termo_manager_t* manager)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    termo_autotune_cancel(&manager->autotune);
+    termo_step_cancel(&manager->step);
+    manager->is_awaiting_tuned_step = false;
+    manager->has_bumpless_transfer = false;
+    manager->bumpless_offset = 0.0F;
+}
+
+static inline termo_bus_step_metrics_t termo_manager_step_metrics(
+    termo_step_metrics_t const* metrics)
+{
+    TERMO_ASSERT(metrics != NULL);
+
+    return (termo_bus_step_metrics_t){.rise_time = metrics->rise_time,
+                                      .overshoot = metrics->overshoot,
+                                      .settling_time = metrics->settling_time,
+                                      .iae = metrics->iae};
+}
+
+static inline bool termo_manager_publish_autotune(termo_manager_t* manager)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    manager->autotune_report.timestamp = HAL_GetTick();
+
+    termo_bus_payload_t payload = {.autotune = manager->autotune_report};
+
+    return termo_bus_publish(TERMO_BUS_TOPIC_AUTOTUNE, &payload);
+}
+
+// retunes from the identified point, or keeps the old gains when the
+// experiment failed - either way the engine takes the output back and the
+// zone returns to its reference
+static termo_err_t termo_manager_finish_autotune(termo_manager_t* manager)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    termo_autotune_t* autotune = &manager->autotune;
+    termo_params_t* params = &manager->params;
+
+    manager->autotune_report = (termo_bus_payload_autotune_t){
+        .is_identified = false,
+        .rule = manager->tuning_rule,
+        .ultimate_gain = autotune->ultimate_gain,
+        .ultimate_period = autotune->ultimate_period,
+        .kp = params->kp,
+        .ki = params->ki,
+        .kd = params->kd,
+        .has_before = manager->has_step_metrics,
+        .before = termo_manager_step_metrics(&manager->step_metrics),
+        .has_after = false};
+
+    float32_t kp = 0.0F;
+    float32_t ki = 0.0F;
+    float32_t kd = 0.0F;
+    float32_t kc = 0.0F;
+    if (termo_autotune_get_gains(autotune,
+                                 manager->tuning_rule,
+                                 params->max_temp - params->min_temp,
+                                 params->delta_time,
+                                 &kp,
+                                 &ki,
+                                 &kd,
+                                 &kc)) {
+        params->kp = kp;
+        params->ki = ki;
+        params->kd = kd;
+        params->kc = kc;
+        termo_manager_initialize_control(manager);
+
+        manager->autotune_report.is_identified = true;
+        manager->autotune_report.kp = kp;
+        manager->autotune_report.ki = ki;
+        manager->autotune_report.kd = kd;
+
+        manager->bumpless_compare = (float32_t)termo_manager_duty_to_compare(
+            manager,
+            termo_autotune_get_mean_duty(autotune));
+        manager->bumpless_decay = expf(-params->delta_time * ki / kp);
+        manager->has_bumpless_transfer = true;
+
+        // the way back to the reference is the first step on the new gains
+        manager->is_awaiting_tuned_step = true;
+        termo_step_start(&manager->step,
+                         manager->zones.measurements[0],
+                         manager->zones.references[0],
+                         HAL_GetTick());
+
+        TERMO_LOG(TAG,
+                  "Ku: %.4f, Tu: %.2fs, Kp: %.4f, Ki: %.4f, Kd: %.4f, "
+                  "Kc: %.4f",
+                  autotune->ultimate_gain,
+                  autotune->ultimate_period,
+                  kp,
+                  ki,
+                  kd,
+                  kc);
+    } else {
+        TERMO_LOG(TAG, "Failed relay autotune, gains kept!");
+    }
+
+    termo_autotune_cancel(autotune);
+
+    if (!termo_manager_publish_autotune(manager)) {
+        return TERMO_ERR_FAIL;
+    }
+
+    return TERMO_ERR_OK;
+}
+
+static termo_err_t termo_manager_update_autotune(termo_manager_t* manager)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    if (manager->autotune.state == TERMO_AUTOTUNE_STATE_DONE ||
+        manager->autotune.state == TERMO_AUTOTUNE_STATE_FAILED) {
+        return termo_manager_finish_autotune(manager);
+    }
+
+    if (!termo_step_update(&manager->step,
+                           manager->zones.measurements[0],
+                           HAL_GetTick())) {
+        return TERMO_ERR_OK;
+    }
+
+    manager->step_metrics = manager->step.metrics;
+    manager->has_step_metrics = true;
+
+    TERMO_LOG(TAG,
+              "Rise: %.1fs, Overshoot: %.1f%%, Settling: %.1fs, IAE: %.2f",
+              manager->step_metrics.rise_time,
+              manager->step_metrics.overshoot,
+              manager->step_metrics.settling_time,
+              manager->step_metrics.iae);
+
+    if (!manager->is_awaiting_tuned_step) {
+        return TERMO_ERR_OK;
+    }
+
+    manager->is_awaiting_tuned_step = false;
+    manager->autotune_report.has_after = true;
+    manager->autotune_report.after =
+        termo_manager_step_metrics(&manager->step_metrics);
+    if (!termo_manager_publish_autotune(manager)) {
+        return TERMO_ERR_FAIL;
+    }
+
+    return TERMO_ERR_OK;
+}
+
+static termo_err_t termo_manager_notify_delta_timer_handler(
+    termo_manager_t* manager)
+{
+    TERMO_TRACE_FUNC();
+    TERMO_ASSERT(manager != NULL);
+
+    termo_zones_t const* zones = &manager->zones;
+
+    // the duty applied since the previous step carries the estimate to now
+    if (manager->params.estimation == TERMO_ESTIMATION_KALMAN) {
+        termo_estimator_predict(&manager->estimator, manager->duty);
+    }
+
+    bool has_control = termo_manager_update_control(manager);
+    for (uint32_t zone = 0U; has_control && zone < manager->config.zone_count;
+         ++zone) {
+        has_control =
+            termo_manager_set_pwm_timer_compare(manager,
+                                                zone,
+                                                zones->compares[zone]);
+    }
+
+    if (!has_control) {
+        termo_manager_clear_pwm_timer_compares(manager);
         termo_manager_stop_pwm_timer(manager);
         manager->has_fault = true;
+        // the estimate coasts unheated while the outputs are off
+        manager->duty = 0.0F;
 
         return TERMO_ERR_FAIL;
     } else {
@@ -321,81 +856,422 @@ static termo_err_t termo_manager_notify_delta_timer_handler(
         }
     }
 
-    uint32_t compare =
-        termo_manager_control_temperature_to_compare(manager,
-                                                     control_temperature);
+    float32_t error_temperature = zones->errors[0];
+    manager->duty = termo_manager_compare_to_duty(manager, zones->compares[0]);
+
+    termo_bus_payload_t payload = {
+        .control = {.error = error_temperature,
+                    .duty = 100.0F * manager->duty,
+                    .timestamp = HAL_GetTick(),
+                    .has_estimate = manager->estimator.has_estimate,
+                    .estimate = manager->estimator.estimate,
+                    .variance = manager->estimator.variance}};
+    if (!termo_bus_publish(TERMO_BUS_TOPIC_CONTROL, &payload)) {
+        return TERMO_ERR_FAIL;
+    }
 
-    if (!termo_manager_set_pwm_timer_compare(manager, compare)) {
-        termo_manager_set_pwm_timer_compare(manager, 0U);
-        termo_manager_stop_pwm_timer(manager);
-        manager->has_fault = true;
+    if (manager->has_reference_latency) {
+        termo_stats_set_reference_latency(HAL_GetTick() -
+                                          manager->reference_timestamp);
+        manager->has_reference_latency = false;
+    }
+
+    return termo_manager_update_autotune(manager);
+}
+
+// the period changes only once the sensors are claimed, so a rejected
+// update time leaves the timer as it was
+static termo_err_t termo_manager_set_update_time(termo_manager_t* manager,
+                                                 float32_t update_time)
+{
+    TERMO_TRACE_FUNC();
+    TERMO_LOG_FUNC(TAG);
+    TERMO_ASSERT(manager != NULL);
+
+    termo_manager_resolution_t const* resolution =
+        termo_manager_select_resolution(update_time);
+    if (resolution->resolution == manager->resolution) {
+        return termo_manager_set_update_timer_period(manager, update_time)
+                   ? TERMO_ERR_OK
+                   : TERMO_ERR_FAIL;
+    }
 
+    if (!termo_manager_claim_sensor(manager)) {
         return TERMO_ERR_FAIL;
-    } else {
-        if (manager->has_fault) {
-            termo_manager_start_pwm_timer(manager);
-            manager->has_fault = false;
+    }
+
+    if (!termo_manager_set_update_timer_period(manager, update_time)) {
+        termo_manager_release_sensor(manager);
+        return TERMO_ERR_FAIL;
+    }
+
+    uint32_t previous_conversion_time = manager->conversion_time;
+    mcp9808_err_t mcp9808_err = MCP9808_ERR_OK;
+    for (uint32_t index = 0U; index < manager->config.mcp9808_count; ++index) {
+        termo_sensor_t* sensor = &manager->sensors[index];
+        if (sensor->is_present &&
+            termo_manager_set_sensor_resolution(sensor,
+                                                resolution->resolution) !=
+                MCP9808_ERR_OK) {
+            mcp9808_err = MCP9808_ERR_FAIL;
         }
     }
+    if (mcp9808_err == MCP9808_ERR_OK) {
+        termo_manager_apply_resolution(manager, resolution);
+
+        // the conversion running now finishes with the previous resolution,
+        // the first read lands after the first conversion with the new one
+        termo_manager_align_update_timer(
+            manager,
+            update_time,
+            previous_conversion_time + resolution->conversion_time +
+                SENSOR_SAMPLE_SLACK);
+    }
+
+    termo_manager_release_sensor(manager);
+
+    if (mcp9808_err != MCP9808_ERR_OK) {
+        TERMO_LOG(TAG, "Failed termo_manager_set_sensor_resolution!");
+        return TERMO_ERR_FAIL;
+    }
 
     TERMO_LOG(TAG,
-              "Ref: %.2fC, Meas: %.2fC, Err: %.2fC, Ctrl: %.2fC, Comp: %lu",
-              manager->reference,
-              manager->measurement,
-              error_temperature,
-              control_temperature,
-              compare);
+              "resolution: %.4fC, conversion: %lu ms",
+              resolution->step,
+              resolution->conversion_time);
 
     return TERMO_ERR_OK;
 }
 
-static termo_err_t termo_manager_notify_update_timer_handler(
-    termo_manager_t* manager)
+static inline float32_t termo_manager_sample_to_temperature(uint16_t sample)
+{
+    // 13 bit two's complement in sixteenths of a degree, above the flag bits
+    int32_t raw = (int32_t)(sample & SENSOR_TEMP_MASK);
+    if ((raw & (int32_t)SENSOR_TEMP_SIGN) != 0) {
+        raw -= SENSOR_TEMP_RANGE;
+    }
+
+    return (float32_t)raw / SENSOR_TEMP_SCALE;
+}
+
+static inline bool termo_manager_fuse_measurement(
+    termo_manager_t const* manager,
+    float32_t const* temperatures,
+    uint32_t valid,
+    float32_t* measurement)
 {
-    TERMO_LOG_FUNC(TAG);
     TERMO_ASSERT(manager != NULL);
+    TERMO_ASSERT(temperatures != NULL);
+    TERMO_ASSERT(measurement != NULL);
+
+    if (manager->params.sensor_fusion == TERMO_SENSOR_FUSION_SINGLE) {
+        uint32_t index = manager->params.control_sensor;
+        if (index >= manager->config.mcp9808_count ||
+            (valid & (1UL << index)) == 0UL) {
+            return false;
+        }
+
+        *measurement = temperatures[index];
+        return true;
+    }
+
+    float32_t sum = 0.0F;
+    float32_t weight_sum = 0.0F;
+    float32_t max = 0.0F;
+    uint32_t count = 0U;
+
+    for (uint32_t index = 0U; index < manager->config.mcp9808_count; ++index) {
+        if ((valid & (1UL << index)) == 0UL) {
+            continue;
+        }
+
+        float32_t weight = manager->params.sensor_weights[index];
+        sum += manager->params.sensor_fusion == TERMO_SENSOR_FUSION_WEIGHTED
+                   ? weight * temperatures[index]
+                   : temperatures[index];
+        weight_sum += weight;
+        if (count == 0U || temperatures[index] > max) {
+            max = temperatures[index];
+        }
+        count++;
+    }
+
+    if (count == 0U) {
+        return false;
+    }
+
+    switch (manager->params.sensor_fusion) {
+        case TERMO_SENSOR_FUSION_MEAN: {
+            *measurement = sum / (float32_t)count;
+            return true;
+        }
+        case TERMO_SENSOR_FUSION_MAX: {
+            *measurement = max;
+            return true;
+        }
+        case TERMO_SENSOR_FUSION_WEIGHTED: {
+            if (weight_sum <= 0.0F) {
+                return false;
+            }
+            *measurement = sum / weight_sum;
+            return true;
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+// filters every valid sample in place, a sensor still inside a decimation
+// block has no new value for this update
+static inline uint32_t termo_manager_filter_temperatures(
+    termo_manager_t* manager,
+    float32_t* temperatures,
+    uint32_t valid)
+{
+    TERMO_ASSERT(manager != NULL);
+    TERMO_ASSERT(temperatures != NULL);
+
+    uint32_t filtered = 0UL;
+    for (uint32_t index = 0U; index < manager->config.mcp9808_count; ++index) {
+        if ((valid & (1UL << index)) != 0UL &&
+            termo_filter_process(&manager->sensors[index].filter,
+                                 temperatures[index],
+                                 &temperatures[index])) {
+            filtered |= 1UL << index;
+        }
+    }
+
+    return filtered;
+}
+
+static termo_err_t termo_manager_publish_measurement(
+    termo_manager_t* manager,
+    float32_t* temperatures,
+    uint32_t sampled)
+{
+    TERMO_ASSERT(manager != NULL);
+    TERMO_ASSERT(temperatures != NULL);
+
+    // the sensor converts continuously, reading again before it finished the
+    // next conversion returns the previous result
+    uint32_t timestamp = HAL_GetTick();
+    bool is_duplicate = timestamp - manager->sample_timestamp +
+                            SENSOR_SAMPLE_SLACK <
+                        manager->conversion_time;
+    if (!is_duplicate) {
+        manager->sample_timestamp = timestamp;
+    }
+    termo_stats_count_sensor_sample(is_duplicate);
+
+    // the estimator models the sensor, not the filters, so it is corrected
+    // by the raw samples - a repeated conversion carries no new information,
+    // rounding to the resolution step adds its uniform quantization variance
+    float32_t sample = 0.0F;
+    if (manager->params.estimation == TERMO_ESTIMATION_KALMAN &&
+        !is_duplicate &&
+        termo_manager_fuse_measurement(manager,
+                                       temperatures,
+                                       sampled,
+                                       &sample)) {
+        termo_estimator_correct(
+            &manager->estimator,
+            sample,
+            manager->params.measurement_noise +
+                manager->resolution_step * manager->resolution_step / 12.0F);
+    }
+
+    // a repeated conversion would be filtered twice, the last filtered
+    // values stand in for it instead
+    uint32_t valid = 0UL;
+    if (is_duplicate) {
+        valid = sampled & manager->temperature_valid;
+        memcpy(temperatures,
+               manager->temperatures,
+               sizeof(manager->temperatures));
+    } else {
+        valid =
+            termo_manager_filter_temperatures(manager, temperatures, sampled);
+    }
+    if (sampled != 0UL && valid == 0UL) {
+        return TERMO_ERR_OK;
+    }
+
+    memcpy(manager->temperatures, temperatures, sizeof(manager->temperatures));
+    manager->temperature_valid = valid;
 
     float32_t measurement = 0.0F;
-    if (mcp9808_get_temp_data_scaled(&manager->mcp9808, &measurement) !=
-        MCP9808_ERR_OK) {
-        TERMO_LOG(TAG, "Failed mcp9808_get_temp_data_scaled!");
+    if (!termo_manager_fuse_measurement(manager,
+                                        temperatures,
+                                        valid,
+                                        &measurement)) {
+        TERMO_LOG(TAG, "No valid sensor to control from!");
         return TERMO_ERR_FAIL;
     }
 
     manager->measurement = measurement;
 
-    system_event_t event = {
-        .origin = SYSTEM_EVENT_ORIGIN_TERMO,
-        .type = SYSTEM_EVENT_TYPE_TERMO_MEASURE,
-        .payload.termo_measure = {.temperature = measurement,
-                                  .humidity = 0.0F,
-                                  .pressure = 0.0F}};
-    if (!termo_manager_send_system_event(&event)) {
+    termo_bus_payload_t payload = {
+        .measure = {.temperature = measurement,
+                    .humidity = 0.0F,
+                    .pressure = 0.0F,
+                    .timestamp = timestamp,
+                    .is_duplicate = is_duplicate,
+                    .sensor_count = manager->config.mcp9808_count,
+                    .sensor_valid = valid}};
+    memcpy(payload.measure.sensors,
+           temperatures,
+           sizeof(payload.measure.sensors));
+
+    if (!termo_bus_publish(TERMO_BUS_TOPIC_MEASURE, &payload)) {
+        return TERMO_ERR_FAIL;
+    }
+
+    return TERMO_ERR_OK;
+}
+
+static termo_err_t termo_manager_notify_update_timer_handler(
+    termo_manager_t* manager)
+{
+    TERMO_TRACE_FUNC();
+    TERMO_ASSERT(manager != NULL);
+
+    float32_t temperatures[TERMO_SENSOR_NUM] = {};
+    uint32_t valid = 0UL;
+
+    for (uint32_t index = 0U; index < manager->config.mcp9808_count; ++index) {
+        termo_sensor_t* sensor = &manager->sensors[index];
+        if (!sensor->is_present) {
+            continue;
+        }
+
+        if (mcp9808_get_temp_data_scaled(&sensor->mcp9808,
+                                         &temperatures[index]) !=
+            MCP9808_ERR_OK) {
+            termo_stats_count_sensor_error();
+            TERMO_LOG(TAG, "Failed mcp9808_get_temp_data_scaled %lu!", index);
+            continue;
+        }
+        valid |= 1UL << index;
+    }
+
+    return termo_manager_publish_measurement(manager, temperatures, valid);
+}
+
+static termo_err_t termo_manager_notify_sensor_done_handler(
+    termo_manager_t* manager)
+{
+    TERMO_TRACE_FUNC();
+    TERMO_ASSERT(manager != NULL);
+
+    float32_t temperatures[TERMO_SENSOR_NUM] = {};
+    uint32_t valid = manager->sensor_valid;
+    uint32_t failed = manager->sensor_failed;
+
+    for (uint32_t index = 0U; index < manager->config.mcp9808_count; ++index) {
+        if ((failed & (1UL << index)) != 0UL) {
+            termo_stats_count_sensor_error();
+        }
+        if ((valid & (1UL << index)) != 0UL) {
+            temperatures[index] =
+                termo_manager_sample_to_temperature(
+                    manager->sensors[index].sample);
+        }
+    }
+
+    return termo_manager_publish_measurement(manager, temperatures, valid);
+}
+
+static termo_err_t termo_manager_notify_sensor_fault_handler(
+    termo_manager_t* manager,
+    termo_notify_t notify)
+{
+    TERMO_TRACE_FUNC();
+    TERMO_LOG_FUNC(TAG);
+    TERMO_ASSERT(manager != NULL);
+
+    if ((notify & TERMO_NOTIFY_SENSOR_ERROR) == TERMO_NOTIFY_SENSOR_ERROR) {
+        termo_stats_count_sensor_error();
+    }
+    if ((notify & TERMO_NOTIFY_SENSOR_TIMEOUT) ==
+        TERMO_NOTIFY_SENSOR_TIMEOUT) {
+        termo_stats_count_sensor_timeout();
+    }
+
+    // reinitializing aborts a stuck transfer, no new one starts until the
+    // pending flag is cleared
+    if (HAL_I2C_DeInit(manager->config.mcp9808_i2c_bus) != HAL_OK ||
+        HAL_I2C_Init(manager->config.mcp9808_i2c_bus) != HAL_OK) {
+        TERMO_LOG(TAG, "Failed mcp9808 bus recovery!");
         return TERMO_ERR_FAIL;
     }
 
+    atomic_store(&manager->is_sensor_pending, false);
+
     return TERMO_ERR_OK;
 }
 
+static inline void termo_manager_keep_first_err(termo_err_t* first_err,
+                                                termo_err_t err)
+{
+    if (*first_err == TERMO_ERR_OK) {
+        *first_err = err;
+    }
+}
+
+// the fault recovers the bus before anything reads it again, every bit is
+// handled even if an earlier one failed, the first error is returned
 static termo_err_t termo_manager_notify_handler(termo_manager_t* manager,
                                                 termo_notify_t notify)
 {
+    TERMO_TRACE_FUNC();
     TERMO_ASSERT(manager != NULL);
 
+    termo_err_t notify_err = TERMO_ERR_OK;
+
+    if ((notify & (TERMO_NOTIFY_SENSOR_ERROR | TERMO_NOTIFY_SENSOR_TIMEOUT)) !=
+        0) {
+        termo_manager_keep_first_err(
+            &notify_err,
+            termo_manager_notify_sensor_fault_handler(manager, notify));
+    }
     if ((notify & TERMO_NOTIFY_UPDATE_TIMER) == TERMO_NOTIFY_UPDATE_TIMER) {
-        TERMO_RET_ON_ERR(termo_manager_notify_update_timer_handler(manager));
+        termo_manager_keep_first_err(
+            &notify_err,
+            termo_manager_notify_update_timer_handler(manager));
+    }
+    if ((notify & TERMO_NOTIFY_SENSOR_DONE) == TERMO_NOTIFY_SENSOR_DONE) {
+        termo_manager_keep_first_err(
+            &notify_err,
+            termo_manager_notify_sensor_done_handler(manager));
     }
     if ((notify & TERMO_NOTIFY_DELTA_TIMER) == TERMO_NOTIFY_DELTA_TIMER) {
-        TERMO_RET_ON_ERR(termo_manager_notify_delta_timer_handler(manager));
+        termo_manager_keep_first_err(
+            &notify_err,
+            termo_manager_notify_delta_timer_handler(manager));
     }
 
-    return TERMO_ERR_OK;
+    return notify_err;
+}
+
+// undoes a start that failed half way, the STOP2 lock included
+static inline void termo_manager_abort_start(termo_manager_t* manager)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    termo_manager_stop_delta_timer(manager);
+    termo_manager_stop_update_timer(manager);
+    termo_manager_clear_pwm_timer_compares(manager);
+    termo_manager_stop_pwm_timer(manager);
+
+    termo_power_unlock_stop();
 }
 
 static termo_err_t termo_manager_event_start_handler(
     termo_manager_t* manager,
     termo_event_payload_start_t const* start)
 {
+    TERMO_TRACE_FUNC();
     TERMO_LOG_FUNC(TAG);
     TERMO_ASSERT(manager != NULL);
     TERMO_ASSERT(start != NULL);
@@ -404,19 +1280,36 @@ static termo_err_t termo_manager_event_start_handler(
         return TERMO_ERR_ALREADY_RUNNING;
     }
 
+    termo_power_lock_stop();
+
+    if (termo_manager_is_arm_pid_engine(manager->params.control_engine)) {
+        termo_arm_pid_reset(&manager->arm_pid);
+    }
+    termo_zones_reset(&manager->zones);
+    termo_estimator_reset(&manager->estimator);
+    manager->duty = 0.0F;
+    for (uint32_t index = 0U; index < manager->config.mcp9808_count; ++index) {
+        termo_filter_reset(&manager->sensors[index].filter);
+    }
+    termo_manager_reset_autotune(manager);
+
     if (!termo_manager_start_delta_timer(manager)) {
+        termo_manager_abort_start(manager);
         return TERMO_ERR_FAIL;
     }
 
     if (!termo_manager_start_update_timer(manager)) {
+        termo_manager_abort_start(manager);
         return TERMO_ERR_FAIL;
     }
 
-    if (!termo_manager_set_pwm_timer_compare(manager, 0U)) {
+    if (!termo_manager_clear_pwm_timer_compares(manager)) {
+        termo_manager_abort_start(manager);
         return TERMO_ERR_FAIL;
     }
 
     if (!termo_manager_start_pwm_timer(manager)) {
+        termo_manager_abort_start(manager);
         return TERMO_ERR_FAIL;
     }
 
@@ -424,6 +1317,7 @@ static termo_err_t termo_manager_event_start_handler(
                             .type = SYSTEM_EVENT_TYPE_TERMO_STARTED,
                             .payload.termo_started = {}};
     if (!termo_manager_send_system_event(&event)) {
+        termo_manager_abort_start(manager);
         return TERMO_ERR_FAIL;
     }
 
@@ -436,6 +1330,7 @@ static termo_err_t termo_manager_event_stop_handler(
     termo_manager_t* manager,
     termo_event_payload_stop_t const* stop)
 {
+    TERMO_TRACE_FUNC();
     TERMO_LOG_FUNC(TAG);
     TERMO_ASSERT(manager != NULL);
     TERMO_ASSERT(stop != NULL);
@@ -444,6 +1339,8 @@ static termo_err_t termo_manager_event_stop_handler(
         return TERMO_ERR_NOT_RUNNING;
     }
 
+    termo_manager_reset_autotune(manager);
+
     if (!termo_manager_stop_delta_timer(manager)) {
         return TERMO_ERR_FAIL;
     }
@@ -452,7 +1349,7 @@ static termo_err_t termo_manager_event_stop_handler(
         return TERMO_ERR_FAIL;
     }
 
-    if (!termo_manager_set_pwm_timer_compare(manager, 0U)) {
+    if (!termo_manager_clear_pwm_timer_compares(manager)) {
         return TERMO_ERR_FAIL;
     }
 
@@ -467,28 +1364,109 @@ static termo_err_t termo_manager_event_stop_handler(
         return TERMO_ERR_FAIL;
     }
 
+    termo_power_unlock_stop();
     manager->is_running = false;
 
     return TERMO_ERR_OK;
 }
 
-static termo_err_t termo_manager_event_reference_handler(
+static termo_err_t termo_manager_event_autotune_handler(
     termo_manager_t* manager,
-    termo_event_payload_reference_t const* reference)
+    termo_event_payload_autotune_t const* autotune)
 {
+    TERMO_TRACE_FUNC();
     TERMO_LOG_FUNC(TAG);
     TERMO_ASSERT(manager != NULL);
+    TERMO_ASSERT(autotune != NULL);
+
+    if (!manager->is_running) {
+        return TERMO_ERR_NOT_RUNNING;
+    }
+
+    if (manager->autotune.state == TERMO_AUTOTUNE_STATE_RUNNING) {
+        return TERMO_ERR_ALREADY_RUNNING;
+    }
+
+    if (manager->params.control_engine == TERMO_CONTROL_ENGINE_ZONE_PID) {
+        TERMO_LOG(TAG, "No autotune for the zone engine!");
+        return TERMO_ERR_FAIL;
+    }
+
+    if (autotune->rule >= TERMO_TUNING_RULE_NUM) {
+        TERMO_LOG(TAG, "Unknown tuning rule %lu!", autotune->rule);
+        return TERMO_ERR_FAIL;
+    }
+
+    if (autotune->setpoint < manager->params.min_temp ||
+        autotune->setpoint > manager->params.max_temp) {
+        TERMO_LOG(TAG,
+                  "Autotune setpoint %.2f out of range!",
+                  autotune->setpoint);
+        return TERMO_ERR_FAIL;
+    }
+
+    termo_manager_reset_autotune(manager);
+
+    if (!termo_autotune_start(
+            &manager->autotune,
+            &(termo_autotune_config_t){
+                .setpoint = autotune->setpoint,
+                .bias = AUTOTUNE_BIAS,
+                .amplitude = autotune->amplitude > 0.0F
+                                 ? autotune->amplitude
+                                 : AUTOTUNE_AMPLITUDE,
+                .hysteresis = AUTOTUNE_HYSTERESIS * manager->resolution_step,
+                .cycles = AUTOTUNE_CYCLES,
+                .timeout = AUTOTUNE_TIMEOUT},
+            HAL_GetTick())) {
+        TERMO_LOG(TAG, "Failed termo_autotune_start!");
+        return TERMO_ERR_FAIL;
+    }
+
+    manager->tuning_rule = (termo_tuning_rule_t)autotune->rule;
+
+    return TERMO_ERR_OK;
+}
+
+static termo_err_t termo_manager_bus_reference_handler(
+    termo_manager_t* manager,
+    termo_bus_payload_reference_t const* reference)
+{
+    TERMO_TRACE_FUNC();
+    TERMO_ASSERT(manager != NULL);
     TERMO_ASSERT(reference != NULL);
 
+    if (!manager->is_running) {
+        return TERMO_ERR_NOT_RUNNING;
+    }
+
+    if (reference->zone >= manager->config.zone_count) {
+        TERMO_LOG(TAG, "Unknown zone %lu!", reference->zone);
+        return TERMO_ERR_FAIL;
+    }
+
+    // the update timer restarts from zero, a new resolution pulls the first
+    // read in to just after its first conversion
     if (manager->update_time != reference->update_time) {
-        if (!termo_manager_set_update_timer_period(manager,
-                                                   reference->update_time)) {
-            return TERMO_ERR_FAIL;
-        }
+        TERMO_RET_ON_ERR(
+            termo_manager_set_update_time(manager, reference->update_time));
+    }
+
+    // the relay owns the first zone until it finishes and starts the step
+    // back to the reference itself
+    if (reference->zone == 0U &&
+        manager->autotune.state != TERMO_AUTOTUNE_STATE_RUNNING &&
+        reference->temperature != manager->zones.references[0]) {
+        termo_step_start(&manager->step,
+                         manager->zones.measurements[0],
+                         reference->temperature,
+                         HAL_GetTick());
     }
 
     manager->update_time = reference->update_time;
-    manager->reference = reference->temperature;
+    manager->zones.references[reference->zone] = reference->temperature;
+    manager->reference_timestamp = reference->timestamp;
+    manager->has_reference_latency = true;
 
     return TERMO_ERR_OK;
 }
@@ -496,6 +1474,7 @@ static termo_err_t termo_manager_event_reference_handler(
 static termo_err_t termo_manager_event_handler(termo_manager_t* manager,
                                                termo_event_t const* event)
 {
+    TERMO_TRACE_FUNC();
     TERMO_ASSERT(manager != NULL);
     TERMO_ASSERT(event != NULL);
 
@@ -508,10 +1487,29 @@ static termo_err_t termo_manager_event_handler(termo_manager_t* manager,
             return termo_manager_event_stop_handler(manager,
                                                     &event->payload.stop);
         }
-        case TERMO_EVENT_TYPE_REFERENCE: {
-            return termo_manager_event_reference_handler(
+        case TERMO_EVENT_TYPE_AUTOTUNE: {
+            return termo_manager_event_autotune_handler(
                 manager,
-                &event->payload.reference);
+                &event->payload.autotune);
+        }
+        default: {
+            return TERMO_ERR_UNKNOWN_EVENT;
+        }
+    }
+}
+
+static termo_err_t termo_manager_bus_handler(termo_manager_t* manager,
+                                             termo_bus_message_t const* message)
+{
+    TERMO_TRACE_FUNC();
+    TERMO_ASSERT(manager != NULL);
+    TERMO_ASSERT(message != NULL);
+
+    switch (message->topic) {
+        case TERMO_BUS_TOPIC_REFERENCE: {
+            return termo_manager_bus_reference_handler(
+                manager,
+                &message->payload.reference);
         }
         default: {
             return TERMO_ERR_UNKNOWN_EVENT;
@@ -524,7 +1522,10 @@ termo_err_t termo_manager_process(termo_manager_t* manager)
     TERMO_ASSERT(manager != NULL);
 
     termo_notify_t notify;
-    if (termo_manager_receive_termo_notify(&notify)) {
+    bool has_notify = termo_manager_receive_termo_notify(&notify);
+
+    TERMO_TRACE_FUNC();
+    if (has_notify) {
         TERMO_RET_ON_ERR(termo_manager_notify_handler(manager, notify));
     }
 
@@ -535,6 +1536,13 @@ termo_err_t termo_manager_process(termo_manager_t* manager)
         }
     }
 
+    termo_bus_message_t const* message;
+    while ((message = termo_bus_receive(TERMO_BUS_SUBSCRIBER_TERMO)) != NULL) {
+        termo_err_t message_err = termo_manager_bus_handler(manager, message);
+        termo_bus_release(message);
+        TERMO_RET_ON_ERR(message_err);
+    }
+
     return TERMO_ERR_OK;
 }
 
@@ -550,40 +1558,122 @@ termo_err_t termo_manager_initialize(termo_manager_t* manager,
     manager->has_fault = false;
 
     manager->update_time = 0.0F;
-    manager->reference = 0.0F;
     manager->measurement = 0.0F;
+    memset(manager->temperatures, 0, sizeof(manager->temperatures));
+    manager->temperature_valid = 0UL;
+    memset(&manager->zones, 0, sizeof(manager->zones));
+    memset(&manager->estimator, 0, sizeof(manager->estimator));
+    manager->duty = 0.0F;
+
+    memset(&manager->autotune, 0, sizeof(manager->autotune));
+    manager->tuning_rule = TERMO_TUNING_RULE_ZIEGLER_NICHOLS;
+    memset(&manager->step, 0, sizeof(manager->step));
+    manager->has_step_metrics = false;
+    memset(&manager->autotune_report, 0, sizeof(manager->autotune_report));
+    termo_manager_reset_autotune(manager);
+
+    manager->has_reference_latency = false;
+    manager->reference_timestamp = 0U;
+
+    atomic_init(&manager->is_sensor_pending, false);
+    atomic_init(&manager->is_sensor_claimed, false);
+    manager->sensor_index = 0U;
+    manager->sensor_valid = 0UL;
+    manager->sensor_failed = 0UL;
 
     manager->config = *config;
     manager->params = *params;
 
-    if (mcp9808_initialize(
-            &manager->mcp9808,
-            &(mcp9808_config_t){.scale = mcp9808_resolution_to_scale(0x03)},
-            &(mcp9808_interface_t){
-                .bus_user = &manager->config,
-                .bus_initialize = mcp9808_bus_initialize,
-                .bus_deinitialize = mcp9808_bus_deinitialize,
-                .bus_read_data = mcp9808_bus_read_data,
-                .bus_write_data = mcp9808_bus_write_data,
-            }) != MCP9808_ERR_OK) {
-        TERMO_LOG(TAG, "Failed mcp9808_initialize!");
+    if (manager->config.mcp9808_count > TERMO_SENSOR_NUM) {
+        manager->config.mcp9808_count = TERMO_SENSOR_NUM;
+    }
+    if (manager->config.zone_count > TERMO_ZONES_NUM) {
+        manager->config.zone_count = TERMO_ZONES_NUM;
+    }
+
+    // finest resolution until a reference sets the update time
+    termo_manager_resolution_t const* resolution =
+        &termo_manager_resolutions[TERMO_ARRAY_SIZE(termo_manager_resolutions) -
+                                   1UL];
+
+    // a missing sensor is left out of every burst instead of failing the rest
+    for (uint32_t index = 0U; index < manager->config.mcp9808_count; ++index) {
+        termo_sensor_t* sensor = &manager->sensors[index];
+
+        sensor->i2c_bus = manager->config.mcp9808_i2c_bus;
+        sensor->i2c_address = manager->config.mcp9808_i2c_addresses[index];
+        sensor->is_present = false;
+        sensor->sample = 0U;
+
+        if (!termo_filter_initialize(&sensor->filter,
+                                     &params->sensor_filters[index])) {
+            TERMO_LOG(TAG, "Failed termo_filter_initialize %lu!", index);
+            termo_filter_initialize(&sensor->filter,
+                                    &(termo_filter_config_t){});
+        }
+
+        if (mcp9808_initialize(
+                &sensor->mcp9808,
+                &(mcp9808_config_t){.scale = mcp9808_resolution_to_scale(
+                                        resolution->resolution)},
+                &(mcp9808_interface_t){
+                    .bus_user = sensor,
+                    .bus_initialize = mcp9808_bus_initialize,
+                    .bus_deinitialize = mcp9808_bus_deinitialize,
+                    .bus_read_data = mcp9808_bus_read_data,
+                    .bus_write_data = mcp9808_bus_write_data,
+                }) != MCP9808_ERR_OK) {
+            TERMO_LOG(TAG, "Failed mcp9808_initialize %lu!", index);
+            continue;
+        }
+
+        if (mcp9808_initialize_chip(&sensor->mcp9808,
+                                    resolution->resolution) !=
+            MCP9808_ERR_OK) {
+            TERMO_LOG(TAG, "Failed mcp9808_initialize_chip %lu!", index);
+            continue;
+        }
+
+        sensor->is_present = true;
+    }
+    termo_manager_apply_resolution(manager, resolution);
+
+    termo_manager_initialize_control(manager);
+
+    termo_zones_config_t zones_config = {.count = manager->config.zone_count,
+                                         .delta_time = params->delta_time,
+                                         .min_control = params->min_temp,
+                                         .max_control = params->max_temp,
+                                         .min_compare = params->min_compare,
+                                         .max_compare = params->max_compare};
+    memcpy(zones_config.kp, params->zone_kp, sizeof(zones_config.kp));
+    memcpy(zones_config.ki, params->zone_ki, sizeof(zones_config.ki));
+    memcpy(zones_config.kd, params->zone_kd, sizeof(zones_config.kd));
+    memcpy(zones_config.kc, params->zone_kc, sizeof(zones_config.kc));
+
+    if (params->control_engine == TERMO_CONTROL_ENGINE_ZONE_PID &&
+        !termo_zones_initialize(&manager->zones, &zones_config)) {
+        TERMO_LOG(TAG, "Failed termo_zones_initialize!");
+        manager->params.control_engine = TERMO_CONTROL_ENGINE_PID_REGULATOR;
     }
 
-    if (mcp9808_initialize_chip(&manager->mcp9808) != MCP9808_ERR_OK) {
-        TERMO_LOG(TAG, "Failed mcp9808_initialize_chip!");
+    if (params->estimation == TERMO_ESTIMATION_KALMAN &&
+        !termo_estimator_initialize(
+            &manager->estimator,
+            &(termo_estimator_config_t){
+                .time_constant = params->model_time_constant,
+                .gain = params->model_gain,
+                .ambient = params->model_ambient,
+                .process_noise = params->process_noise,
+                .delta_time = params->delta_time})) {
+        TERMO_LOG(TAG, "Failed termo_estimator_initialize!");
+        manager->params.estimation = TERMO_ESTIMATION_NONE;
     }
 
-    if (pid_regulator_initialize(
-            &manager->pid,
-            &(pid_regulator_config_t){.prop_gain = params->kp,
-                                      .int_gain = params->ki,
-                                      .dot_gain = params->kd,
-                                      .min_control = params->min_temp,
-                                      .max_control = params->max_temp,
-                                      .sat_gain = params->kc,
-                                      .dead_error = 0.0F}) !=
-        PID_REGULATOR_ERR_OK) {
-        TERMO_LOG(TAG, "Failed pid_regulator_initialize!");
+    // the single loop engines drive only the first zone
+    if (manager->params.control_engine != TERMO_CONTROL_ENGINE_ZONE_PID &&
+        manager->config.zone_count > 1U) {
+        manager->config.zone_count = 1U;
     }
 
     system_event_t event = {.origin = SYSTEM_EVENT_ORIGIN_TERMO,
@@ -595,3 +1685,105 @@ termo_err_t termo_manager_initialize(termo_manager_t* manager,
 
     return TERMO_ERR_OK;
 }
+
+// starts the read of the next present sensor, or ends the burst
+static termo_notify_t termo_manager_sensor_burst_isr(termo_manager_t* manager)
+{
+    while (manager->sensor_index < manager->config.mcp9808_count) {
+        termo_sensor_t* sensor = &manager->sensors[manager->sensor_index];
+        if (!sensor->is_present) {
+            manager->sensor_index++;
+            continue;
+        }
+
+        // the pending flag stays set so the task recovers the bus first
+        if (HAL_I2C_Mem_Read_IT(sensor->i2c_bus,
+                                sensor->i2c_address << 1U,
+                                SENSOR_TEMP_REGISTER,
+                                I2C_MEMADD_SIZE_8BIT,
+                                sensor->buffer,
+                                sizeof(sensor->buffer)) != HAL_OK) {
+            return TERMO_NOTIFY_SENSOR_ERROR;
+        }
+
+        return 0;
+    }
+
+    atomic_store(&manager->is_sensor_pending, false);
+
+    return TERMO_NOTIFY_SENSOR_DONE;
+}
+
+termo_notify_t termo_manager_update_timer_isr(termo_manager_t* manager)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    if (manager->config.sensor_read != TERMO_SENSOR_READ_ASYNC) {
+        return TERMO_NOTIFY_UPDATE_TIMER;
+    }
+
+    // the task holds the bus for a blocking write, this period is skipped
+    if (atomic_load(&manager->is_sensor_claimed)) {
+        return 0;
+    }
+
+    // still set from the previous period - either the burst is overdue or
+    // a fault is waiting for the task to recover the bus
+    if (atomic_exchange(&manager->is_sensor_pending, true)) {
+        return TERMO_NOTIFY_SENSOR_TIMEOUT;
+    }
+
+    manager->sensor_index = 0U;
+    manager->sensor_valid = 0UL;
+    manager->sensor_failed = 0UL;
+
+    return termo_manager_sensor_burst_isr(manager);
+}
+
+termo_notify_t termo_manager_sensor_done_isr(termo_manager_t* manager)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    uint32_t index = manager->sensor_index;
+    if (index >= manager->config.mcp9808_count) {
+        return 0;
+    }
+
+    termo_sensor_t* sensor = &manager->sensors[index];
+    sensor->sample =
+        (uint16_t)(((uint16_t)sensor->buffer[0] << 8U) | sensor->buffer[1]);
+    manager->sensor_valid |= 1UL << index;
+    manager->sensor_index = index + 1U;
+
+    return termo_manager_sensor_burst_isr(manager);
+}
+
+// a sensor that did not answer stays invalid for this burst while the rest
+// are still read, only a transfer that cannot start needs the bus recovered
+termo_notify_t termo_manager_sensor_error_isr(termo_manager_t* manager)
+{
+    TERMO_ASSERT(manager != NULL);
+
+    uint32_t index = manager->sensor_index;
+    if (index >= manager->config.mcp9808_count) {
+        return TERMO_NOTIFY_SENSOR_ERROR;
+    }
+
+    manager->sensor_failed |= 1UL << index;
+    manager->sensor_index = index + 1U;
+
+    return termo_manager_sensor_burst_isr(manager);
+}
+
+#undef SENSOR_TEMP_REGISTER
+#undef SENSOR_TEMP_MASK
+#undef SENSOR_TEMP_SIGN
+#undef SENSOR_TEMP_RANGE
+#undef SENSOR_TEMP_SCALE
+#undef SENSOR_SAMPLE_SLACK
+#undef SENSOR_IDLE_RETRIES
+#undef AUTOTUNE_BIAS
+#undef AUTOTUNE_AMPLITUDE
+#undef AUTOTUNE_HYSTERESIS
+#undef AUTOTUNE_CYCLES
+#undef AUTOTUNE_TIMEOUT
@@ -5,41 +5,153 @@
 #include "pid_regulator.h"
 #include "stm32l476xx.h"
 #include "stm32l4xx_hal.h"
+#include "termo_arm_pid.h"
+#include "termo_autotune.h"
 #include "termo_common.h"
+#include "termo_estimator.h"
+#include "termo_filter.h"
+#include "termo_step.h"
+#include "termo_zones.h"
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stdint.h>
 
+typedef enum {
+    TERMO_SENSOR_READ_BLOCKING,
+    TERMO_SENSOR_READ_ASYNC,
+} termo_sensor_read_t;
+
+// how the controlled temperature is derived from the valid sensors
+typedef enum {
+    TERMO_SENSOR_FUSION_SINGLE,
+    TERMO_SENSOR_FUSION_MEAN,
+    TERMO_SENSOR_FUSION_MAX,
+    TERMO_SENSOR_FUSION_WEIGHTED,
+} termo_sensor_fusion_t;
+
+// a zone is heated by its own pwm channel from the reading of one sensor
+typedef struct {
+    TIM_HandleTypeDef* pwm_timer;
+    uint16_t pwm_channel;
+    uint32_t sensor;
+} termo_zone_io_t;
+
 typedef struct {
+    termo_sensor_read_t sensor_read;
     I2C_HandleTypeDef* mcp9808_i2c_bus;
-    uint16_t mcp9808_i2c_address;
+    uint16_t mcp9808_i2c_addresses[TERMO_SENSOR_NUM];
+    uint32_t mcp9808_count;
     TIM_HandleTypeDef* delta_timer;
     TIM_HandleTypeDef* update_timer;
-    TIM_HandleTypeDef* pwm_timer;
-    uint16_t pwm_channel;
+    termo_zone_io_t zones[TERMO_ZONES_NUM];
+    uint32_t zone_count;
 } termo_config_t;
 
+typedef enum {
+    TERMO_CONTROL_ENGINE_PID_REGULATOR,
+    TERMO_CONTROL_ENGINE_ARM_PID_F32,
+    TERMO_CONTROL_ENGINE_ARM_PID_Q31,
+    TERMO_CONTROL_ENGINE_ZONE_PID,
+} termo_control_engine_t;
+
+// what the single loop engines control from - the latest sample, or a model
+// estimate predicted every delta time and corrected by every sample
+typedef enum {
+    TERMO_ESTIMATION_NONE,
+    TERMO_ESTIMATION_KALMAN,
+} termo_estimation_t;
+
 typedef struct {
+    termo_control_engine_t control_engine;
     float32_t kp;
     float32_t ki;
     float32_t kd;
     float32_t kc;
+    // the zone engine steps every zone on its own gains instead
+    float32_t zone_kp[TERMO_ZONES_NUM];
+    float32_t zone_ki[TERMO_ZONES_NUM];
+    float32_t zone_kd[TERMO_ZONES_NUM];
+    float32_t zone_kc[TERMO_ZONES_NUM];
     float32_t min_temp;
     float32_t max_temp;
     float32_t min_compare;
     float32_t max_compare;
     float32_t delta_time;
+    termo_sensor_fusion_t sensor_fusion;
+    uint32_t control_sensor;
+    float32_t sensor_weights[TERMO_SENSOR_NUM];
+    termo_filter_config_t sensor_filters[TERMO_SENSOR_NUM];
+    termo_estimation_t estimation;
+    float32_t model_time_constant;
+    float32_t model_gain;
+    float32_t model_ambient;
+    float32_t process_noise;
+    float32_t measurement_noise;
 } termo_params_t;
 
+typedef struct {
+    I2C_HandleTypeDef* i2c_bus;
+    uint16_t i2c_address;
+    bool is_present;
+
+    uint8_t buffer[2];
+    uint16_t volatile sample;
+
+    termo_filter_t filter;
+    mcp9808_t mcp9808;
+} termo_sensor_t;
+
 typedef struct {
     bool is_running;
     bool has_fault;
 
-    float32_t reference;
+    // the other engines control only the first zone, from the fused
+    // measurement, the zone engine steps every zone from its own sensor
     float32_t measurement;
+    float32_t temperatures[TERMO_SENSOR_NUM];
+    uint32_t temperature_valid;
     float32_t update_time;
 
-    mcp9808_t mcp9808;
+    bool has_reference_latency;
+    uint32_t reference_timestamp;
+
+    mcp9808_resolution_t resolution;
+    float32_t resolution_step;
+    uint32_t conversion_time;
+    uint32_t sample_timestamp;
+
+    // one burst reads every present sensor back to back, with a bit per
+    // sensor in sensor_valid or sensor_failed once its read finished, none
+    // starts while the task has claimed the bus
+    atomic_bool is_sensor_pending;
+    atomic_bool is_sensor_claimed;
+    uint32_t volatile sensor_index;
+    uint32_t volatile sensor_valid;
+    uint32_t volatile sensor_failed;
+
+    termo_sensor_t sensors[TERMO_SENSOR_NUM];
     pid_regulator_t pid;
+    termo_arm_pid_t arm_pid;
+    termo_zones_t zones;
+    termo_estimator_t estimator;
+    float32_t duty;
+
+    // the relay experiment drives the first zone in place of the engine,
+    // the step tracker follows every reference step of the first zone
+    termo_autotune_t autotune;
+    termo_tuning_rule_t tuning_rule;
+    termo_step_t step;
+    bool has_step_metrics;
+    termo_step_metrics_t step_metrics;
+    bool is_awaiting_tuned_step;
+    termo_bus_payload_autotune_t autotune_report;
+
+    // compare offset from the relay output to the retuned engine output
+    bool has_bumpless_transfer;
+    float32_t bumpless_compare;
+    float32_t bumpless_offset;
+    float32_t bumpless_decay;
+
     termo_config_t config;
     termo_params_t params;
 } termo_manager_t;
@@ -49,4 +161,9 @@ termo_err_t termo_manager_initialize(termo_manager_t* manager,
                                      termo_config_t const* config,
                                      termo_params_t const* params);
 
+// interrupt context - return the notify bits to post to the termo task
+termo_notify_t termo_manager_update_timer_isr(termo_manager_t* manager);
+termo_notify_t termo_manager_sensor_done_isr(termo_manager_t* manager);
+termo_notify_t termo_manager_sensor_error_isr(termo_manager_t* manager);
+
 #endif // TERMO_TASK_TERMO_MANAGER_H
\ No newline at end of file
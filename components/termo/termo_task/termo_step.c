@@ -0,0 +1,118 @@
+#include "termo_step.h"
+#include <math.h>
+#include <stddef.h>
+
+#define STEP_MIN_SIZE (0.5F)
+#define STEP_MIN_BAND (0.1F)
+#define STEP_BAND (0.02F)
+#define STEP_HOLD_TIME (20000U)
+#define STEP_TIMEOUT (900000U)
+
+bool termo_step_start(termo_step_t* step,
+                      float32_t from,
+                      float32_t to,
+                      uint32_t timestamp)
+{
+    if (step == NULL) {
+        return false;
+    }
+
+    step->is_active = false;
+    if (fabsf(to - from) < STEP_MIN_SIZE) {
+        return false;
+    }
+
+    step->from = from;
+    step->to = to;
+    step->band = fmaxf(STEP_BAND * fabsf(to - from), STEP_MIN_BAND);
+
+    step->start_timestamp = timestamp;
+    step->last_timestamp = timestamp;
+    step->settle_timestamp = timestamp;
+    step->is_inside = false;
+
+    step->has_rise_start = false;
+    step->has_rise_end = false;
+    step->rise_timestamp = timestamp;
+    step->peak = 0.0F;
+
+    step->metrics = (termo_step_metrics_t){};
+    step->is_active = true;
+
+    return true;
+}
+
+void termo_step_cancel(termo_step_t* step)
+{
+    if (step == NULL) {
+        return;
+    }
+
+    step->is_active = false;
+}
+
+bool termo_step_update(termo_step_t* step,
+                       float32_t measurement,
+                       uint32_t timestamp)
+{
+    if (step == NULL || !step->is_active) {
+        return false;
+    }
+
+    float32_t elapsed =
+        (float32_t)(timestamp - step->start_timestamp) / 1000.0F;
+
+    step->metrics.iae += fabsf(step->to - measurement) *
+                         (float32_t)(timestamp - step->last_timestamp) /
+                         1000.0F;
+    step->last_timestamp = timestamp;
+
+    // progress is signed along the step so falling steps read the same
+    float32_t progress = (measurement - step->from) / (step->to - step->from);
+    step->peak = fmaxf(step->peak, progress);
+
+    if (!step->has_rise_start && progress >= 0.1F) {
+        step->has_rise_start = true;
+        step->rise_timestamp = timestamp;
+    }
+    if (step->has_rise_start && !step->has_rise_end && progress >= 0.9F) {
+        step->has_rise_end = true;
+        step->metrics.rise_time =
+            (float32_t)(timestamp - step->rise_timestamp) / 1000.0F;
+    }
+
+    if (fabsf(measurement - step->to) <= step->band) {
+        if (!step->is_inside) {
+            step->is_inside = true;
+            step->settle_timestamp = timestamp;
+        }
+    } else {
+        step->is_inside = false;
+    }
+
+    bool is_settled = step->is_inside && timestamp - step->settle_timestamp >=
+                                             STEP_HOLD_TIME;
+    bool is_timeout = timestamp - step->start_timestamp >= STEP_TIMEOUT;
+    if (!is_settled && !is_timeout) {
+        return false;
+    }
+
+    step->metrics.overshoot = fmaxf(step->peak - 1.0F, 0.0F) * 100.0F;
+    step->metrics.settling_time =
+        is_settled
+            ? (float32_t)(step->settle_timestamp - step->start_timestamp) /
+                  1000.0F
+            : elapsed;
+    if (!step->has_rise_end) {
+        step->metrics.rise_time = elapsed;
+    }
+    step->is_active = false;
+
+    return true;
+}
+
+#undef STEP_MIN_SIZE
+#undef STEP_MIN_BAND
+#undef STEP_BAND
+#undef STEP_HOLD_TIME
+#undef STEP_TIMEOUT
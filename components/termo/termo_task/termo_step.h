@@ -0,0 +1,49 @@
+#ifndef TERMO_TASK_TERMO_STEP_H
+#define TERMO_TASK_TERMO_STEP_H
+
+#include "arm_math.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// times in seconds, overshoot in percent of the step, iae in degree seconds
+typedef struct {
+    float32_t rise_time;
+    float32_t overshoot;
+    float32_t settling_time;
+    float32_t iae;
+} termo_step_metrics_t;
+
+// follows the response to a reference step until it stays inside the
+// settling band long enough, or until the timeout
+typedef struct {
+    bool is_active;
+    float32_t from;
+    float32_t to;
+    float32_t band;
+
+    uint32_t start_timestamp;
+    uint32_t last_timestamp;
+    uint32_t settle_timestamp;
+    bool is_inside;
+
+    bool has_rise_start;
+    bool has_rise_end;
+    uint32_t rise_timestamp;
+    float32_t peak;
+
+    termo_step_metrics_t metrics;
+} termo_step_t;
+
+// false for steps too small to measure
+bool termo_step_start(termo_step_t* step,
+                      float32_t from,
+                      float32_t to,
+                      uint32_t timestamp);
+void termo_step_cancel(termo_step_t* step);
+
+// true once the step is over, the metrics are then final
+bool termo_step_update(termo_step_t* step,
+                       float32_t measurement,
+                       uint32_t timestamp);
+
+#endif // TERMO_TASK_TERMO_STEP_H
@@ -12,19 +12,21 @@
 #define TERMO_QUEUE_LENGTH (10U)
 #define TERMO_QUEUE_STORAGE_SIZE (TERMO_QUEUE_ITEM_SIZE * TERMO_QUEUE_LENGTH)
 
+// shared with the interrupt callbacks, which start and finish sensor reads
+static termo_manager_t termo_manager;
+
 static void termo_task_func(void* ctx)
 {
     termo_task_ctx_t* task_ctx = (termo_task_ctx_t*)ctx;
 
-    termo_manager_t manager;
     TERMO_LOG_ON_ERR(pcTaskGetName(NULL),
-                     termo_manager_initialize(&manager,
+                     termo_manager_initialize(&termo_manager,
                                               &task_ctx->config,
                                               &task_ctx->params));
 
     while (1) {
-        TERMO_LOG_ON_ERR(pcTaskGetName(NULL), termo_manager_process(&manager));
-        TERMO_DELAY(10);
+        TERMO_LOG_ON_ERR(pcTaskGetName(NULL),
+                         termo_manager_process(&termo_manager));
     }
 }
 
@@ -72,29 +74,43 @@ termo_err_t termo_task_initialize(termo_task_ctx_t const* task_ctx)
     return TERMO_ERR_OK;
 }
 
-void termo_task_delta_timer_callback(void)
+static inline void termo_task_notify_from_isr(termo_notify_t notify)
 {
+    if (notify == 0) {
+        return;
+    }
+
     BaseType_t task_woken = pdFALSE;
     xTaskNotifyFromISR(termo_task_manager_get(TERMO_TASK_TYPE_TERMO),
-                       TERMO_NOTIFY_DELTA_TIMER,
+                       notify,
                        eSetBits,
                        &task_woken);
     portYIELD_FROM_ISR(task_woken);
 }
 
+void termo_task_delta_timer_callback(void)
+{
+    termo_task_notify_from_isr(TERMO_NOTIFY_DELTA_TIMER);
+}
+
 void termo_task_update_timer_callback(void)
 {
-    BaseType_t task_woken = pdFALSE;
-    xTaskNotifyFromISR(termo_task_manager_get(TERMO_TASK_TYPE_TERMO),
-                       TERMO_NOTIFY_UPDATE_TIMER,
-                       eSetBits,
-                       &task_woken);
-    portYIELD_FROM_ISR(task_woken);
+    termo_task_notify_from_isr(termo_manager_update_timer_isr(&termo_manager));
 }
 
 void termo_task_pwm_timer_callback(void)
 {}
 
+void termo_task_sensor_done_callback(void)
+{
+    termo_task_notify_from_isr(termo_manager_sensor_done_isr(&termo_manager));
+}
+
+void termo_task_sensor_error_callback(void)
+{
+    termo_task_notify_from_isr(termo_manager_sensor_error_isr(&termo_manager));
+}
+
 #undef TERMO_TASK_STACK_DEPTH
 #undef TERMO_TASK_NAME
 #undef TERMO_TASK_PRIORITY
@@ -0,0 +1,72 @@
+#include "termo_zones.h"
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+bool termo_zones_initialize(termo_zones_t* zones,
+                            termo_zones_config_t const* config)
+{
+    if (zones == NULL || config == NULL || config->count == 0U ||
+        config->count > TERMO_ZONES_NUM || config->delta_time <= 0.0F ||
+        config->max_control <= config->min_control ||
+        config->max_compare < config->min_compare) {
+        return false;
+    }
+
+    zones->count = config->count;
+
+    for (uint32_t index = 0U; index < config->count; ++index) {
+        zones->prop_gains[index] = config->kp[index];
+        zones->int_gains[index] = config->ki[index] * config->delta_time;
+        zones->dot_gains[index] = config->kd[index] / config->delta_time;
+        zones->sat_gains[index] = config->kc[index];
+    }
+    zones->min_control = config->min_control;
+    zones->max_control = config->max_control;
+    zones->compare_gain = (config->max_compare - config->min_compare) /
+                          (config->max_control - config->min_control);
+    zones->compare_offset =
+        config->min_compare - zones->compare_gain * config->min_control;
+
+    memset(zones->references, 0, sizeof(zones->references));
+    memset(zones->measurements, 0, sizeof(zones->measurements));
+    termo_zones_reset(zones);
+
+    return true;
+}
+
+void termo_zones_reset(termo_zones_t* zones)
+{
+    if (zones == NULL) {
+        return;
+    }
+
+    memset(zones->integrals, 0, sizeof(zones->integrals));
+    memset(zones->errors, 0, sizeof(zones->errors));
+    memset(zones->compares, 0, sizeof(zones->compares));
+}
+
+void termo_zones_step(termo_zones_t* zones)
+{
+    if (zones == NULL) {
+        return;
+    }
+
+    // branch free body, every zone costs the same whatever its state
+    for (uint32_t index = 0U; index < zones->count; ++index) {
+        float32_t error = zones->references[index] - zones->measurements[index];
+        float32_t integral =
+            zones->integrals[index] + zones->int_gains[index] * error;
+        float32_t control =
+            zones->prop_gains[index] * error + integral +
+            zones->dot_gains[index] * (error - zones->errors[index]);
+        float32_t saturated =
+            fminf(fmaxf(control, zones->min_control), zones->max_control);
+
+        zones->integrals[index] =
+            integral + zones->sat_gains[index] * (saturated - control);
+        zones->errors[index] = error;
+        zones->compares[index] = (uint32_t)(zones->compare_offset +
+                                            zones->compare_gain * saturated);
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef TERMO_TASK_TERMO_ZONES_H
+#define TERMO_TASK_TERMO_ZONES_H
+
+#include "arm_math.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#define TERMO_ZONES_NUM (16U)
+
+// the gains are per zone, the first count of each array are used
+typedef struct {
+    uint32_t count;
+    float32_t kp[TERMO_ZONES_NUM];
+    float32_t ki[TERMO_ZONES_NUM];
+    float32_t kd[TERMO_ZONES_NUM];
+    float32_t kc[TERMO_ZONES_NUM];
+    float32_t delta_time;
+    float32_t min_control;
+    float32_t max_control;
+    float32_t min_compare;
+    float32_t max_compare;
+} termo_zones_config_t;
+
+// one pid per zone with its own gains, kept as a structure of arrays so a
+// step runs the same arithmetic down contiguous per zone lanes - control
+// is a temperature in the control range mapped linearly onto the compare
+// range, kc feeds the saturation excess back into the integral
+typedef struct {
+    uint32_t count;
+
+    float32_t min_control;
+    float32_t max_control;
+    float32_t compare_gain;
+    float32_t compare_offset;
+
+    float32_t prop_gains[TERMO_ZONES_NUM];
+    float32_t int_gains[TERMO_ZONES_NUM];
+    float32_t dot_gains[TERMO_ZONES_NUM];
+    float32_t sat_gains[TERMO_ZONES_NUM];
+
+    float32_t references[TERMO_ZONES_NUM];
+    float32_t measurements[TERMO_ZONES_NUM];
+    float32_t integrals[TERMO_ZONES_NUM];
+    float32_t errors[TERMO_ZONES_NUM];
+    uint32_t compares[TERMO_ZONES_NUM];
+} termo_zones_t;
+
+bool termo_zones_initialize(termo_zones_t* zones,
+                            termo_zones_config_t const* config);
+void termo_zones_reset(termo_zones_t* zones);
+
+void termo_zones_step(termo_zones_t* zones);
+
+#endif // TERMO_TASK_TERMO_ZONES_H
@@ -77,6 +77,7 @@
 #define configUSE_RECURSIVE_MUTEXES              1
 #define configUSE_COUNTING_SEMAPHORES            1
 #define configUSE_PORT_OPTIMISED_TASK_SELECTION  0
+#define configUSE_TICKLESS_IDLE                  1
 /* USER CODE BEGIN MESSAGE_BUFFER_LENGTH_TYPE */
 /* Defaults to size_t for backward compatibility, but can be changed
    if lengths will always be less than the number of bytes in a size_t. */
@@ -165,6 +166,16 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  void termo_power_suppress_ticks_and_sleep(uint32_t expected_idle_time);
+  void termo_stats_start_run_time_counter(void);
+  uint32_t termo_stats_get_run_time_counter(void);
+#endif
+#define configGENERATE_RUN_TIME_STATS 1
+#define configUSE_STATS_FORMATTING_FUNCTIONS 0
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() termo_stats_start_run_time_counter()
+#define portGET_RUN_TIME_COUNTER_VALUE() termo_stats_get_run_time_counter()
+#define portSUPPRESS_TICKS_AND_SLEEP(xExpectedIdleTime) termo_power_suppress_ticks_and_sleep(xExpectedIdleTime)
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,39 @@
+#ifndef HOST_CMSIS_COMPILER_H
+#define HOST_CMSIS_COMPILER_H
+
+#include <stdint.h>
+
+#define __ASM __asm__
+#define __INLINE inline
+#define __STATIC_INLINE static inline
+#define __STATIC_FORCEINLINE [[gnu::always_inline]] static inline
+#define __ALIGNED(x) [[gnu::aligned(x)]]
+#define __PACKED [[gnu::packed]]
+
+__STATIC_FORCEINLINE uint8_t __CLZ(uint32_t value)
+{
+    return value == 0UL ? 32U : (uint8_t)__builtin_clz(value);
+}
+
+__STATIC_FORCEINLINE int32_t __SSAT(int32_t value, uint32_t sat)
+{
+    if (sat >= 1U && sat <= 32U) {
+        int32_t max = (int32_t)((1UL << (sat - 1U)) - 1UL);
+        int32_t min = -1 - max;
+        return value > max ? max : value < min ? min : value;
+    }
+
+    return value;
+}
+
+__STATIC_FORCEINLINE uint32_t __USAT(int32_t value, uint32_t sat)
+{
+    if (sat <= 31U) {
+        uint32_t max = (1UL << sat) - 1UL;
+        return value > (int32_t)max ? max : value < 0 ? 0UL : (uint32_t)value;
+    }
+
+    return (uint32_t)value;
+}
+
+#endif // HOST_CMSIS_COMPILER_H
@@ -0,0 +1,8 @@
+#ifndef HOST_DMA_H
+#define HOST_DMA_H
+
+#include "main.h"
+
+void MX_DMA_Init(void);
+
+#endif // HOST_DMA_H
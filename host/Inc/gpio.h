@@ -0,0 +1,8 @@
+#ifndef HOST_GPIO_H
+#define HOST_GPIO_H
+
+#include "main.h"
+
+void MX_GPIO_Init(void);
+
+#endif // HOST_GPIO_H
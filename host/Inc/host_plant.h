@@ -0,0 +1,43 @@
+#ifndef HOST_HOST_PLANT_H
+#define HOST_HOST_PLANT_H
+
+#include <stdint.h>
+
+#define HOST_PLANT_GAIN_ENV ("TERMO_HOST_PLANT_GAIN")
+#define HOST_PLANT_TIME_CONSTANT_ENV ("TERMO_HOST_PLANT_TIME_CONSTANT")
+#define HOST_PLANT_DEAD_TIME_ENV ("TERMO_HOST_PLANT_DEAD_TIME")
+#define HOST_PLANT_AMBIENT_ENV ("TERMO_HOST_PLANT_AMBIENT")
+
+#define HOST_PLANT_GAIN (20.0F)
+#define HOST_PLANT_TIME_CONSTANT (60.0F)
+#define HOST_PLANT_DEAD_TIME (2.0F)
+
+#define HOST_PLANT_DELAY_LEN (4096U)
+
+typedef struct {
+    float gain;
+    float time_constant;
+    float dead_time;
+    float ambient;
+} host_plant_params_t;
+
+typedef struct {
+    host_plant_params_t params;
+
+    float temperature;
+    float disturbance;
+
+    float delay_line[HOST_PLANT_DELAY_LEN];
+    uint32_t delay_index;
+} host_plant_t;
+
+void host_plant_initialize(host_plant_t* plant,
+                           host_plant_params_t const* params);
+
+void host_plant_step(host_plant_t* plant, float duty, uint32_t elapsed_time);
+
+void host_plant_set_disturbance(host_plant_t* plant, float disturbance);
+
+float host_plant_get_temperature(host_plant_t const* plant);
+
+#endif // HOST_HOST_PLANT_H
@@ -0,0 +1,83 @@
+#ifndef HOST_HOST_SCENARIO_H
+#define HOST_HOST_SCENARIO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+#define HOST_SCENARIO_ENV ("TERMO_HOST_SCENARIO")
+
+#define HOST_SCENARIO_START_TIME (1000U)
+#define HOST_SCENARIO_DURATION (300000U)
+#define HOST_SCENARIO_UPDATE_TIME (0.5F)
+
+#define HOST_SCENARIO_STEP_REFERENCE (30.0F)
+
+#define HOST_SCENARIO_RAMP_FROM (25.0F)
+#define HOST_SCENARIO_RAMP_TO (35.0F)
+#define HOST_SCENARIO_RAMP_STEP (0.5F)
+#define HOST_SCENARIO_RAMP_PERIOD (10000U)
+
+#define HOST_SCENARIO_DISTURBANCE_TIME (150000U)
+#define HOST_SCENARIO_DISTURBANCE (-3.0F)
+
+#define HOST_SCENARIO_SETTLING_BAND (0.02F)
+#define HOST_SCENARIO_MIN_SETTLING_BAND (0.1F)
+
+typedef enum {
+    HOST_SCENARIO_TYPE_NONE,
+    HOST_SCENARIO_TYPE_STEP,
+    HOST_SCENARIO_TYPE_RAMP,
+    HOST_SCENARIO_TYPE_DISTURBANCE,
+} host_scenario_type_t;
+
+typedef struct {
+    float rise_time;
+    float overshoot;
+    float overshoot_percent;
+    float settling_time;
+    float iae;
+    float max_error;
+    uint64_t control_steps;
+    // cpu time of the whole process - firmware tasks, peripheral models and
+    // plant - over the control steps, an upper bound on the controller cost
+    uint64_t process_cpu_time_per_step;
+} host_scenario_result_t;
+
+typedef struct {
+    host_scenario_type_t type;
+
+    bool has_reference;
+    float reference;
+    float disturbance;
+
+    bool has_window;
+    uint64_t window_start;
+    float window_from;
+    float window_to;
+    uint64_t rise_start;
+    uint64_t rise_end;
+    float peak_error;
+    uint64_t last_outside;
+    float iae;
+    float max_error;
+
+    uint64_t start_control_steps;
+    struct timespec start_cpu_time;
+} host_scenario_t;
+
+host_scenario_type_t host_scenario_type_from_string(char const* string);
+
+char const* host_scenario_type_to_string(host_scenario_type_t type);
+
+void host_scenario_initialize(host_scenario_t* scenario,
+                              host_scenario_type_t type);
+
+// returns true once the scenario has finished and reported its results
+bool host_scenario_step(host_scenario_t* scenario,
+                        uint64_t time,
+                        uint32_t elapsed_time,
+                        float temperature,
+                        float* disturbance);
+
+#endif // HOST_HOST_SCENARIO_H
@@ -0,0 +1,40 @@
+#ifndef HOST_HOST_SIM_H
+#define HOST_HOST_SIM_H
+
+#include "stm32l4xx_hal.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define HOST_SIM_STEP_TIME (1U)
+#define HOST_SIM_PCLK1_HZ (80000000UL)
+
+#define HOST_SIM_TIME_SCALE_ENV ("TERMO_HOST_TIME_SCALE")
+#define HOST_SIM_MAX_TIME_SCALE (1000U)
+
+#define HOST_SIM_FRAME_DIR_ENV ("TERMO_HOST_FRAME_DIR")
+#define HOST_SIM_FRAME_PERIOD (100U)
+
+#define HOST_SIM_AMBIENT_TEMP (22.0F)
+
+// wiring of the firmware as set up in main/config.h
+#define HOST_SIM_DELTA_TIMER (&htim2)
+#define HOST_SIM_PWM_TIMER (&htim3)
+#define HOST_SIM_PWM_CHANNEL (TIM_CHANNEL_1)
+
+void host_sim_initialize(void);
+uint64_t host_sim_get_time(void);
+
+void host_tim_step(uint32_t elapsed_time);
+float host_tim_get_duty(TIM_HandleTypeDef const* htim, uint32_t channel);
+uint64_t host_tim_get_update_count(TIM_HandleTypeDef const* htim);
+
+void host_i2c_set_temperature(float temperature);
+float host_i2c_get_temperature(void);
+
+void host_spi_step(uint32_t elapsed_time);
+
+void host_usart_step(void);
+void host_usart_inject(char const* data, size_t data_size);
+char const* host_usart_get_pty_name(void);
+
+#endif // HOST_HOST_SIM_H
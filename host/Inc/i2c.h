@@ -0,0 +1,10 @@
+#ifndef HOST_I2C_H
+#define HOST_I2C_H
+
+#include "main.h"
+
+extern I2C_HandleTypeDef hi2c1;
+
+void MX_I2C1_Init(void);
+
+#endif // HOST_I2C_H
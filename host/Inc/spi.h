@@ -0,0 +1,10 @@
+#ifndef HOST_SPI_H
+#define HOST_SPI_H
+
+#include "main.h"
+
+extern SPI_HandleTypeDef hspi1;
+
+void MX_SPI1_Init(void);
+
+#endif // HOST_SPI_H
@@ -0,0 +1,131 @@
+#ifndef HOST_STM32L476XX_H
+#define HOST_STM32L476XX_H
+
+#include <stdint.h>
+
+#define __IO volatile
+
+typedef enum {
+    LPTIM1_IRQn = 65,
+} IRQn_Type;
+
+typedef struct {
+    __IO uint32_t ODR;
+} GPIO_TypeDef;
+
+typedef struct {
+    __IO uint32_t CR1;
+    __IO uint32_t DIER;
+    __IO uint32_t SR;
+    __IO uint32_t CNT;
+    __IO uint32_t PSC;
+    __IO uint32_t ARR;
+    __IO uint32_t CCR1;
+    __IO uint32_t CCR2;
+    __IO uint32_t CCR3;
+    __IO uint32_t CCR4;
+} TIM_TypeDef;
+
+typedef struct {
+    __IO uint32_t CR1;
+} I2C_TypeDef;
+
+typedef struct {
+    __IO uint32_t CR1;
+} SPI_TypeDef;
+
+typedef struct {
+    __IO uint32_t CR1;
+} USART_TypeDef;
+
+typedef struct {
+    __IO uint32_t CFGR;
+    __IO uint32_t CCIPR;
+    __IO uint32_t APB1ENR1;
+} RCC_TypeDef;
+
+typedef struct {
+    __IO uint32_t ISR;
+    __IO uint32_t ICR;
+    __IO uint32_t IER;
+    __IO uint32_t CFGR;
+    __IO uint32_t CR;
+    __IO uint32_t CMP;
+    __IO uint32_t ARR;
+    __IO uint32_t CNT;
+} LPTIM_TypeDef;
+
+typedef struct {
+    __IO uint32_t IMR2;
+} EXTI_TypeDef;
+
+typedef struct {
+    __IO uint32_t CTRL;
+    __IO uint32_t LOAD;
+    __IO uint32_t VAL;
+} SysTick_Type;
+
+extern GPIO_TypeDef host_gpioa;
+extern GPIO_TypeDef host_gpiob;
+extern GPIO_TypeDef host_gpioc;
+extern TIM_TypeDef host_tim1;
+extern TIM_TypeDef host_tim2;
+extern TIM_TypeDef host_tim3;
+extern TIM_TypeDef host_tim4;
+extern I2C_TypeDef host_i2c1;
+extern SPI_TypeDef host_spi1;
+extern USART_TypeDef host_usart1;
+extern USART_TypeDef host_usart2;
+extern RCC_TypeDef host_rcc;
+extern LPTIM_TypeDef host_lptim1;
+extern EXTI_TypeDef host_exti;
+extern SysTick_Type host_systick;
+
+#define GPIOA (&host_gpioa)
+#define GPIOB (&host_gpiob)
+#define GPIOC (&host_gpioc)
+#define TIM1 (&host_tim1)
+#define TIM2 (&host_tim2)
+#define TIM3 (&host_tim3)
+#define TIM4 (&host_tim4)
+#define I2C1 (&host_i2c1)
+#define SPI1 (&host_spi1)
+#define USART1 (&host_usart1)
+#define USART2 (&host_usart2)
+#define RCC (&host_rcc)
+#define LPTIM1 (&host_lptim1)
+#define EXTI (&host_exti)
+#define SysTick (&host_systick)
+
+#define TIM_CR1_CEN (1UL << 0U)
+#define TIM_DIER_UIE (1UL << 0U)
+#define TIM_DIER_CC1IE (1UL << 1U)
+
+#define RCC_CFGR_PPRE1 (0x7UL << 8U)
+#define RCC_CFGR_PPRE1_DIV1 (0x0UL << 8U)
+
+#define LPTIM_ISR_CMPOK (1UL << 3U)
+#define LPTIM_ISR_ARROK (1UL << 4U)
+#define LPTIM_ICR_CMPMCF (1UL << 0U)
+#define LPTIM_IER_CMPMIE (1UL << 0U)
+#define LPTIM_CR_ENABLE (1UL << 0U)
+#define LPTIM_CR_CNTSTRT (1UL << 2U)
+
+#define EXTI_IMR2_IM32 (1UL << 0U)
+
+#define SysTick_CTRL_ENABLE_Msk (1UL << 0U)
+
+#define __disable_irq() \
+    do {                \
+    } while (0)
+
+#define __enable_irq() \
+    do {               \
+    } while (0)
+
+#define __DSB() __sync_synchronize()
+#define __ISB() __sync_synchronize()
+
+#define NVIC_ClearPendingIRQ(IRQN) ((void)(IRQN))
+
+#endif // HOST_STM32L476XX_H
@@ -0,0 +1,211 @@
+#ifndef HOST_STM32L4XX_HAL_H
+#define HOST_STM32L4XX_HAL_H
+
+#include "stm32l476xx.h"
+#include <stdint.h>
+
+typedef enum {
+    HAL_OK = 0x00,
+    HAL_ERROR = 0x01,
+    HAL_BUSY = 0x02,
+    HAL_TIMEOUT = 0x03,
+} HAL_StatusTypeDef;
+
+typedef enum {
+    GPIO_PIN_RESET = 0,
+    GPIO_PIN_SET,
+} GPIO_PinState;
+
+#define GPIO_PIN_0 (1U << 0U)
+#define GPIO_PIN_1 (1U << 1U)
+#define GPIO_PIN_2 (1U << 2U)
+#define GPIO_PIN_3 (1U << 3U)
+#define GPIO_PIN_4 (1U << 4U)
+#define GPIO_PIN_5 (1U << 5U)
+#define GPIO_PIN_6 (1U << 6U)
+#define GPIO_PIN_7 (1U << 7U)
+#define GPIO_PIN_8 (1U << 8U)
+#define GPIO_PIN_9 (1U << 9U)
+#define GPIO_PIN_10 (1U << 10U)
+#define GPIO_PIN_11 (1U << 11U)
+#define GPIO_PIN_12 (1U << 12U)
+#define GPIO_PIN_13 (1U << 13U)
+#define GPIO_PIN_14 (1U << 14U)
+#define GPIO_PIN_15 (1U << 15U)
+
+typedef struct {
+    uint32_t Prescaler;
+    uint32_t CounterMode;
+    uint32_t Period;
+    uint32_t ClockDivision;
+} TIM_Base_InitTypeDef;
+
+typedef struct {
+    TIM_TypeDef* Instance;
+    TIM_Base_InitTypeDef Init;
+} TIM_HandleTypeDef;
+
+#define TIM_CHANNEL_1 (0x00000000U)
+#define TIM_CHANNEL_2 (0x00000004U)
+#define TIM_CHANNEL_3 (0x00000008U)
+#define TIM_CHANNEL_4 (0x0000000CU)
+
+#define TIM_COUNTERMODE_UP (0x00000000U)
+#define TIM_CLOCKDIVISION_DIV1 (0x00000000U)
+
+#define __HAL_TIM_ENABLE(HANDLE) ((HANDLE)->Instance->CR1 |= TIM_CR1_CEN)
+#define __HAL_TIM_DISABLE(HANDLE) ((HANDLE)->Instance->CR1 &= ~TIM_CR1_CEN)
+#define __HAL_TIM_SET_COUNTER(HANDLE, COUNTER) \
+    ((HANDLE)->Instance->CNT = (COUNTER))
+#define __HAL_TIM_SET_PRESCALER(HANDLE, PRESCALER) \
+    ((HANDLE)->Instance->PSC = (PRESCALER))
+#define __HAL_TIM_GET_AUTORELOAD(HANDLE) ((HANDLE)->Instance->ARR)
+#define __HAL_TIM_SET_AUTORELOAD(HANDLE, AUTORELOAD) \
+    do {                                             \
+        (HANDLE)->Instance->ARR = (AUTORELOAD);      \
+        (HANDLE)->Init.Period = (AUTORELOAD);        \
+    } while (0)
+#define __HAL_TIM_SET_COMPARE(HANDLE, CHANNEL, COMPARE) \
+    (*(&(HANDLE)->Instance->CCR1 + ((CHANNEL) >> 2U)) = (COMPARE))
+#define __HAL_TIM_GET_COMPARE(HANDLE, CHANNEL) \
+    (*(&(HANDLE)->Instance->CCR1 + ((CHANNEL) >> 2U)))
+
+typedef struct {
+    uint32_t Timing;
+    uint32_t OwnAddress1;
+} I2C_InitTypeDef;
+
+typedef struct {
+    I2C_TypeDef* Instance;
+    I2C_InitTypeDef Init;
+} I2C_HandleTypeDef;
+
+#define I2C_MEMADD_SIZE_8BIT (0x00000001U)
+#define I2C_MEMADD_SIZE_16BIT (0x00000002U)
+
+typedef struct {
+    uint32_t Mode;
+    uint32_t BaudRatePrescaler;
+} SPI_InitTypeDef;
+
+typedef struct {
+    SPI_TypeDef* Instance;
+    SPI_InitTypeDef Init;
+} SPI_HandleTypeDef;
+
+typedef struct {
+    uint32_t BaudRate;
+} UART_InitTypeDef;
+
+typedef struct {
+    USART_TypeDef* Instance;
+    UART_InitTypeDef Init;
+} UART_HandleTypeDef;
+
+// bit 0 is the transmit state and bit 1 the receive state, as on the target
+typedef uint32_t HAL_UART_StateTypeDef;
+
+#define HAL_UART_STATE_READY (0x20U)
+#define HAL_UART_STATE_BUSY_TX (0x21U)
+#define HAL_UART_STATE_BUSY_RX (0x22U)
+
+#define RCC_LPTIM1CLKSOURCE_LSE (0x3UL << 18U)
+
+#define __HAL_RCC_LPTIM1_CONFIG(SOURCE) \
+    (RCC->CCIPR = (RCC->CCIPR & ~(0x3UL << 18U)) | (SOURCE))
+#define __HAL_RCC_LPTIM1_CLK_ENABLE() (RCC->APB1ENR1 |= (1UL << 31U))
+
+#define PWR_STOPENTRY_WFI (0x01U)
+
+extern __IO uint32_t uwTick;
+
+HAL_StatusTypeDef HAL_Init(void);
+void HAL_IncTick(void);
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t delay);
+void HAL_SuspendTick(void);
+void HAL_ResumeTick(void);
+
+uint32_t HAL_RCC_GetPCLK1Freq(void);
+
+void HAL_NVIC_EnableIRQ(IRQn_Type irqn);
+void HAL_NVIC_DisableIRQ(IRQn_Type irqn);
+
+void HAL_PWREx_EnterSTOP2Mode(uint8_t entry);
+
+void HAL_GPIO_WritePin(GPIO_TypeDef* gpio, uint16_t pin, GPIO_PinState state);
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef* htim);
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef* htim);
+HAL_StatusTypeDef HAL_TIM_PWM_Start_IT(TIM_HandleTypeDef* htim,
+                                       uint32_t channel);
+HAL_StatusTypeDef HAL_TIM_PWM_Stop_IT(TIM_HandleTypeDef* htim,
+                                      uint32_t channel);
+
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef* htim);
+void HAL_TIM_PWM_PulseFinishedCallback(TIM_HandleTypeDef* htim);
+
+HAL_StatusTypeDef HAL_I2C_IsDeviceReady(I2C_HandleTypeDef* hi2c,
+                                        uint16_t address,
+                                        uint32_t trials,
+                                        uint32_t timeout);
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef* hi2c,
+                                    uint16_t address,
+                                    uint16_t mem_address,
+                                    uint16_t mem_address_size,
+                                    uint8_t* data,
+                                    uint16_t size,
+                                    uint32_t timeout);
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef* hi2c,
+                                   uint16_t address,
+                                   uint16_t mem_address,
+                                   uint16_t mem_address_size,
+                                   uint8_t* data,
+                                   uint16_t size,
+                                   uint32_t timeout);
+HAL_StatusTypeDef HAL_I2C_Mem_Read_IT(I2C_HandleTypeDef* hi2c,
+                                      uint16_t address,
+                                      uint16_t mem_address,
+                                      uint16_t mem_address_size,
+                                      uint8_t* data,
+                                      uint16_t size);
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef* hi2c);
+HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef* hi2c);
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef* hi2c);
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef* hi2c);
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef* hspi,
+                                   uint8_t const* data,
+                                   uint16_t size,
+                                   uint32_t timeout);
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef* hspi,
+                                       uint8_t const* data,
+                                       uint16_t size);
+HAL_StatusTypeDef HAL_SPI_Abort(SPI_HandleTypeDef* hspi);
+
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef* hspi);
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef* hspi);
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef* huart,
+                                    uint8_t const* data,
+                                    uint16_t size,
+                                    uint32_t timeout);
+HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef* huart,
+                                       uint8_t const* data,
+                                       uint16_t size);
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef* huart,
+                                        uint8_t const* data,
+                                        uint16_t size);
+HAL_StatusTypeDef HAL_UART_AbortTransmit(UART_HandleTypeDef* huart);
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef* huart,
+                                               uint8_t* data,
+                                               uint16_t size);
+HAL_StatusTypeDef HAL_UART_AbortReceive_IT(UART_HandleTypeDef* huart);
+HAL_UART_StateTypeDef HAL_UART_GetState(UART_HandleTypeDef const* huart);
+
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef* huart);
+void HAL_UART_ErrorCallback(UART_HandleTypeDef* huart);
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef* huart, uint16_t size);
+
+#endif // HOST_STM32L4XX_HAL_H
@@ -0,0 +1,15 @@
+#ifndef HOST_TIM_H
+#define HOST_TIM_H
+
+#include "main.h"
+
+extern TIM_HandleTypeDef htim1;
+extern TIM_HandleTypeDef htim2;
+extern TIM_HandleTypeDef htim3;
+extern TIM_HandleTypeDef htim4;
+
+void MX_TIM2_Init(void);
+void MX_TIM3_Init(void);
+void MX_TIM4_Init(void);
+
+#endif // HOST_TIM_H
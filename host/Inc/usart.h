@@ -0,0 +1,12 @@
+#ifndef HOST_USART_H
+#define HOST_USART_H
+
+#include "main.h"
+
+extern UART_HandleTypeDef huart1;
+extern UART_HandleTypeDef huart2;
+
+void MX_USART1_UART_Init(void);
+void MX_USART2_UART_Init(void);
+
+#endif // HOST_USART_H
@@ -0,0 +1,47 @@
+#include "FreeRTOS.h"
+#include "task.h"
+#include <time.h>
+
+void vApplicationGetIdleTaskMemory(StaticTask_t** task_buffer,
+                                   StackType_t** stack_buffer,
+                                   uint32_t* stack_size)
+{
+    static StaticTask_t idle_task_buffer;
+    static StackType_t idle_task_stack[configMINIMAL_STACK_SIZE];
+
+    *task_buffer = &idle_task_buffer;
+    *stack_buffer = idle_task_stack;
+    *stack_size = configMINIMAL_STACK_SIZE;
+}
+
+void vApplicationGetTimerTaskMemory(StaticTask_t** task_buffer,
+                                    StackType_t** stack_buffer,
+                                    uint32_t* stack_size)
+{
+    static StaticTask_t timer_task_buffer;
+    static StackType_t timer_task_stack[configTIMER_TASK_STACK_DEPTH];
+
+    *task_buffer = &timer_task_buffer;
+    *stack_buffer = timer_task_stack;
+    *stack_size = configTIMER_TASK_STACK_DEPTH;
+}
+
+// the tick timer of the POSIX port keeps running, so no tick is suppressed
+// and idle only sleeps for one tick the way wfi would - the tick pended
+// meanwhile is processed once the scheduler resumes
+void host_sim_suppress_ticks_and_sleep(uint32_t expected_idle_time)
+{
+    if (expected_idle_time == 0U) {
+        return;
+    }
+
+    struct timespec tick = {.tv_sec = 0,
+                            .tv_nsec = 1000000000L / configTICK_RATE_HZ};
+    nanosleep(&tick, NULL);
+}
+
+// the port hook the light sleep path of termo_power falls back to
+void vPortSuppressTicksAndSleep(TickType_t expected_idle_time)
+{
+    host_sim_suppress_ticks_and_sleep((uint32_t)expected_idle_time);
+}
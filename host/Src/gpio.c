@@ -0,0 +1,22 @@
+#include "gpio.h"
+
+GPIO_TypeDef host_gpioa = {};
+GPIO_TypeDef host_gpiob = {};
+GPIO_TypeDef host_gpioc = {};
+
+void MX_GPIO_Init(void)
+{
+    HAL_GPIO_WritePin(GPIOC,
+                      SH1107_SLAVE_SELECT_Pin | SH1107_CONTROL_Pin |
+                          SH1107_RESET_Pin,
+                      GPIO_PIN_RESET);
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef* gpio, uint16_t pin, GPIO_PinState state)
+{
+    if (state == GPIO_PIN_SET) {
+        gpio->ODR |= pin;
+    } else {
+        gpio->ODR &= ~(uint32_t)pin;
+    }
+}
@@ -0,0 +1,222 @@
+#define _GNU_SOURCE
+
+#include "termo_arm_pid.h"
+#include "termo_zones.h"
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#define HOST_ARM_PID_BENCH_STEPS (20000U)
+#define HOST_ARM_PID_BENCH_ROUNDS (1000000U)
+#define HOST_ARM_PID_BENCH_ERRORS (256U)
+
+// compares the engines may differ by - the float engine only rounds
+// differently, the q31 one also quantizes the error and the gains
+#define HOST_ARM_PID_BENCH_F32_TOLERANCE (1U)
+#define HOST_ARM_PID_BENCH_Q31_TOLERANCE (2U)
+
+typedef struct {
+    char const* name;
+    float32_t kp;
+    float32_t ki;
+    float32_t kd;
+    float32_t kc;
+} host_arm_pid_bench_gains_t;
+
+// the first are the defaults of main/config.h, a pure p controller over a
+// ten degree span
+static host_arm_pid_bench_gains_t const host_arm_pid_bench_cases[] = {
+    {"p", 100.0F, 0.0F, 0.0F, 0.0F},
+    {"pi back-calculated", 2.0F, 0.05F, 0.0F, 0.5F},
+    {"pid back-calculated", 4.0F, 0.1F, 2.0F, 1.0F},
+    {"pd", 8.0F, 0.0F, 5.0F, 0.0F},
+};
+
+static uint32_t host_arm_pid_bench_seed = 2654435761U;
+
+static inline uint64_t host_arm_pid_bench_get_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static float32_t host_arm_pid_bench_random(void)
+{
+    host_arm_pid_bench_seed ^= host_arm_pid_bench_seed << 13U;
+    host_arm_pid_bench_seed ^= host_arm_pid_bench_seed >> 17U;
+    host_arm_pid_bench_seed ^= host_arm_pid_bench_seed << 5U;
+
+    return (float32_t)host_arm_pid_bench_seed / 4294967296.0F;
+}
+
+static termo_zones_config_t host_arm_pid_bench_zones_config(
+    host_arm_pid_bench_gains_t const* gains)
+{
+    return (termo_zones_config_t){.count = 1U,
+                                  .kp = {gains->kp},
+                                  .ki = {gains->ki},
+                                  .kd = {gains->kd},
+                                  .kc = {gains->kc},
+                                  .delta_time = 1.0F,
+                                  .min_control = 25.0F,
+                                  .max_control = 35.0F,
+                                  .min_compare = 0.0F,
+                                  .max_compare = 65535.0F};
+}
+
+static termo_arm_pid_config_t host_arm_pid_bench_arm_config(
+    host_arm_pid_bench_gains_t const* gains,
+    termo_arm_pid_format_t format)
+{
+    return (termo_arm_pid_config_t){.format = format,
+                                    .kp = gains->kp,
+                                    .ki = gains->ki,
+                                    .kd = gains->kd,
+                                    .kc = gains->kc,
+                                    .delta_time = 1.0F,
+                                    .min_control = 25.0F,
+                                    .max_control = 35.0F,
+                                    .min_compare = 0.0F,
+                                    .max_compare = 65535.0F};
+}
+
+// the measurement wanders around steps of the reference far enough to
+// saturate both ends, but not past the error the q31 engine clips at - the
+// zone table is the float path both engines have to follow
+static uint32_t host_arm_pid_bench_compare(
+    host_arm_pid_bench_gains_t const* gains,
+    termo_arm_pid_format_t format,
+    uint32_t tolerance)
+{
+    termo_zones_t zones;
+    termo_arm_pid_t pid;
+    termo_zones_config_t zones_config =
+        host_arm_pid_bench_zones_config(gains);
+    termo_arm_pid_config_t pid_config =
+        host_arm_pid_bench_arm_config(gains, format);
+    if (!termo_zones_initialize(&zones, &zones_config) ||
+        !termo_arm_pid_initialize(&pid, &pid_config)) {
+        printf("%s: failed to initialize\n", gains->name);
+        return 1U;
+    }
+
+    float32_t band = fminf(pid.max_error, 10.0F);
+    float32_t measurement = 30.0F;
+    uint32_t worst = 0U;
+    for (uint32_t step = 0U; step < HOST_ARM_PID_BENCH_STEPS; ++step) {
+        if (step % 500U == 0U) {
+            zones.references[0] = 25.0F + 10.0F * host_arm_pid_bench_random();
+        }
+        measurement += host_arm_pid_bench_random() - 0.5F;
+        measurement = fminf(fmaxf(measurement, zones.references[0] - band),
+                            zones.references[0] + band);
+        zones.measurements[0] = measurement;
+
+        termo_zones_step(&zones);
+        uint32_t compare = termo_arm_pid_get_compare(&pid, zones.errors[0]);
+
+        uint32_t difference = compare > zones.compares[0]
+                                  ? compare - zones.compares[0]
+                                  : zones.compares[0] - compare;
+        if (difference > worst) {
+            worst = difference;
+        }
+    }
+
+    printf("%s, %s, worst difference %u\n",
+           gains->name,
+           format == TERMO_ARM_PID_FORMAT_F32 ? "f32" : "q31",
+           worst);
+
+    return worst > tolerance ? 1U : 0U;
+}
+
+static void host_arm_pid_bench_cost(void)
+{
+    static float32_t errors[HOST_ARM_PID_BENCH_ERRORS];
+    for (uint32_t index = 0U; index < HOST_ARM_PID_BENCH_ERRORS; ++index) {
+        errors[index] = 2.0F * host_arm_pid_bench_random() - 1.0F;
+    }
+
+    host_arm_pid_bench_gains_t const* gains = &host_arm_pid_bench_cases[2];
+    termo_zones_t zones;
+    termo_zones_config_t zones_config =
+        host_arm_pid_bench_zones_config(gains);
+    termo_zones_initialize(&zones, &zones_config);
+
+    // the sink keeps the steps from being optimized out
+    volatile uint32_t sink = 0U;
+
+    uint64_t start = host_arm_pid_bench_get_ns();
+    for (uint32_t round = 0U; round < HOST_ARM_PID_BENCH_ROUNDS; ++round) {
+        zones.measurements[0] =
+            zones.references[0] -
+            errors[round % HOST_ARM_PID_BENCH_ERRORS];
+        termo_zones_step(&zones);
+        sink = zones.compares[0];
+    }
+    uint64_t float_time = host_arm_pid_bench_get_ns() - start;
+
+    uint64_t times[2] = {};
+    for (uint32_t format = 0U; format < 2U; ++format) {
+        termo_arm_pid_t pid;
+        termo_arm_pid_config_t pid_config =
+            host_arm_pid_bench_arm_config(gains,
+                                          (termo_arm_pid_format_t)format);
+        termo_arm_pid_initialize(&pid, &pid_config);
+
+        start = host_arm_pid_bench_get_ns();
+        for (uint32_t round = 0U; round < HOST_ARM_PID_BENCH_ROUNDS;
+             ++round) {
+            sink = termo_arm_pid_get_compare(
+                &pid,
+                errors[round % HOST_ARM_PID_BENCH_ERRORS]);
+        }
+        times[format] = host_arm_pid_bench_get_ns() - start;
+    }
+    (void)sink;
+
+    printf("engine, ns/step\n");
+    printf("float zone, %.1f\n",
+           (double)float_time / HOST_ARM_PID_BENCH_ROUNDS);
+    printf("arm_pid_f32, %.1f\n",
+           (double)times[TERMO_ARM_PID_FORMAT_F32] /
+               HOST_ARM_PID_BENCH_ROUNDS);
+    printf("arm_pid_q31, %.1f\n",
+           (double)times[TERMO_ARM_PID_FORMAT_Q31] /
+               HOST_ARM_PID_BENCH_ROUNDS);
+}
+
+int main(void)
+{
+    uint32_t failed = 0U;
+    for (size_t index = 0UL; index < sizeof(host_arm_pid_bench_cases) /
+                                         sizeof(host_arm_pid_bench_cases[0]);
+         ++index) {
+        failed += host_arm_pid_bench_compare(&host_arm_pid_bench_cases[index],
+                                             TERMO_ARM_PID_FORMAT_F32,
+                                             HOST_ARM_PID_BENCH_F32_TOLERANCE);
+        failed += host_arm_pid_bench_compare(&host_arm_pid_bench_cases[index],
+                                             TERMO_ARM_PID_FORMAT_Q31,
+                                             HOST_ARM_PID_BENCH_Q31_TOLERANCE);
+    }
+
+    if (failed > 0U) {
+        printf("%u engines differ from the float path\n", failed);
+        return 1;
+    }
+
+    host_arm_pid_bench_cost();
+
+    return 0;
+}
+
+#undef HOST_ARM_PID_BENCH_STEPS
+#undef HOST_ARM_PID_BENCH_ROUNDS
+#undef HOST_ARM_PID_BENCH_ERRORS
+#undef HOST_ARM_PID_BENCH_F32_TOLERANCE
+#undef HOST_ARM_PID_BENCH_Q31_TOLERANCE
@@ -0,0 +1,287 @@
+#include "termo_autotune.h"
+#include "termo_step.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define HOST_AUTOTUNE_BENCH_TIME_CONSTANT (60.0)
+#define HOST_AUTOTUNE_BENCH_DEAD_TIME (5U)
+#define HOST_AUTOTUNE_BENCH_GAIN (20.0)
+#define HOST_AUTOTUNE_BENCH_AMBIENT (22.0)
+#define HOST_AUTOTUNE_BENCH_SETPOINT (30.0F)
+#define HOST_AUTOTUNE_BENCH_STEPS (7200U)
+
+// the defaults of main/config.h, PROP_GAIN and INT_GAIN over the ten degree
+// control span, in duty per degree
+#define HOST_AUTOTUNE_BENCH_BASELINE_KP (100.0F / 10.0F)
+#define HOST_AUTOTUNE_BENCH_BASELINE_KI (0.0F / 10.0F)
+
+// the describing function takes the oscillation for a sine, on a lag
+// dominant plant it is closer to a triangle whose peaks understate the
+// ultimate gain - the period comes out much closer
+#define HOST_AUTOTUNE_BENCH_GAIN_TOLERANCE (0.25)
+#define HOST_AUTOTUNE_BENCH_PERIOD_TOLERANCE (0.1)
+
+// overshoot in percent the no overshoot rule and ziegler-nichols may have
+#define HOST_AUTOTUNE_BENCH_NO_OVERSHOOT (1.0F)
+#define HOST_AUTOTUNE_BENCH_MAX_OVERSHOOT (25.0F)
+
+// first order lag behind a dead time, stepped once a second
+typedef struct {
+    double temperature;
+    float duties[HOST_AUTOTUNE_BENCH_DEAD_TIME];
+    uint32_t index;
+} host_autotune_bench_plant_t;
+
+static void host_autotune_bench_plant_reset(host_autotune_bench_plant_t* plant,
+                                            float duty)
+{
+    plant->temperature =
+        HOST_AUTOTUNE_BENCH_AMBIENT + HOST_AUTOTUNE_BENCH_GAIN * duty;
+    for (uint32_t index = 0U; index < HOST_AUTOTUNE_BENCH_DEAD_TIME; ++index) {
+        plant->duties[index] = duty;
+    }
+    plant->index = 0U;
+}
+
+static float host_autotune_bench_plant_step(host_autotune_bench_plant_t* plant,
+                                            float duty)
+{
+    float delayed = plant->duties[plant->index];
+    plant->duties[plant->index] = duty;
+    plant->index = (plant->index + 1U) % HOST_AUTOTUNE_BENCH_DEAD_TIME;
+
+    double target =
+        HOST_AUTOTUNE_BENCH_AMBIENT + HOST_AUTOTUNE_BENCH_GAIN * delayed;
+    plant->temperature += (target - plant->temperature) *
+                          (1.0 - exp(-1.0 / HOST_AUTOTUNE_BENCH_TIME_CONSTANT));
+
+    return (float)plant->temperature;
+}
+
+// phase crossover of the lag and the dead time, solved by bisection - the
+// sampled loop reacts one step late, which adds a second of dead time
+static void host_autotune_bench_expected(double* gain, double* period)
+{
+    double dead_time = (double)HOST_AUTOTUNE_BENCH_DEAD_TIME + 1.0;
+    double low = 0.0;
+    double high = M_PI / dead_time;
+    for (uint32_t iteration = 0U; iteration < 64U; ++iteration) {
+        double frequency = (low + high) / 2.0;
+        double phase = atan(frequency * HOST_AUTOTUNE_BENCH_TIME_CONSTANT) +
+                       frequency * dead_time;
+        if (phase < M_PI) {
+            low = frequency;
+        } else {
+            high = frequency;
+        }
+    }
+
+    double frequency = (low + high) / 2.0;
+    double lag = frequency * HOST_AUTOTUNE_BENCH_TIME_CONSTANT;
+    *gain = sqrt(1.0 + lag * lag) / HOST_AUTOTUNE_BENCH_GAIN;
+    *period = 2.0 * M_PI / frequency;
+}
+
+static bool host_autotune_bench_identify(termo_autotune_t* autotune)
+{
+    host_autotune_bench_plant_t plant;
+    host_autotune_bench_plant_reset(&plant, 0.0F);
+
+    termo_autotune_start(autotune,
+                         &(termo_autotune_config_t){
+                             .setpoint = HOST_AUTOTUNE_BENCH_SETPOINT,
+                             .bias = 0.5F,
+                             .amplitude = 0.5F,
+                             .hysteresis = 0.125F,
+                             .cycles = 4U,
+                             .timeout = 3600000U},
+                         0U);
+
+    float measurement = (float)plant.temperature;
+    for (uint32_t second = 0U;
+         autotune->state == TERMO_AUTOTUNE_STATE_RUNNING;
+         ++second) {
+        float duty = termo_autotune_step(autotune, measurement, second * 1000U);
+        measurement = host_autotune_bench_plant_step(&plant, duty);
+    }
+
+    return autotune->state == TERMO_AUTOTUNE_STATE_DONE;
+}
+
+// positional form with the saturation excess fed back into the integral,
+// the arithmetic of the firmware engines in duty instead of degrees - the
+// gains are those the firmware gets for a one degree control span
+static termo_step_metrics_t host_autotune_bench_step(float kp,
+                                                     float ki,
+                                                     float kd,
+                                                     float kc)
+{
+    host_autotune_bench_plant_t plant;
+    float from = HOST_AUTOTUNE_BENCH_SETPOINT - 5.0F;
+    host_autotune_bench_plant_reset(
+        &plant,
+        (from - (float)HOST_AUTOTUNE_BENCH_AMBIENT) /
+            (float)HOST_AUTOTUNE_BENCH_GAIN);
+
+    termo_step_t step;
+    termo_step_start(&step, from, HOST_AUTOTUNE_BENCH_SETPOINT, 0U);
+
+    float measurement = from;
+    float integral = (from - (float)HOST_AUTOTUNE_BENCH_AMBIENT) /
+                     (float)HOST_AUTOTUNE_BENCH_GAIN;
+    float previous = HOST_AUTOTUNE_BENCH_SETPOINT - measurement;
+    for (uint32_t second = 1U; second < HOST_AUTOTUNE_BENCH_STEPS; ++second) {
+        float error = HOST_AUTOTUNE_BENCH_SETPOINT - measurement;
+        float next = integral + ki * error;
+        float control = kp * error + next + kd * (error - previous);
+        float duty = fminf(fmaxf(control, 0.0F), 1.0F);
+        integral = next + kc * (duty - control);
+        previous = error;
+
+        measurement = host_autotune_bench_plant_step(&plant, duty);
+        if (termo_step_update(&step, measurement, second * 1000U)) {
+            break;
+        }
+    }
+
+    return step.metrics;
+}
+
+static termo_step_metrics_t host_autotune_bench_print(char const* name,
+                                                      float kp,
+                                                      float ki,
+                                                      float kd,
+                                                      float kc)
+{
+    termo_step_metrics_t metrics = host_autotune_bench_step(kp, ki, kd, kc);
+
+    printf("%s, %.4f, %.5f, %.4f, %.4f, %.1f, %.1f, %.1f, %.2f\n",
+           name,
+           kp,
+           ki,
+           kd,
+           kc,
+           metrics.rise_time,
+           metrics.overshoot,
+           metrics.settling_time,
+           metrics.iae);
+
+    return metrics;
+}
+
+static bool host_autotune_bench_is_within(double value,
+                                          double expected,
+                                          double tolerance)
+{
+    return fabs(value - expected) <= tolerance * expected;
+}
+
+int main(void)
+{
+    static char const* const rules[TERMO_TUNING_RULE_NUM] = {
+        [TERMO_TUNING_RULE_ZIEGLER_NICHOLS] = "ziegler-nichols",
+        [TERMO_TUNING_RULE_TYREUS_LUYBEN] = "tyreus-luyben",
+        [TERMO_TUNING_RULE_SOME_OVERSHOOT] = "some overshoot",
+        [TERMO_TUNING_RULE_NO_OVERSHOOT] = "no overshoot",
+    };
+
+    termo_autotune_t autotune;
+    if (!host_autotune_bench_identify(&autotune)) {
+        printf("relay experiment failed\n");
+        return 1;
+    }
+
+    double gain = 0.0;
+    double period = 0.0;
+    host_autotune_bench_expected(&gain, &period);
+
+    printf("ultimate gain, %.4f, expected %.4f\n",
+           autotune.ultimate_gain,
+           gain);
+    printf("ultimate period, %.2f s, expected %.2f s\n",
+           autotune.ultimate_period,
+           period);
+
+    uint32_t failed = 0U;
+    if (!host_autotune_bench_is_within(autotune.ultimate_gain,
+                                       gain,
+                                       HOST_AUTOTUNE_BENCH_GAIN_TOLERANCE)) {
+        printf("ultimate gain out of tolerance\n");
+        failed++;
+    }
+    if (!host_autotune_bench_is_within(autotune.ultimate_period,
+                                       period,
+                                       HOST_AUTOTUNE_BENCH_PERIOD_TOLERANCE)) {
+        printf("ultimate period out of tolerance\n");
+        failed++;
+    }
+
+    printf("rule, kp, ki, kd, kc, rise s, overshoot %%, settling s, iae\n");
+    termo_step_metrics_t baseline =
+        host_autotune_bench_print("config defaults",
+                                  HOST_AUTOTUNE_BENCH_BASELINE_KP,
+                                  HOST_AUTOTUNE_BENCH_BASELINE_KI,
+                                  0.0F,
+                                  0.0F);
+
+    termo_step_metrics_t metrics[TERMO_TUNING_RULE_NUM];
+    for (uint32_t rule = 0U; rule < TERMO_TUNING_RULE_NUM; ++rule) {
+        float kp = 0.0F;
+        float ki = 0.0F;
+        float kd = 0.0F;
+        float kc = 0.0F;
+        termo_autotune_get_gains(&autotune,
+                                 (termo_tuning_rule_t)rule,
+                                 1.0F,
+                                 1.0F,
+                                 &kp,
+                                 &ki,
+                                 &kd,
+                                 &kc);
+        metrics[rule] = host_autotune_bench_print(rules[rule], kp, ki, kd, kc);
+
+        if (metrics[rule].iae >= baseline.iae) {
+            printf("%s does no better than the defaults\n", rules[rule]);
+            failed++;
+        }
+    }
+
+    float ziegler_nichols =
+        metrics[TERMO_TUNING_RULE_ZIEGLER_NICHOLS].overshoot;
+    if (ziegler_nichols > HOST_AUTOTUNE_BENCH_MAX_OVERSHOOT) {
+        printf("ziegler-nichols overshoots too far\n");
+        failed++;
+    }
+    if (metrics[TERMO_TUNING_RULE_SOME_OVERSHOOT].overshoot >=
+        ziegler_nichols) {
+        printf("some overshoot overshoots as far as ziegler-nichols\n");
+        failed++;
+    }
+    if (metrics[TERMO_TUNING_RULE_NO_OVERSHOOT].overshoot >
+        HOST_AUTOTUNE_BENCH_NO_OVERSHOOT) {
+        printf("no overshoot overshoots\n");
+        failed++;
+    }
+
+    if (failed > 0U) {
+        printf("%u autotune checks failed\n", failed);
+        return 1;
+    }
+
+    return 0;
+}
+
+#undef HOST_AUTOTUNE_BENCH_TIME_CONSTANT
+#undef HOST_AUTOTUNE_BENCH_DEAD_TIME
+#undef HOST_AUTOTUNE_BENCH_GAIN
+#undef HOST_AUTOTUNE_BENCH_AMBIENT
+#undef HOST_AUTOTUNE_BENCH_SETPOINT
+#undef HOST_AUTOTUNE_BENCH_STEPS
+#undef HOST_AUTOTUNE_BENCH_BASELINE_KP
+#undef HOST_AUTOTUNE_BENCH_BASELINE_KI
+#undef HOST_AUTOTUNE_BENCH_GAIN_TOLERANCE
+#undef HOST_AUTOTUNE_BENCH_PERIOD_TOLERANCE
+#undef HOST_AUTOTUNE_BENCH_NO_OVERSHOOT
+#undef HOST_AUTOTUNE_BENCH_MAX_OVERSHOOT
@@ -0,0 +1,191 @@
+#include "termo_estimator.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// the delta time ten times below the update time, so most control steps
+// see no fresh sample
+#define HOST_ESTIMATOR_TEST_DELTA_TIME (0.1F)
+#define HOST_ESTIMATOR_TEST_SAMPLE_STEPS (10U)
+#define HOST_ESTIMATOR_TEST_STEPS (36000U)
+#define HOST_ESTIMATOR_TEST_SETTLE_STEPS (600U)
+#define HOST_ESTIMATOR_TEST_DUTY_STEPS (900U)
+
+// the model of main/config.h, run against a plant ten percent slower
+#define HOST_ESTIMATOR_TEST_TIME_CONSTANT (60.0F)
+#define HOST_ESTIMATOR_TEST_PLANT_TIME_CONSTANT (66.0F)
+#define HOST_ESTIMATOR_TEST_GAIN (20.0F)
+#define HOST_ESTIMATOR_TEST_AMBIENT (22.0F)
+#define HOST_ESTIMATOR_TEST_PROCESS_NOISE (0.001F)
+#define HOST_ESTIMATOR_TEST_MEASUREMENT_NOISE (0.0025F)
+#define HOST_ESTIMATOR_TEST_RESOLUTION (0.0625F)
+
+// the estimate has to beat holding the last sample by this much, and never
+// be further off than the plant moves in one update at full duty
+#define HOST_ESTIMATOR_TEST_MAX_RMS_RATIO (0.75F)
+#define HOST_ESTIMATOR_TEST_MAX_ERROR (0.3F)
+
+static uint32_t host_estimator_test_seed = 2654435761U;
+
+static float32_t host_estimator_test_random(void)
+{
+    host_estimator_test_seed ^= host_estimator_test_seed << 13U;
+    host_estimator_test_seed ^= host_estimator_test_seed >> 17U;
+    host_estimator_test_seed ^= host_estimator_test_seed << 5U;
+
+    return (float32_t)host_estimator_test_seed / 4294967296.0F;
+}
+
+// quantized like the sensor, with uniform noise of the configured variance
+static float32_t host_estimator_test_sample(float32_t temperature)
+{
+    float32_t noise = sqrtf(12.0F * HOST_ESTIMATOR_TEST_MEASUREMENT_NOISE) *
+                      (host_estimator_test_random() - 0.5F);
+
+    return HOST_ESTIMATOR_TEST_RESOLUTION *
+           roundf((temperature + noise) / HOST_ESTIMATOR_TEST_RESOLUTION);
+}
+
+static bool host_estimator_test_cold_start(void)
+{
+    termo_estimator_t estimator;
+    if (!termo_estimator_initialize(
+            &estimator,
+            &(termo_estimator_config_t){
+                .time_constant = HOST_ESTIMATOR_TEST_TIME_CONSTANT,
+                .gain = HOST_ESTIMATOR_TEST_GAIN,
+                .ambient = HOST_ESTIMATOR_TEST_AMBIENT,
+                .process_noise = HOST_ESTIMATOR_TEST_PROCESS_NOISE,
+                .delta_time = HOST_ESTIMATOR_TEST_DELTA_TIME})) {
+        printf("cold start: failed to initialize\n");
+        return false;
+    }
+
+    // nothing to predict from until the first sample
+    termo_estimator_predict(&estimator, 1.0F);
+    if (estimator.has_estimate) {
+        printf("cold start: estimate before the first sample\n");
+        return false;
+    }
+
+    termo_estimator_correct(&estimator,
+                            30.0F,
+                            HOST_ESTIMATOR_TEST_MEASUREMENT_NOISE);
+    if (!estimator.has_estimate || estimator.estimate != 30.0F ||
+        estimator.variance != HOST_ESTIMATOR_TEST_MEASUREMENT_NOISE) {
+        printf("cold start: first sample not taken as is\n");
+        return false;
+    }
+
+    return true;
+}
+
+// the duty steps between off, full and half every ninety seconds - off
+// stands for the outputs stopped on a fault, where the estimate coasts
+static bool host_estimator_test_tracking(void)
+{
+    termo_estimator_t estimator;
+    if (!termo_estimator_initialize(
+            &estimator,
+            &(termo_estimator_config_t){
+                .time_constant = HOST_ESTIMATOR_TEST_TIME_CONSTANT,
+                .gain = HOST_ESTIMATOR_TEST_GAIN,
+                .ambient = HOST_ESTIMATOR_TEST_AMBIENT,
+                .process_noise = HOST_ESTIMATOR_TEST_PROCESS_NOISE,
+                .delta_time = HOST_ESTIMATOR_TEST_DELTA_TIME})) {
+        printf("tracking: failed to initialize\n");
+        return false;
+    }
+
+    static float32_t const duties[] = {1.0F, 0.0F, 0.5F, 0.0F};
+    float32_t plant_decay = expf(-HOST_ESTIMATOR_TEST_DELTA_TIME /
+                                 HOST_ESTIMATOR_TEST_PLANT_TIME_CONSTANT);
+    float32_t temperature = HOST_ESTIMATOR_TEST_AMBIENT;
+    float32_t sample = host_estimator_test_sample(temperature);
+    termo_estimator_correct(&estimator,
+                            sample,
+                            HOST_ESTIMATOR_TEST_MEASUREMENT_NOISE);
+
+    double estimate_square = 0.0;
+    double sample_square = 0.0;
+    float32_t max_error = 0.0F;
+    float32_t max_variance = 0.0F;
+    for (uint32_t step = 1U; step <= HOST_ESTIMATOR_TEST_STEPS; ++step) {
+        float32_t duty = duties[(step / HOST_ESTIMATOR_TEST_DUTY_STEPS) %
+                                (sizeof(duties) / sizeof(duties[0]))];
+
+        temperature = plant_decay * temperature +
+                      (1.0F - plant_decay) *
+                          (HOST_ESTIMATOR_TEST_AMBIENT +
+                           HOST_ESTIMATOR_TEST_GAIN * duty);
+        termo_estimator_predict(&estimator, duty);
+
+        if (step % HOST_ESTIMATOR_TEST_SAMPLE_STEPS == 0U) {
+            sample = host_estimator_test_sample(temperature);
+            termo_estimator_correct(&estimator,
+                                    sample,
+                                    HOST_ESTIMATOR_TEST_MEASUREMENT_NOISE);
+        }
+
+        if (step < HOST_ESTIMATOR_TEST_SETTLE_STEPS) {
+            continue;
+        }
+
+        float32_t estimate_error = estimator.estimate - temperature;
+        float32_t sample_error = sample - temperature;
+        estimate_square += (double)(estimate_error * estimate_error);
+        sample_square += (double)(sample_error * sample_error);
+        max_error = fmaxf(max_error, fabsf(estimate_error));
+        max_variance = fmaxf(max_variance, estimator.variance);
+    }
+
+    uint32_t count =
+        HOST_ESTIMATOR_TEST_STEPS - HOST_ESTIMATOR_TEST_SETTLE_STEPS + 1U;
+    double estimate_rms = sqrt(estimate_square / count);
+    double sample_rms = sqrt(sample_square / count);
+    printf("estimate rms %.4f, last sample rms %.4f, max error %.4f, "
+           "max variance %.5f\n",
+           estimate_rms,
+           sample_rms,
+           (double)max_error,
+           (double)max_variance);
+
+    // the variance settles where prediction and correction balance, below
+    // the measurement noise plus one update of process noise
+    return estimate_rms <
+               (double)HOST_ESTIMATOR_TEST_MAX_RMS_RATIO * sample_rms &&
+           max_error < HOST_ESTIMATOR_TEST_MAX_ERROR &&
+           max_variance < HOST_ESTIMATOR_TEST_MEASUREMENT_NOISE +
+                              (float32_t)HOST_ESTIMATOR_TEST_SAMPLE_STEPS *
+                                  HOST_ESTIMATOR_TEST_PROCESS_NOISE;
+}
+
+int main(void)
+{
+    uint32_t failed = 0U;
+    failed += host_estimator_test_cold_start() ? 0U : 1U;
+    failed += host_estimator_test_tracking() ? 0U : 1U;
+
+    if (failed > 0U) {
+        printf("%u estimator checks failed\n", failed);
+        return 1;
+    }
+
+    return 0;
+}
+
+#undef HOST_ESTIMATOR_TEST_DELTA_TIME
+#undef HOST_ESTIMATOR_TEST_SAMPLE_STEPS
+#undef HOST_ESTIMATOR_TEST_STEPS
+#undef HOST_ESTIMATOR_TEST_SETTLE_STEPS
+#undef HOST_ESTIMATOR_TEST_DUTY_STEPS
+#undef HOST_ESTIMATOR_TEST_TIME_CONSTANT
+#undef HOST_ESTIMATOR_TEST_PLANT_TIME_CONSTANT
+#undef HOST_ESTIMATOR_TEST_GAIN
+#undef HOST_ESTIMATOR_TEST_AMBIENT
+#undef HOST_ESTIMATOR_TEST_PROCESS_NOISE
+#undef HOST_ESTIMATOR_TEST_MEASUREMENT_NOISE
+#undef HOST_ESTIMATOR_TEST_RESOLUTION
+#undef HOST_ESTIMATOR_TEST_MAX_RMS_RATIO
+#undef HOST_ESTIMATOR_TEST_MAX_ERROR
@@ -0,0 +1,173 @@
+#define _GNU_SOURCE
+
+#include "termo_filter.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#define HOST_FILTER_BENCH_CUTOFF (0.1F)
+#define HOST_FILTER_BENCH_SETTLE (2000U)
+#define HOST_FILTER_BENCH_PERIODS (4000U)
+#define HOST_FILTER_BENCH_SAMPLES (1000000U)
+
+// how far the measured response may be from the analytic one, and how far
+// a lone spike may move the output once the median is on
+#define HOST_FILTER_BENCH_TOLERANCE_DB (0.05)
+#define HOST_FILTER_BENCH_SPIKE_TOLERANCE (1e-4F)
+
+static inline uint64_t host_filter_bench_get_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// butterworth magnitude with the frequency warped by the bilinear transform
+static inline double host_filter_bench_expected_db(double frequency)
+{
+    double ratio =
+        tan(M_PI * frequency) / tan(M_PI * HOST_FILTER_BENCH_CUTOFF);
+
+    return -10.0 * log10(1.0 + pow(ratio, 4.0));
+}
+
+// amplitude of the settled output by correlation with the input, a peak
+// search only sees the samples and misses the crest between them
+static double host_filter_bench_measured_db(double frequency)
+{
+    termo_filter_t filter;
+    termo_filter_initialize(&filter,
+                            &(termo_filter_config_t){
+                                .cutoff = HOST_FILTER_BENCH_CUTOFF});
+
+    double in_phase = 0.0;
+    double quadrature = 0.0;
+    for (uint32_t index = 0U;
+         index < HOST_FILTER_BENCH_SETTLE + HOST_FILTER_BENCH_PERIODS;
+         ++index) {
+        double phase = 2.0 * M_PI * frequency * (double)index;
+        float output = 0.0F;
+        termo_filter_process(&filter, (float)sin(phase), &output);
+        if (index >= HOST_FILTER_BENCH_SETTLE) {
+            in_phase += (double)output * sin(phase);
+            quadrature += (double)output * cos(phase);
+        }
+    }
+
+    double amplitude = 2.0 * hypot(in_phase, quadrature) /
+                       (double)HOST_FILTER_BENCH_PERIODS;
+
+    return 20.0 * log10(amplitude);
+}
+
+// every frequency fits a whole number of periods in the correlated samples
+static uint32_t host_filter_bench_response(void)
+{
+    static double const frequencies[] =
+        {0.01, 0.02, 0.05, 0.08, 0.1, 0.15, 0.2, 0.3, 0.4};
+
+    uint32_t failed = 0U;
+    printf("frequency, measured dB, expected dB\n");
+    for (size_t index = 0UL;
+         index < sizeof(frequencies) / sizeof(frequencies[0]);
+         ++index) {
+        double measured = host_filter_bench_measured_db(frequencies[index]);
+        double expected = host_filter_bench_expected_db(frequencies[index]);
+        bool is_within =
+            fabs(measured - expected) <= HOST_FILTER_BENCH_TOLERANCE_DB;
+        printf("%.2f, %.2f, %.2f%s\n",
+               frequencies[index],
+               measured,
+               expected,
+               is_within ? "" : ", out of tolerance");
+        failed += is_within ? 0U : 1U;
+    }
+
+    return failed;
+}
+
+// a lone spike on a flat input should not reach the output at all once the
+// median is on
+static float host_filter_bench_spike(uint32_t median_len)
+{
+    termo_filter_t filter;
+    termo_filter_initialize(
+        &filter,
+        &(termo_filter_config_t){.median_len = median_len,
+                                 .cutoff = HOST_FILTER_BENCH_CUTOFF});
+
+    float deviation = 0.0F;
+    for (uint32_t index = 0U; index < 64U; ++index) {
+        float sample = index == 32U ? 100.0F : 25.0F;
+        float output = 0.0F;
+        if (termo_filter_process(&filter, sample, &output) &&
+            fabsf(output - 25.0F) > deviation) {
+            deviation = fabsf(output - 25.0F);
+        }
+    }
+
+    printf("spike, median %u, max deviation %.4f\n", median_len, deviation);
+
+    return deviation;
+}
+
+static void host_filter_bench_cost(char const* name,
+                                   termo_filter_config_t const* config)
+{
+    termo_filter_t filter;
+    termo_filter_initialize(&filter, config);
+
+    float output = 0.0F;
+    uint64_t start = host_filter_bench_get_ns();
+    for (uint32_t index = 0U; index < HOST_FILTER_BENCH_SAMPLES; ++index) {
+        float sample = 25.0F + (float)(index & 7U) * 0.0625F;
+        termo_filter_process(&filter, sample, &output);
+        __asm__ volatile("" : : "r"(output) : "memory");
+    }
+    uint64_t elapsed = host_filter_bench_get_ns() - start;
+
+    printf("%s, %.2f\n",
+           name,
+           (double)elapsed / (double)HOST_FILTER_BENCH_SAMPLES);
+}
+
+int main(void)
+{
+    uint32_t failed = host_filter_bench_response();
+
+    host_filter_bench_spike(0U);
+    if (host_filter_bench_spike(3U) > HOST_FILTER_BENCH_SPIKE_TOLERANCE) {
+        failed++;
+    }
+
+    if (failed > 0U) {
+        printf("%u filter checks failed\n", failed);
+        return 1;
+    }
+
+    printf("stages, ns/sample\n");
+    host_filter_bench_cost("none", &(termo_filter_config_t){});
+    host_filter_bench_cost("median 3",
+                           &(termo_filter_config_t){.median_len = 3U});
+    host_filter_bench_cost("median 7",
+                           &(termo_filter_config_t){.median_len = 7U});
+    host_filter_bench_cost("low-pass",
+                           &(termo_filter_config_t){.cutoff = 0.1F});
+    host_filter_bench_cost("median 3, low-pass, decimation 4",
+                           &(termo_filter_config_t){.median_len = 3U,
+                                                    .cutoff = 0.1F,
+                                                    .decimation = 4U});
+
+    return 0;
+}
+
+#undef HOST_FILTER_BENCH_CUTOFF
+#undef HOST_FILTER_BENCH_SETTLE
+#undef HOST_FILTER_BENCH_PERIODS
+#undef HOST_FILTER_BENCH_SAMPLES
+#undef HOST_FILTER_BENCH_TOLERANCE_DB
+#undef HOST_FILTER_BENCH_SPIKE_TOLERANCE
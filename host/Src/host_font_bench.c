@@ -0,0 +1,197 @@
+#define _GNU_SOURCE
+
+#include "font5x7.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define HOST_FONT_BENCH_WIDTH (128UL)
+#define HOST_FONT_BENCH_HEIGHT (128UL)
+#define HOST_FONT_BENCH_FRAME_SIZE \
+    (HOST_FONT_BENCH_WIDTH * HOST_FONT_BENCH_HEIGHT / FONT5X7_PAGE_HEIGHT)
+#define HOST_FONT_BENCH_CASES (20000U)
+#define HOST_FONT_BENCH_TEXT_SIZE (24U)
+#define HOST_FONT_BENCH_ROUNDS (20000U)
+
+typedef struct {
+    uint32_t seed;
+    uint8_t expected[HOST_FONT_BENCH_FRAME_SIZE];
+    uint8_t frame[HOST_FONT_BENCH_FRAME_SIZE];
+} host_font_bench_t;
+
+static inline uint64_t host_font_bench_get_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t host_font_bench_random(host_font_bench_t* bench)
+{
+    bench->seed ^= bench->seed << 13U;
+    bench->seed ^= bench->seed >> 17U;
+    bench->seed ^= bench->seed << 5U;
+
+    return bench->seed;
+}
+
+// the per pixel renderer the display used before, one read modify write of
+// the page byte for every pixel of the glyph cell
+static inline void host_font_bench_set_pixel(uint8_t* frame,
+                                             size_t x,
+                                             size_t y,
+                                             bool is_set)
+{
+    uint8_t* byte =
+        &frame[(y / FONT5X7_PAGE_HEIGHT) * HOST_FONT_BENCH_WIDTH + x];
+    uint8_t bit = (uint8_t)(1U << (y % FONT5X7_PAGE_HEIGHT));
+
+    *byte = is_set ? (uint8_t)(*byte | bit) : (uint8_t)(*byte & ~bit);
+}
+
+static size_t host_font_bench_pixel_char(uint8_t* frame,
+                                         size_t x,
+                                         size_t y,
+                                         char c)
+{
+    if (x >= HOST_FONT_BENCH_WIDTH ||
+        y + FONT5X7_HEIGHT > HOST_FONT_BENCH_HEIGHT) {
+        return 0UL;
+    }
+
+    size_t index = (size_t)(unsigned char)c - FONT5X7_CHAR_CODE_OFFSET;
+    if (index >= FONT5X7_CHARS) {
+        index = 0UL;
+    }
+
+    size_t width = 0UL;
+    for (; width < FONT5X7_CHAR_WIDTH && x + width < HOST_FONT_BENCH_WIDTH;
+         ++width) {
+        uint8_t bits = width < FONT5X7_WIDTH ? font5x7[index][width] : 0x00U;
+        for (size_t row = 0UL; row < FONT5X7_HEIGHT; ++row) {
+            host_font_bench_set_pixel(frame,
+                                      x + width,
+                                      y + row,
+                                      ((bits >> row) & 1U) != 0U);
+        }
+    }
+
+    return width;
+}
+
+static size_t host_font_bench_pixel_string(uint8_t* frame,
+                                           size_t x,
+                                           size_t y,
+                                           char const* string)
+{
+    size_t start = x;
+    for (; *string != '\0'; ++string) {
+        size_t width = host_font_bench_pixel_char(frame, x, y, *string);
+        if (width == 0UL) {
+            break;
+        }
+        x += width;
+    }
+
+    return x - start;
+}
+
+// random text at random positions, page aligned or not and clipped at the
+// edges, drawn over random frame contents by both renderers
+static uint32_t host_font_bench_golden(host_font_bench_t* bench)
+{
+    uint32_t failed = 0U;
+    for (uint32_t test = 0U; test < HOST_FONT_BENCH_CASES; ++test) {
+        for (size_t index = 0UL; index < sizeof(bench->frame); ++index) {
+            bench->frame[index] = (uint8_t)host_font_bench_random(bench);
+        }
+        memcpy(bench->expected, bench->frame, sizeof(bench->frame));
+
+        char text[HOST_FONT_BENCH_TEXT_SIZE];
+        size_t len = host_font_bench_random(bench) % sizeof(text);
+        for (size_t index = 0UL; index < len; ++index) {
+            // mostly printable, now and then outside the table
+            text[index] = (char)(host_font_bench_random(bench) % 160U);
+        }
+        text[len] = '\0';
+
+        size_t x = host_font_bench_random(bench) % HOST_FONT_BENCH_WIDTH;
+        size_t y = host_font_bench_random(bench) % HOST_FONT_BENCH_HEIGHT;
+
+        size_t expected_width =
+            host_font_bench_pixel_string(bench->expected, x, y, text);
+        size_t width = font5x7_draw_string(bench->frame,
+                                           HOST_FONT_BENCH_WIDTH,
+                                           HOST_FONT_BENCH_HEIGHT,
+                                           x,
+                                           y,
+                                           text);
+
+        if (width != expected_width ||
+            memcmp(bench->frame, bench->expected, sizeof(bench->frame)) !=
+                0) {
+            if (failed < 8U) {
+                printf("%zu chars at %zu, %zu: frame differs\n", len, x, y);
+            }
+            failed++;
+        }
+    }
+
+    return failed;
+}
+
+static void host_font_bench_cost(host_font_bench_t* bench)
+{
+    static char const text[] = "temp 25.50 C ref 30.00 C";
+    size_t glyphs = 0UL;
+
+    uint64_t start = host_font_bench_get_ns();
+    for (uint32_t round = 0U; round < HOST_FONT_BENCH_ROUNDS; ++round) {
+        size_t y = (round * 3U) % (HOST_FONT_BENCH_HEIGHT - FONT5X7_HEIGHT);
+        glyphs += font5x7_draw_string(bench->frame,
+                                      HOST_FONT_BENCH_WIDTH,
+                                      HOST_FONT_BENCH_HEIGHT,
+                                      0UL,
+                                      y,
+                                      text) /
+                  FONT5X7_CHAR_WIDTH;
+    }
+    uint64_t column = host_font_bench_get_ns() - start;
+
+    start = host_font_bench_get_ns();
+    for (uint32_t round = 0U; round < HOST_FONT_BENCH_ROUNDS; ++round) {
+        size_t y = (round * 3U) % (HOST_FONT_BENCH_HEIGHT - FONT5X7_HEIGHT);
+        host_font_bench_pixel_string(bench->frame, 0UL, y, text);
+    }
+    uint64_t pixel = host_font_bench_get_ns() - start;
+
+    printf("renderer, glyphs/s\n");
+    printf("column blit, %.0f\n", (double)glyphs * 1e9 / (double)column);
+    printf("per pixel, %.0f\n", (double)glyphs * 1e9 / (double)pixel);
+}
+
+int main(void)
+{
+    static host_font_bench_t bench = {.seed = 2654435761U};
+
+    uint32_t failed = host_font_bench_golden(&bench);
+    if (failed > 0U) {
+        printf("%u of %u frames differ\n", failed, HOST_FONT_BENCH_CASES);
+        return 1;
+    }
+
+    host_font_bench_cost(&bench);
+
+    return 0;
+}
+
+#undef HOST_FONT_BENCH_WIDTH
+#undef HOST_FONT_BENCH_HEIGHT
+#undef HOST_FONT_BENCH_FRAME_SIZE
+#undef HOST_FONT_BENCH_CASES
+#undef HOST_FONT_BENCH_TEXT_SIZE
+#undef HOST_FONT_BENCH_ROUNDS
@@ -0,0 +1,212 @@
+#define _GNU_SOURCE
+
+#include "termo_format.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define HOST_FORMAT_BENCH_GRID_DECIMALS (4U)
+#define HOST_FORMAT_BENCH_GRID_STEPS (2000000L)
+#define HOST_FORMAT_BENCH_SWEEP_STRIDE (997U)
+#define HOST_FORMAT_BENCH_TEXT_SIZE (32U)
+#define HOST_FORMAT_BENCH_ROUNDS (1000000U)
+
+static inline uint64_t host_format_bench_get_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// every value on the decimal grid, from -steps to steps units of the last
+// decimal, goes through strtof and has to come back as the same text
+static uint32_t host_format_bench_grid(uint8_t decimals)
+{
+    long scale = 1L;
+    for (uint8_t decimal = 0U; decimal < decimals; ++decimal) {
+        scale *= 10L;
+    }
+
+    uint32_t failed = 0U;
+    for (long step = -HOST_FORMAT_BENCH_GRID_STEPS;
+         step <= HOST_FORMAT_BENCH_GRID_STEPS;
+         ++step) {
+        char expected[HOST_FORMAT_BENCH_TEXT_SIZE];
+        long magnitude = labs(step);
+        if (decimals == 0U) {
+            snprintf(expected, sizeof(expected), "%ld", step);
+        } else {
+            snprintf(expected,
+                     sizeof(expected),
+                     "%s%ld.%0*ld",
+                     step < 0L ? "-" : "",
+                     magnitude / scale,
+                     (int)decimals,
+                     magnitude % scale);
+        }
+
+        char text[HOST_FORMAT_BENCH_TEXT_SIZE];
+        size_t len = termo_format_float(text,
+                                        sizeof(text),
+                                        strtof(expected, NULL),
+                                        decimals);
+        if (len != strlen(expected) || strcmp(text, expected) != 0) {
+            if (failed < 8U) {
+                printf("grid: %s came back as %s\n", expected, text);
+            }
+            failed++;
+        }
+    }
+
+    return failed;
+}
+
+// every stride-th float below the formatter's limit, each with its own
+// decimals, has to parse back within half a unit of the last decimal plus
+// the rounding of the float fraction and of strtof itself
+static uint32_t host_format_bench_sweep(void)
+{
+    uint32_t failed = 0U;
+    uint64_t count = 0ULL;
+    for (uint64_t bits = 0ULL; bits <= UINT32_MAX;
+         bits += HOST_FORMAT_BENCH_SWEEP_STRIDE) {
+        uint32_t pattern = (uint32_t)bits;
+        float value;
+        memcpy(&value, &pattern, sizeof(value));
+        if (!isfinite(value) || fabsf(value) >= 4294967040.0F) {
+            continue;
+        }
+
+        uint8_t decimals =
+            (uint8_t)(count++ % (TERMO_FORMAT_MAX_DECIMALS + 1U));
+        char text[HOST_FORMAT_BENCH_TEXT_SIZE];
+        if (termo_format_float(text, sizeof(text), value, decimals) == 0UL) {
+            printf("sweep: %a did not fit\n", (double)value);
+            failed++;
+            continue;
+        }
+
+        double tolerance = 0.5 * pow(10.0, -(double)decimals) + 0x1p-23 +
+                           (double)nextafterf(fabsf(value), INFINITY) -
+                           (double)fabsf(value);
+        double error = fabs((double)strtof(text, NULL) - (double)value);
+        if (error > tolerance) {
+            if (failed < 8U) {
+                printf("sweep: %.9g with %u decimals came back as %s\n",
+                       (double)value,
+                       decimals,
+                       text);
+            }
+            failed++;
+        }
+    }
+
+    return failed;
+}
+
+static uint32_t host_format_bench_special(void)
+{
+    static struct {
+        float value;
+        uint8_t decimals;
+        char const* expected;
+    } const cases[] = {
+        {NAN, 2U, "nan"},
+        {INFINITY, 2U, "inf"},
+        {-INFINITY, 2U, "-inf"},
+        {-0.0F, 2U, "-0.00"},
+        {0.999F, 2U, "1.00"},
+        {-9.9999F, 3U, "-10.000"},
+        {25.5F, 0U, "26"},
+        {25.5F, 12U, "25.500000000"},
+    };
+
+    uint32_t failed = 0U;
+    for (size_t index = 0UL; index < sizeof(cases) / sizeof(cases[0]);
+         ++index) {
+        char text[HOST_FORMAT_BENCH_TEXT_SIZE];
+        termo_format_float(text,
+                           sizeof(text),
+                           cases[index].value,
+                           cases[index].decimals);
+        if (strcmp(text, cases[index].expected) != 0) {
+            printf("special: %s came out as %s\n",
+                   cases[index].expected,
+                   text);
+            failed++;
+        }
+    }
+
+    char text[4];
+    if (termo_format_float(text, sizeof(text), 25.5F, 2U) != 0UL ||
+        text[0] != '\0') {
+        printf("special: 25.50 did not report a short buffer\n");
+        failed++;
+    }
+
+    return failed;
+}
+
+static void host_format_bench_cost(void)
+{
+    static float values[256];
+    for (size_t index = 0UL; index < sizeof(values) / sizeof(values[0]);
+         ++index) {
+        values[index] = -40.0F + (float)index * 0.6543F;
+    }
+
+    // the sink keeps the formatting from being optimized out
+    volatile char sink = '\0';
+    char text[HOST_FORMAT_BENCH_TEXT_SIZE];
+
+    uint64_t start = host_format_bench_get_ns();
+    for (uint32_t round = 0U; round < HOST_FORMAT_BENCH_ROUNDS; ++round) {
+        termo_format_float(text, sizeof(text), values[round & 255U], 2U);
+        sink = text[0];
+    }
+    uint64_t termo = host_format_bench_get_ns() - start;
+
+    start = host_format_bench_get_ns();
+    for (uint32_t round = 0U; round < HOST_FORMAT_BENCH_ROUNDS; ++round) {
+        snprintf(text, sizeof(text), "%.2f", (double)values[round & 255U]);
+        sink = text[0];
+    }
+    uint64_t libc = host_format_bench_get_ns() - start;
+    (void)sink;
+
+    printf("formatter, ns/value\n");
+    printf("termo_format_float, %.1f\n",
+           (double)termo / HOST_FORMAT_BENCH_ROUNDS);
+    printf("snprintf, %.1f\n", (double)libc / HOST_FORMAT_BENCH_ROUNDS);
+}
+
+int main(void)
+{
+    uint32_t failed = host_format_bench_special();
+    for (uint8_t decimals = 0U; decimals <= HOST_FORMAT_BENCH_GRID_DECIMALS;
+         ++decimals) {
+        failed += host_format_bench_grid(decimals);
+    }
+    failed += host_format_bench_sweep();
+
+    if (failed > 0U) {
+        printf("%u round trips failed\n", failed);
+        return 1;
+    }
+
+    host_format_bench_cost();
+
+    return 0;
+}
+
+#undef HOST_FORMAT_BENCH_GRID_DECIMALS
+#undef HOST_FORMAT_BENCH_GRID_STEPS
+#undef HOST_FORMAT_BENCH_SWEEP_STRIDE
+#undef HOST_FORMAT_BENCH_TEXT_SIZE
+#undef HOST_FORMAT_BENCH_ROUNDS
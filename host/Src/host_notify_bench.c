@@ -0,0 +1,136 @@
+#define _GNU_SOURCE
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+// the TERMO_DELAY(10) the task loops used to sleep between process() calls
+#define HOST_NOTIFY_BENCH_POLL_PERIOD (10U)
+#define HOST_NOTIFY_BENCH_EVENTS (200U)
+#define HOST_NOTIFY_BENCH_MAX_INTERVAL (10U)
+
+// one event in flight at a time, posted by the producer like a queue send
+// with its notify bit and taken by the task loop under test
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    bool is_notify;
+    bool is_pending;
+    bool is_done;
+    uint64_t posted;
+    uint64_t total;
+    uint64_t max;
+} host_notify_bench_t;
+
+static uint32_t host_notify_bench_seed = 2654435761U;
+
+static inline uint64_t host_notify_bench_get_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void host_notify_bench_sleep_ms(uint32_t ms)
+{
+    struct timespec ts = {.tv_sec = ms / 1000U,
+                          .tv_nsec = (long)(ms % 1000U) * 1000000L};
+    nanosleep(&ts, NULL);
+}
+
+static uint32_t host_notify_bench_random(void)
+{
+    host_notify_bench_seed ^= host_notify_bench_seed << 13U;
+    host_notify_bench_seed ^= host_notify_bench_seed >> 17U;
+    host_notify_bench_seed ^= host_notify_bench_seed << 5U;
+
+    return host_notify_bench_seed;
+}
+
+// polls every period like the old loops, or blocks until notified like
+// xTaskNotifyWait with portMAX_DELAY
+static void* host_notify_bench_task(void* argument)
+{
+    host_notify_bench_t* bench = argument;
+
+    pthread_mutex_lock(&bench->mutex);
+    while (!bench->is_done) {
+        if (bench->is_pending) {
+            uint64_t latency = host_notify_bench_get_ns() - bench->posted;
+            bench->total += latency;
+            bench->max = latency > bench->max ? latency : bench->max;
+            bench->is_pending = false;
+            pthread_cond_broadcast(&bench->cond);
+        }
+
+        if (bench->is_notify) {
+            pthread_cond_wait(&bench->cond, &bench->mutex);
+        } else {
+            pthread_mutex_unlock(&bench->mutex);
+            host_notify_bench_sleep_ms(HOST_NOTIFY_BENCH_POLL_PERIOD);
+            pthread_mutex_lock(&bench->mutex);
+        }
+    }
+    pthread_mutex_unlock(&bench->mutex);
+
+    return NULL;
+}
+
+// events at random times, so a polling loop catches them anywhere within
+// its period
+static double host_notify_bench_run(char const* name, bool is_notify)
+{
+    host_notify_bench_t bench = {.mutex = PTHREAD_MUTEX_INITIALIZER,
+                                 .cond = PTHREAD_COND_INITIALIZER,
+                                 .is_notify = is_notify};
+
+    pthread_t task;
+    pthread_create(&task, NULL, host_notify_bench_task, &bench);
+
+    for (uint32_t event = 0U; event < HOST_NOTIFY_BENCH_EVENTS; ++event) {
+        host_notify_bench_sleep_ms(
+            1U + host_notify_bench_random() % HOST_NOTIFY_BENCH_MAX_INTERVAL);
+
+        pthread_mutex_lock(&bench.mutex);
+        bench.posted = host_notify_bench_get_ns();
+        bench.is_pending = true;
+        pthread_cond_broadcast(&bench.cond);
+        while (bench.is_pending) {
+            pthread_cond_wait(&bench.cond, &bench.mutex);
+        }
+        pthread_mutex_unlock(&bench.mutex);
+    }
+
+    pthread_mutex_lock(&bench.mutex);
+    bench.is_done = true;
+    pthread_cond_broadcast(&bench.cond);
+    pthread_mutex_unlock(&bench.mutex);
+    pthread_join(task, NULL);
+
+    double mean_us =
+        (double)bench.total / (double)HOST_NOTIFY_BENCH_EVENTS / 1000.0;
+    printf("%s, %.1f, %.1f\n", name, mean_us, (double)bench.max / 1000.0);
+
+    return mean_us;
+}
+
+int main(void)
+{
+    printf("task loop, mean us, max us\n");
+    double poll_us = host_notify_bench_run("poll 10 ms", false);
+    double notify_us = host_notify_bench_run("notify", true);
+
+    if (notify_us >= poll_us) {
+        printf("notify no faster than polling\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+#undef HOST_NOTIFY_BENCH_POLL_PERIOD
+#undef HOST_NOTIFY_BENCH_EVENTS
+#undef HOST_NOTIFY_BENCH_MAX_INTERVAL
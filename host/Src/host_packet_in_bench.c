@@ -0,0 +1,252 @@
+#define _GNU_SOURCE
+
+#include "packet_in.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define HOST_PACKET_IN_BENCH_LINES (64U)
+#define HOST_PACKET_IN_BENCH_LINE_SIZE (160U)
+#define HOST_PACKET_IN_BENCH_ROUNDS (200000U)
+
+typedef struct {
+    char const* line;
+    packet_in_err_t err;
+} host_packet_in_bench_case_t;
+
+static inline uint64_t host_packet_in_bench_get_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static packet_in_err_t host_packet_in_bench_decode(char const* line,
+                                                   packet_in_t* packet)
+{
+    packet_in_decoder_t decoder;
+    packet_in_decoder_reset(&decoder);
+
+    packet_in_decoder_feed_buffer(&decoder, line, strcspn(line, "\n"));
+
+    return packet_in_decoder_finish(&decoder, packet);
+}
+
+static packet_in_err_t host_packet_in_bench_decode_bytes(char const* line,
+                                                         packet_in_t* packet)
+{
+    packet_in_decoder_t decoder;
+    packet_in_decoder_reset(&decoder);
+
+    for (char const* byte = line; *byte != '\0' && *byte != '\n'; ++byte) {
+        packet_in_decoder_feed(&decoder, *byte);
+    }
+
+    return packet_in_decoder_finish(&decoder, packet);
+}
+
+// the strstr and sscanf decoder this one replaced, kept for the comparison
+static float host_packet_in_bench_legacy_field(char const* str,
+                                               char const* key)
+{
+    char const* ptr = strstr(str, key);
+    if (ptr == NULL) {
+        return 0.0F;
+    }
+    ptr += strlen(key);
+    while (*ptr && (*ptr < '0' || *ptr > '9') && *ptr != '-' && *ptr != '.') {
+        ptr++;
+    }
+    return strtof(ptr, NULL);
+}
+
+static bool host_packet_in_bench_legacy_decode(char const* buffer,
+                                               size_t buffer_len,
+                                               packet_in_t* packet)
+{
+    if (strlen(buffer) != buffer_len) {
+        return false;
+    }
+
+    char const* str = strstr(buffer, "\"packet_type\"");
+    if (str == NULL) {
+        return false;
+    }
+
+    int type;
+    if (sscanf(str, "\"packet_type\": %d", &type) != 1) {
+        return false;
+    }
+    packet->type = (packet_in_type_t)type;
+
+    if (packet->type == PACKET_IN_TYPE_REFERENCE) {
+        str = strstr(buffer, "\"temperature\"");
+        if (str == NULL) {
+            return false;
+        }
+        packet->payload.reference.temperature =
+            host_packet_in_bench_legacy_field(str, "temperature");
+
+        str = strstr(buffer, "\"update_time\"");
+        if (str == NULL) {
+            return false;
+        }
+        packet->payload.reference.update_time =
+            host_packet_in_bench_legacy_field(str, "update_time");
+    }
+
+    return true;
+}
+
+static uint32_t host_packet_in_bench_check(void)
+{
+    static host_packet_in_bench_case_t const cases[] = {
+        {"{\"packet_type\": 0, \"packet_payload\": "
+         "{\"temperature\": 25.5, \"update_time\": 1}}",
+         PACKET_IN_ERR_OK},
+        {"{\"packet_type\": 0, \"packet_payload\": "
+         "{\"temperature\": 2.55e1, \"update_time\": 1E+0}}",
+         PACKET_IN_ERR_OK},
+        {"{\"packet_type\": 1, \"packet_payload\": {}, \"a\": true, "
+         "\"b\": false, \"c\": null}",
+         PACKET_IN_ERR_OK},
+        {"{\"packet_type\": 1, \"packet_payload\": {}, \"a\": [true, null]}",
+         PACKET_IN_ERR_OK},
+        {"{\"packet_type\": 1, \"packet_payload\": {}, \"a\": yes}",
+         PACKET_IN_ERR_SYNTAX},
+        {"{\"packet_type\": 1, \"packet_payload\": {}, \"a\": trve}",
+         PACKET_IN_ERR_SYNTAX},
+        {"{\"packet_type\": 1, \"packet_payload\": {}, \"a\": nul}",
+         PACKET_IN_ERR_SYNTAX},
+        {"{\"packet_type\": 1, \"packet_payload\": {}, \"a\": falsey}",
+         PACKET_IN_ERR_SYNTAX},
+        {"{\"packet_type\": 0, \"packet_payload\": "
+         "{\"temperature\": 1e}}",
+         PACKET_IN_ERR_NUMBER},
+        {"{\"packet_type\": 0, \"packet_payload\": "
+         "{\"temperature\": 1e+, \"update_time\": 1}}",
+         PACKET_IN_ERR_NUMBER},
+        {"{\"packet_type\": 0, \"packet_payload\": "
+         "{\"temperature\": 1., \"update_time\": 1}}",
+         PACKET_IN_ERR_NUMBER},
+        {"{\"packet_type\": 0, \"packet_payload\": "
+         "{\"temperature\": 1.e5, \"update_time\": 1}}",
+         PACKET_IN_ERR_NUMBER},
+        {"{\"packet_type\": 0, \"packet_payload\": "
+         "{\"temperature\": -, \"update_time\": 1}}",
+         PACKET_IN_ERR_NUMBER},
+        {"{\"packet_type\": 0, \"packet_payload\": {\"temperature\": 1}}",
+         PACKET_IN_ERR_MISSING_FIELD},
+        {"{\"packet_type\": 9, \"packet_payload\": {}}",
+         PACKET_IN_ERR_UNKNOWN_TYPE},
+        {"{\"packet_type\": 0, \"packet_payload\": "
+         "{\"temperature\": 25, \"update_time\": 1, \"rule\": 2}}",
+         PACKET_IN_ERR_FOREIGN_FIELD},
+        {"{\"packet_payload\": {\"temperature\": 25, \"update_time\": 1, "
+         "\"rule\": 2}, \"packet_type\": 0}",
+         PACKET_IN_ERR_FOREIGN_FIELD},
+        {"{\"packet_payload\": {\"temperature\": 25, \"update_time\": 1}, "
+         "\"packet_type\": 0}",
+         PACKET_IN_ERR_OK},
+        {"{\"packet_type\": 2, \"packet_payload\": "
+         "{\"setpoint\": 30, \"zone\": 1}}",
+         PACKET_IN_ERR_FOREIGN_FIELD},
+    };
+
+    uint32_t failed = 0U;
+    for (size_t index = 0UL; index < sizeof(cases) / sizeof(cases[0]);
+         ++index) {
+        packet_in_t packet;
+        packet_in_err_t err = host_packet_in_bench_decode(cases[index].line,
+                                                          &packet);
+        packet_in_err_t bytes_err =
+            host_packet_in_bench_decode_bytes(cases[index].line, &packet);
+        if (err != cases[index].err || bytes_err != err) {
+            printf("%s: got %s, expected %s\n",
+                   cases[index].line,
+                   packet_in_err_to_string(err),
+                   packet_in_err_to_string(cases[index].err));
+            failed++;
+        }
+    }
+
+    return failed;
+}
+
+static void host_packet_in_bench_cost(void)
+{
+    static char lines[HOST_PACKET_IN_BENCH_LINES]
+                     [HOST_PACKET_IN_BENCH_LINE_SIZE];
+    static size_t lengths[HOST_PACKET_IN_BENCH_LINES];
+
+    for (uint32_t index = 0U; index < HOST_PACKET_IN_BENCH_LINES; ++index) {
+        packet_in_t packet = {
+            .type = PACKET_IN_TYPE_REFERENCE,
+            .payload.reference = {.temperature = 20.0F + (float)index * 0.25F,
+                                  .update_time = 1.0F + (float)index,
+                                  .zone = index % 4U}};
+        packet_in_encode(&packet, lines[index], sizeof(lines[index]));
+        lengths[index] = strlen(lines[index]);
+    }
+
+    // the sink keeps the decodes from being optimized out
+    volatile float sink = 0.0F;
+    packet_in_t packet = {};
+
+    uint64_t start = host_packet_in_bench_get_ns();
+    for (uint32_t round = 0U; round < HOST_PACKET_IN_BENCH_ROUNDS; ++round) {
+        char const* line = lines[round % HOST_PACKET_IN_BENCH_LINES];
+        host_packet_in_bench_decode(line, &packet);
+        sink = packet.payload.reference.temperature;
+    }
+    uint64_t streaming = host_packet_in_bench_get_ns() - start;
+
+    start = host_packet_in_bench_get_ns();
+    for (uint32_t round = 0U; round < HOST_PACKET_IN_BENCH_ROUNDS; ++round) {
+        char const* line = lines[round % HOST_PACKET_IN_BENCH_LINES];
+        host_packet_in_bench_decode_bytes(line, &packet);
+        sink = packet.payload.reference.temperature;
+    }
+    uint64_t streaming_bytes = host_packet_in_bench_get_ns() - start;
+
+    start = host_packet_in_bench_get_ns();
+    for (uint32_t round = 0U; round < HOST_PACKET_IN_BENCH_ROUNDS; ++round) {
+        uint32_t index = round % HOST_PACKET_IN_BENCH_LINES;
+        host_packet_in_bench_legacy_decode(lines[index],
+                                           lengths[index],
+                                           &packet);
+        sink = packet.payload.reference.temperature;
+    }
+    uint64_t legacy = host_packet_in_bench_get_ns() - start;
+    (void)sink;
+
+    printf("decoder, ns/packet\n");
+    printf("streaming, %.1f\n",
+           (double)streaming / HOST_PACKET_IN_BENCH_ROUNDS);
+    printf("streaming a byte at a time, %.1f\n",
+           (double)streaming_bytes / HOST_PACKET_IN_BENCH_ROUNDS);
+    printf("strstr and sscanf, %.1f\n",
+           (double)legacy / HOST_PACKET_IN_BENCH_ROUNDS);
+}
+
+int main(void)
+{
+    uint32_t failed = host_packet_in_bench_check();
+    if (failed > 0U) {
+        printf("%u decoder cases failed\n", failed);
+        return 1;
+    }
+
+    host_packet_in_bench_cost();
+
+    return 0;
+}
+
+#undef HOST_PACKET_IN_BENCH_LINES
+#undef HOST_PACKET_IN_BENCH_LINE_SIZE
+#undef HOST_PACKET_IN_BENCH_ROUNDS
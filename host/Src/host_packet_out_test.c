@@ -0,0 +1,156 @@
+#include "packet_out.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifndef USE_BINARY_PACKETS
+#error "the packet out test checks the binary codec"
+#endif
+
+// samples a few hundred milliseconds apart, as the sensor delivers them
+#define HOST_PACKET_OUT_TEST_TIMESTAMP (123456U)
+#define HOST_PACKET_OUT_TEST_PERIOD (250U)
+
+static size_t host_packet_out_test_size(packet_out_t const* packet)
+{
+    static uint8_t buffer[PACKET_OUT_SIZE];
+
+    size_t encoded_len = 0UL;
+    if (!packet_out_encode(packet, &buffer, &encoded_len)) {
+        return 0UL;
+    }
+
+    return encoded_len;
+}
+
+static packet_out_t host_packet_out_test_batch(uint32_t count)
+{
+    packet_out_t packet = {.type = PACKET_OUT_TYPE_MEASURE_BATCH,
+                           .payload.measure_batch = {.count = count}};
+
+    for (uint32_t index = 0U; index < count; ++index) {
+        packet.payload.measure_batch.samples[index] =
+            (packet_out_measure_sample_t){
+                .timestamp = HOST_PACKET_OUT_TEST_TIMESTAMP +
+                             index * HOST_PACKET_OUT_TEST_PERIOD,
+                .temperature = 25.0F + 0.0625F * (float)index,
+                .pressure = 1013.25F,
+                .humidity = 40.5F};
+    }
+
+    return packet;
+}
+
+// the samples, timestamps included, have to come back as they went out
+static bool host_packet_out_test_round_trip(uint32_t count)
+{
+    static uint8_t buffer[PACKET_OUT_SIZE];
+
+    packet_out_t packet = host_packet_out_test_batch(count);
+    size_t encoded_len = 0UL;
+    packet_out_t decoded;
+    if (!packet_out_encode(&packet, &buffer, &encoded_len) ||
+        !packet_out_decode(&buffer, &decoded)) {
+        return false;
+    }
+
+    if (decoded.type != packet.type ||
+        decoded.payload.measure_batch.count != count) {
+        return false;
+    }
+
+    return memcmp(decoded.payload.measure_batch.samples,
+                  packet.payload.measure_batch.samples,
+                  count * sizeof(packet_out_measure_sample_t)) == 0;
+}
+
+// a frame of n batched samples against n frames of a single measure each
+static uint32_t host_packet_out_test_batch_size(void)
+{
+    packet_out_t measure = {.type = PACKET_OUT_TYPE_MEASURE};
+    size_t measure_size = host_packet_out_test_size(&measure);
+
+    uint32_t failed = 0U;
+    printf("samples, batch bytes, single measure bytes\n");
+    for (uint32_t count = 1U; count <= PACKET_OUT_MEASURE_BATCH_SIZE;
+         ++count) {
+        packet_out_t batch = host_packet_out_test_batch(count);
+        size_t batch_size = host_packet_out_test_size(&batch);
+        printf("%u, %zu, %zu\n", count, batch_size, count * measure_size);
+
+        if (batch_size == 0UL || batch_size >= PACKET_OUT_SIZE ||
+            !host_packet_out_test_round_trip(count)) {
+            printf("%u samples: bad frame\n", count);
+            failed++;
+        }
+    }
+
+    packet_out_t batch =
+        host_packet_out_test_batch(PACKET_OUT_MEASURE_BATCH_SIZE);
+    if (host_packet_out_test_size(&batch) >=
+        PACKET_OUT_MEASURE_BATCH_SIZE * measure_size) {
+        printf("a full batch is no smaller than its single measures\n");
+        failed++;
+    }
+
+    return failed;
+}
+
+// every type sends less than the whole union, a stats frame with no tasks
+// and no queues less than a full one
+static uint32_t host_packet_out_test_type_size(void)
+{
+    packet_out_t packets[] = {
+        {.type = PACKET_OUT_TYPE_MEASURE},
+        {.type = PACKET_OUT_TYPE_TRACE,
+         .payload.trace = {.count = PACKET_OUT_TRACE_BATCH_SIZE}},
+        {.type = PACKET_OUT_TYPE_STATS},
+        {.type = PACKET_OUT_TYPE_STATS,
+         .payload.stats = {.task_count = PACKET_OUT_STATS_TASK_NUM,
+                           .queue_count = PACKET_OUT_STATS_QUEUE_NUM}},
+        {.type = PACKET_OUT_TYPE_ESTIMATE},
+        {.type = PACKET_OUT_TYPE_AUTOTUNE},
+    };
+
+    uint32_t failed = 0U;
+    printf("type, bytes\n");
+    for (size_t index = 0UL; index < sizeof(packets) / sizeof(packets[0]);
+         ++index) {
+        size_t size = host_packet_out_test_size(&packets[index]);
+        printf("%u, %zu\n", packets[index].type, size);
+
+        if (size == 0UL || size > PACKET_OUT_SIZE) {
+            failed++;
+        }
+    }
+
+    if (host_packet_out_test_size(&packets[2]) >=
+        host_packet_out_test_size(&packets[3])) {
+        failed++;
+    }
+
+    packet_out_t unknown = {.type = (packet_out_type_t)0xFFU};
+    if (host_packet_out_test_size(&unknown) != 0UL) {
+        failed++;
+    }
+
+    return failed;
+}
+
+int main(void)
+{
+    uint32_t failed = host_packet_out_test_batch_size();
+    failed += host_packet_out_test_type_size();
+
+    if (failed > 0U) {
+        printf("%u packet out checks failed\n", failed);
+        return 1;
+    }
+
+    return 0;
+}
+
+#undef HOST_PACKET_OUT_TEST_TIMESTAMP
+#undef HOST_PACKET_OUT_TEST_PERIOD
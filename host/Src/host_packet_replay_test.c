@@ -0,0 +1,368 @@
+#include "packet_in.h"
+#include "packet_manager.h"
+#include "termo_ring.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define HOST_PACKET_REPLAY_TEST_SEEDS (64U)
+#define HOST_PACKET_REPLAY_TEST_PACKETS (500U)
+#define HOST_PACKET_REPLAY_TEST_LINE_SIZE (160U)
+#define HOST_PACKET_REPLAY_TEST_STREAM_SIZE \
+    (HOST_PACKET_REPLAY_TEST_PACKETS * HOST_PACKET_REPLAY_TEST_LINE_SIZE)
+
+#define HOST_PACKET_REPLAY_TEST_MAX_BURST (100U)
+
+// the dma buffer and the ring are the packet manager's own, so the replay
+// wraps and overruns where the firmware does
+typedef struct {
+    uint32_t seed;
+
+    char stream[HOST_PACKET_REPLAY_TEST_STREAM_SIZE];
+    size_t stream_size;
+    packet_in_t expected[HOST_PACKET_REPLAY_TEST_PACKETS];
+    size_t starts[HOST_PACKET_REPLAY_TEST_PACKETS];
+    size_t expected_count;
+    size_t garbage_count;
+
+    packet_manager_t manager;
+    size_t dma_position;
+
+    packet_in_t decoded[HOST_PACKET_REPLAY_TEST_PACKETS];
+    size_t decoded_count;
+} host_packet_replay_test_t;
+
+static uint32_t host_packet_replay_test_random(host_packet_replay_test_t* test)
+{
+    test->seed ^= test->seed << 13U;
+    test->seed ^= test->seed >> 17U;
+    test->seed ^= test->seed << 5U;
+
+    return test->seed;
+}
+
+static inline uint32_t host_packet_replay_test_range(
+    host_packet_replay_test_t* test,
+    uint32_t low,
+    uint32_t high)
+{
+    return low + host_packet_replay_test_random(test) % (high - low + 1U);
+}
+
+static packet_in_t host_packet_replay_test_packet(
+    host_packet_replay_test_t* test)
+{
+    switch (host_packet_replay_test_range(test, 0U, 2U)) {
+        case 0U: {
+            return (packet_in_t){
+                .type = PACKET_IN_TYPE_REFERENCE,
+                .payload.reference = {
+                    .temperature =
+                        (float)host_packet_replay_test_range(test, 0U, 4000U) /
+                        100.0F,
+                    .update_time =
+                        (float)host_packet_replay_test_range(test, 1U, 1000U) /
+                        100.0F,
+                    .zone = host_packet_replay_test_range(test, 0U, 3U)}};
+        }
+        case 1U: {
+            return (packet_in_t){.type = PACKET_IN_TYPE_TRACE_DUMP};
+        }
+        default: {
+            uint32_t setpoint = host_packet_replay_test_range(test, 250U, 350U);
+            uint32_t amplitude = host_packet_replay_test_range(test, 0U, 100U);
+            return (packet_in_t){
+                .type = PACKET_IN_TYPE_AUTOTUNE,
+                .payload.autotune = {
+                    .setpoint = (float)setpoint / 10.0F,
+                    .amplitude = (float)amplitude / 100.0F,
+                    .rule = host_packet_replay_test_range(test, 0U, 3U)}};
+        }
+    }
+}
+
+// valid packets with the odd garbage line in between, which the framing must
+// reject without losing the packet after it
+static void host_packet_replay_test_build(host_packet_replay_test_t* test)
+{
+    static char const* const garbage[] = {
+        "{\"packet_type\": 9, \"packet_payload\": {}}\n",
+        "{\"packet_type\": 0, \"packet_payload\": {\"zone\": 1}}\n",
+        "{\"packet_type\": 0, \"packet_payload\": {\"temperature\": 25, "
+        "\"update_time\": 1, \"rule\": 2}}\n",
+        "\x01\x02 not json at all\n",
+    };
+
+    test->stream_size = 0UL;
+    test->expected_count = 0UL;
+    test->garbage_count = 0UL;
+
+    while (test->expected_count < HOST_PACKET_REPLAY_TEST_PACKETS) {
+        char* line = test->stream + test->stream_size;
+        size_t free_size = sizeof(test->stream) - test->stream_size;
+
+        if (host_packet_replay_test_range(test, 0U, 9U) == 0U) {
+            char const* text =
+                garbage[host_packet_replay_test_random(test) %
+                        (sizeof(garbage) / sizeof(garbage[0]))];
+            if (strlen(text) >= free_size) {
+                break;
+            }
+            memcpy(line, text, strlen(text));
+            test->stream_size += strlen(text);
+            test->garbage_count++;
+            continue;
+        }
+
+        packet_in_t packet = host_packet_replay_test_packet(test);
+        if (!packet_in_encode(&packet, line, free_size)) {
+            break;
+        }
+        test->starts[test->expected_count] = test->stream_size;
+        test->stream_size += strlen(line);
+        test->expected[test->expected_count++] = packet;
+    }
+}
+
+static inline bool host_packet_replay_test_is_near(float left, float right)
+{
+    return fabsf(left - right) <= 1e-4F;
+}
+
+static bool host_packet_replay_test_is_equal(packet_in_t const* left,
+                                             packet_in_t const* right)
+{
+    if (left->type != right->type) {
+        return false;
+    }
+
+    switch (left->type) {
+        case PACKET_IN_TYPE_REFERENCE: {
+            return host_packet_replay_test_is_near(
+                       left->payload.reference.temperature,
+                       right->payload.reference.temperature) &&
+                   host_packet_replay_test_is_near(
+                       left->payload.reference.update_time,
+                       right->payload.reference.update_time) &&
+                   left->payload.reference.zone ==
+                       right->payload.reference.zone;
+        }
+        case PACKET_IN_TYPE_AUTOTUNE: {
+            return host_packet_replay_test_is_near(
+                       left->payload.autotune.setpoint,
+                       right->payload.autotune.setpoint) &&
+                   host_packet_replay_test_is_near(
+                       left->payload.autotune.amplitude,
+                       right->payload.autotune.amplitude) &&
+                   left->payload.autotune.rule == right->payload.autotune.rule;
+        }
+        default: {
+            return true;
+        }
+    }
+}
+
+// the drain of the rx complete handler, over the packet manager's framing
+static void host_packet_replay_test_drain(host_packet_replay_test_t* test)
+{
+    packet_manager_t* manager = &test->manager;
+
+    uint8_t chunk[sizeof(manager->receive_buffer)];
+    size_t chunk_size;
+    while ((chunk_size = termo_ring_read(
+                &manager->receive_ring,
+                chunk,
+                host_packet_replay_test_range(test, 1U, sizeof(chunk)))) >
+           0UL) {
+        size_t offset = 0UL;
+        while (offset < chunk_size) {
+            packet_in_t packet;
+            if (packet_manager_frame_packet_in(manager,
+                                               chunk,
+                                               chunk_size,
+                                               &offset,
+                                               &packet) &&
+                test->decoded_count < HOST_PACKET_REPLAY_TEST_PACKETS) {
+                test->decoded[test->decoded_count++] = packet;
+            }
+        }
+    }
+}
+
+// a burst of bytes through the circular dma - half and full transfer events
+// fire as the buffer fills, the idle line event ends the burst
+static void host_packet_replay_test_burst(host_packet_replay_test_t* test,
+                                          char const* data,
+                                          size_t size)
+{
+    packet_manager_t* manager = &test->manager;
+
+    for (size_t index = 0UL; index < size; ++index) {
+        manager->receive_buffer[test->dma_position++] = (uint8_t)data[index];
+
+        if (test->dma_position == sizeof(manager->receive_buffer) / 2U) {
+            packet_manager_receive_event(manager, test->dma_position);
+        } else if (test->dma_position == sizeof(manager->receive_buffer)) {
+            packet_manager_receive_event(manager, test->dma_position);
+            test->dma_position = 0UL;
+        }
+    }
+
+    if (test->dma_position != 0UL) {
+        packet_manager_receive_event(manager, test->dma_position);
+    }
+}
+
+// the receive state packet_manager_initialize and the start event leave
+static void host_packet_replay_test_reset(host_packet_replay_test_t* test,
+                                          uint32_t seed)
+{
+    packet_manager_t* manager = &test->manager;
+
+    test->seed = seed;
+    host_packet_replay_test_build(test);
+
+    memset(manager, 0, sizeof(*manager));
+    termo_ring_initialize(&manager->receive_ring,
+                          manager->receive_ring_storage,
+                          sizeof(manager->receive_ring_storage));
+    packet_in_decoder_reset(&manager->receive_decoder);
+    test->dma_position = 0UL;
+    test->decoded_count = 0UL;
+}
+
+// the packets from first on have to come out in order at the end of the
+// decoded ones
+static bool host_packet_replay_test_is_tail(host_packet_replay_test_t* test,
+                                            size_t first)
+{
+    size_t count = test->expected_count - first;
+    if (test->decoded_count < count) {
+        return false;
+    }
+
+    packet_in_t const* decoded =
+        &test->decoded[test->decoded_count - count];
+    for (size_t index = 0UL; index < count; ++index) {
+        if (!host_packet_replay_test_is_equal(&decoded[index],
+                                              &test->expected[first + index])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// the rest of the stream from offset on, in bursts of random size
+static void host_packet_replay_test_feed(host_packet_replay_test_t* test,
+                                         size_t offset)
+{
+    while (offset < test->stream_size) {
+        size_t size = host_packet_replay_test_range(
+            test,
+            1U,
+            HOST_PACKET_REPLAY_TEST_MAX_BURST);
+        if (size > test->stream_size - offset) {
+            size = test->stream_size - offset;
+        }
+        host_packet_replay_test_burst(test, test->stream + offset, size);
+        offset += size;
+
+        // the task runs late now and then, but never lets the ring fill up
+        if (host_packet_replay_test_range(test, 0U, 2U) == 0U ||
+            termo_ring_count(&test->manager.receive_ring) >
+                sizeof(test->manager.receive_ring_storage) / 2U) {
+            host_packet_replay_test_drain(test);
+        }
+    }
+    host_packet_replay_test_drain(test);
+}
+
+static bool host_packet_replay_test_run(host_packet_replay_test_t* test,
+                                        uint32_t seed)
+{
+    host_packet_replay_test_reset(test, seed);
+    host_packet_replay_test_feed(test, 0UL);
+
+    return test->manager.receive_dropped == 0UL &&
+           test->decoded_count == test->expected_count &&
+           test->manager.receive_invalid == test->garbage_count &&
+           host_packet_replay_test_is_tail(test, 0UL);
+}
+
+// the task stalls for twice the ring, the bytes that did not fit are dropped
+// and the line cut by them at worst decodes wrong - every packet sent after
+// the task is back has to come through
+static bool host_packet_replay_test_overrun(host_packet_replay_test_t* test,
+                                            uint32_t seed)
+{
+    host_packet_replay_test_reset(test, seed);
+
+    size_t stall_size = 2UL * sizeof(test->manager.receive_ring_storage);
+    size_t offset = 0UL;
+    while (offset < stall_size) {
+        size_t size = host_packet_replay_test_range(
+            test,
+            1U,
+            HOST_PACKET_REPLAY_TEST_MAX_BURST);
+        host_packet_replay_test_burst(test, test->stream + offset, size);
+        offset += size;
+    }
+    host_packet_replay_test_drain(test);
+
+    // the line cut at the drain runs on into the bytes from offset, the
+    // first one whole is the one starting after it
+    size_t first = 0UL;
+    while (first < test->expected_count && test->starts[first] <= offset) {
+        first++;
+    }
+
+    host_packet_replay_test_feed(test, offset);
+
+    return test->manager.receive_dropped > 0UL &&
+           test->decoded_count < test->expected_count &&
+           host_packet_replay_test_is_tail(test, first);
+}
+
+int main(void)
+{
+    static host_packet_replay_test_t test;
+
+    uint32_t failed = 0U;
+    for (uint32_t seed = 1U; seed <= HOST_PACKET_REPLAY_TEST_SEEDS; ++seed) {
+        if (!host_packet_replay_test_run(&test, seed * 2654435761U)) {
+            printf("seed %u: decoded %zu of %zu, invalid %zu of %zu, "
+                   "dropped %zu\n",
+                   seed,
+                   test.decoded_count,
+                   test.expected_count,
+                   test.manager.receive_invalid,
+                   test.garbage_count,
+                   test.manager.receive_dropped);
+            failed++;
+        }
+        if (!host_packet_replay_test_overrun(&test, seed * 2654435761U)) {
+            printf("seed %u overrun: decoded %zu of %zu, dropped %zu\n",
+                   seed,
+                   test.decoded_count,
+                   test.expected_count,
+                   test.manager.receive_dropped);
+            failed++;
+        }
+    }
+
+    printf("%u of %u replays passed\n",
+           2U * HOST_PACKET_REPLAY_TEST_SEEDS - failed,
+           2U * HOST_PACKET_REPLAY_TEST_SEEDS);
+
+    return failed == 0U ? 0 : 1;
+}
+
+#undef HOST_PACKET_REPLAY_TEST_SEEDS
+#undef HOST_PACKET_REPLAY_TEST_PACKETS
+#undef HOST_PACKET_REPLAY_TEST_LINE_SIZE
+#undef HOST_PACKET_REPLAY_TEST_STREAM_SIZE
+#undef HOST_PACKET_REPLAY_TEST_MAX_BURST
@@ -0,0 +1,64 @@
+#include "host_plant.h"
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+void host_plant_initialize(host_plant_t* plant,
+                           host_plant_params_t const* params)
+{
+    if (plant == NULL || params == NULL) {
+        return;
+    }
+
+    memset(plant, 0, sizeof(*plant));
+    plant->params = *params;
+    plant->temperature = params->ambient;
+}
+
+// first order plus dead time: the heater duty reaches the sensor after
+// dead_time and then settles with time_constant towards
+// ambient + gain * duty + disturbance
+void host_plant_step(host_plant_t* plant, float duty, uint32_t elapsed_time)
+{
+    if (plant == NULL || elapsed_time == 0U) {
+        return;
+    }
+
+    float step_time = (float)elapsed_time / 1000.0F;
+
+    uint32_t delay_len =
+        (uint32_t)lroundf(plant->params.dead_time / step_time);
+    if (delay_len >= HOST_PLANT_DELAY_LEN) {
+        delay_len = HOST_PLANT_DELAY_LEN - 1U;
+    }
+
+    plant->delay_line[plant->delay_index] = duty;
+    uint32_t delayed_index =
+        (plant->delay_index + HOST_PLANT_DELAY_LEN - delay_len) %
+        HOST_PLANT_DELAY_LEN;
+    float delayed_duty = plant->delay_line[delayed_index];
+    plant->delay_index = (plant->delay_index + 1U) % HOST_PLANT_DELAY_LEN;
+
+    float steady_temperature = plant->params.ambient +
+                               plant->params.gain * delayed_duty +
+                               plant->disturbance;
+    float alpha = plant->params.time_constant > 0.0F
+                      ? 1.0F - expf(-step_time / plant->params.time_constant)
+                      : 1.0F;
+
+    plant->temperature += alpha * (steady_temperature - plant->temperature);
+}
+
+void host_plant_set_disturbance(host_plant_t* plant, float disturbance)
+{
+    if (plant == NULL) {
+        return;
+    }
+
+    plant->disturbance = disturbance;
+}
+
+float host_plant_get_temperature(host_plant_t const* plant)
+{
+    return plant != NULL ? plant->temperature : 0.0F;
+}
@@ -0,0 +1,277 @@
+#include "host_scenario.h"
+#include "host_sim.h"
+#include "tim.h"
+#include <float.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#define HOST_SCENARIO_PACKET_LEN (128U)
+#define HOST_SCENARIO_RISE_FROM (0.1F)
+#define HOST_SCENARIO_RISE_TO (0.9F)
+
+static inline float host_scenario_get_reference(host_scenario_type_t type,
+                                                uint64_t time)
+{
+    if (time < HOST_SCENARIO_START_TIME) {
+        return NAN;
+    }
+
+    switch (type) {
+        case HOST_SCENARIO_TYPE_STEP:
+        case HOST_SCENARIO_TYPE_DISTURBANCE: {
+            return HOST_SCENARIO_STEP_REFERENCE;
+        }
+        case HOST_SCENARIO_TYPE_RAMP: {
+            uint64_t steps =
+                (time - HOST_SCENARIO_START_TIME) / HOST_SCENARIO_RAMP_PERIOD;
+            float reference = HOST_SCENARIO_RAMP_FROM +
+                              (float)steps * HOST_SCENARIO_RAMP_STEP;
+            return reference < HOST_SCENARIO_RAMP_TO ? reference
+                                                     : HOST_SCENARIO_RAMP_TO;
+        }
+        default: {
+            return NAN;
+        }
+    }
+}
+
+static inline float host_scenario_get_disturbance(host_scenario_type_t type,
+                                                  uint64_t time)
+{
+    return type == HOST_SCENARIO_TYPE_DISTURBANCE &&
+                   time >= HOST_SCENARIO_DISTURBANCE_TIME
+               ? HOST_SCENARIO_DISTURBANCE
+               : 0.0F;
+}
+
+static inline uint64_t host_scenario_timespec_to_ns(struct timespec const* ts)
+{
+    return (uint64_t)ts->tv_sec * 1000000000ULL + (uint64_t)ts->tv_nsec;
+}
+
+static void host_scenario_send_reference(float reference)
+{
+    char packet[HOST_SCENARIO_PACKET_LEN];
+    int packet_len = snprintf(packet,
+                              sizeof(packet),
+                              "{\"packet_type\":0,\"packet_payload\":{"
+                              "\"temperature\":%.3f,\"update_time\":%.3f}}\n",
+                              (double)reference,
+                              (double)HOST_SCENARIO_UPDATE_TIME);
+    if (packet_len > 0 && (size_t)packet_len < sizeof(packet)) {
+        host_usart_inject(packet, (size_t)packet_len);
+    }
+}
+
+static void host_scenario_open_window(host_scenario_t* scenario,
+                                      uint64_t time,
+                                      float temperature,
+                                      float target)
+{
+    scenario->has_window = true;
+    scenario->window_start = time;
+    scenario->window_from = temperature;
+    scenario->window_to = target;
+    scenario->rise_start = 0ULL;
+    scenario->rise_end = 0ULL;
+    scenario->peak_error = 0.0F;
+    scenario->last_outside = time;
+    scenario->iae = 0.0F;
+    scenario->max_error = 0.0F;
+}
+
+static void host_scenario_update_window(host_scenario_t* scenario,
+                                        uint64_t time,
+                                        uint32_t elapsed_time,
+                                        float temperature)
+{
+    float span = scenario->window_to - scenario->window_from;
+    float error = temperature - scenario->window_to;
+    bool has_span = fabsf(span) > FLT_EPSILON;
+
+    if (has_span) {
+        float progress = (temperature - scenario->window_from) / span;
+        if (scenario->rise_start == 0ULL &&
+            progress >= HOST_SCENARIO_RISE_FROM) {
+            scenario->rise_start = time;
+        }
+        if (scenario->rise_end == 0ULL && progress >= HOST_SCENARIO_RISE_TO) {
+            scenario->rise_end = time;
+        }
+    }
+
+    float peak_error = has_span ? copysignf(1.0F, span) * error : fabsf(error);
+    scenario->peak_error = fmaxf(scenario->peak_error, peak_error);
+
+    float band = fmaxf(HOST_SCENARIO_SETTLING_BAND * fabsf(span),
+                       HOST_SCENARIO_MIN_SETTLING_BAND);
+    if (fabsf(error) > band) {
+        scenario->last_outside = time;
+    }
+
+    float tracking_error = fabsf(scenario->reference - temperature);
+    scenario->iae += tracking_error * (float)elapsed_time / 1000.0F;
+    scenario->max_error = fmaxf(scenario->max_error, tracking_error);
+}
+
+static void host_scenario_get_result(host_scenario_t const* scenario,
+                                     host_scenario_result_t* result)
+{
+    float span = fabsf(scenario->window_to - scenario->window_from);
+
+    result->rise_time =
+        scenario->rise_start != 0ULL && scenario->rise_end != 0ULL
+            ? (float)(scenario->rise_end - scenario->rise_start) / 1000.0F
+            : -1.0F;
+    result->overshoot = fmaxf(scenario->peak_error, 0.0F);
+    result->overshoot_percent =
+        span > FLT_EPSILON ? 100.0F * result->overshoot / span : -1.0F;
+    result->settling_time =
+        (float)(scenario->last_outside - scenario->window_start) / 1000.0F;
+    result->iae = scenario->iae;
+    result->max_error = scenario->max_error;
+
+    result->control_steps =
+        host_tim_get_update_count(HOST_SIM_DELTA_TIMER) -
+        scenario->start_control_steps;
+
+    struct timespec cpu_time;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu_time);
+    uint64_t elapsed_cpu_time =
+        host_scenario_timespec_to_ns(&cpu_time) -
+        host_scenario_timespec_to_ns(&scenario->start_cpu_time);
+    result->process_cpu_time_per_step =
+        result->control_steps > 0ULL ? elapsed_cpu_time / result->control_steps
+                                     : 0ULL;
+}
+
+static void host_scenario_report(host_scenario_t const* scenario)
+{
+    host_scenario_result_t result;
+    host_scenario_get_result(scenario, &result);
+
+    fprintf(stderr,
+            "{\"scenario\":\"%s\",\"rise_time\":%.3f,\"overshoot\":%.3f,"
+            "\"overshoot_percent\":%.2f,\"settling_time\":%.3f,"
+            "\"iae\":%.3f,\"max_error\":%.3f,\"control_steps\":%llu,"
+            "\"process_cpu_ns_per_step\":%llu}\n",
+            host_scenario_type_to_string(scenario->type),
+            (double)result.rise_time,
+            (double)result.overshoot,
+            (double)result.overshoot_percent,
+            (double)result.settling_time,
+            (double)result.iae,
+            (double)result.max_error,
+            (unsigned long long)result.control_steps,
+            (unsigned long long)result.process_cpu_time_per_step);
+    fflush(stderr);
+}
+
+host_scenario_type_t host_scenario_type_from_string(char const* string)
+{
+    if (string == NULL) {
+        return HOST_SCENARIO_TYPE_NONE;
+    }
+
+    for (host_scenario_type_t type = HOST_SCENARIO_TYPE_STEP;
+         type <= HOST_SCENARIO_TYPE_DISTURBANCE;
+         ++type) {
+        if (strcmp(string, host_scenario_type_to_string(type)) == 0) {
+            return type;
+        }
+    }
+
+    return HOST_SCENARIO_TYPE_NONE;
+}
+
+char const* host_scenario_type_to_string(host_scenario_type_t type)
+{
+    switch (type) {
+        case HOST_SCENARIO_TYPE_STEP: {
+            return "step";
+        }
+        case HOST_SCENARIO_TYPE_RAMP: {
+            return "ramp";
+        }
+        case HOST_SCENARIO_TYPE_DISTURBANCE: {
+            return "disturbance";
+        }
+        default: {
+            return "none";
+        }
+    }
+}
+
+void host_scenario_initialize(host_scenario_t* scenario,
+                              host_scenario_type_t type)
+{
+    if (scenario == NULL) {
+        return;
+    }
+
+    memset(scenario, 0, sizeof(*scenario));
+    scenario->type = type;
+    scenario->start_control_steps =
+        host_tim_get_update_count(HOST_SIM_DELTA_TIMER);
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &scenario->start_cpu_time);
+}
+
+bool host_scenario_step(host_scenario_t* scenario,
+                        uint64_t time,
+                        uint32_t elapsed_time,
+                        float temperature,
+                        float* disturbance)
+{
+    if (scenario == NULL || scenario->type == HOST_SCENARIO_TYPE_NONE) {
+        return false;
+    }
+
+    float reference = host_scenario_get_reference(scenario->type, time);
+    if (!isnan(reference) &&
+        (!scenario->has_reference || reference != scenario->reference)) {
+        host_scenario_send_reference(reference);
+
+        if (!scenario->has_reference &&
+            scenario->type != HOST_SCENARIO_TYPE_DISTURBANCE) {
+            float target = scenario->type == HOST_SCENARIO_TYPE_RAMP
+                               ? HOST_SCENARIO_RAMP_TO
+                               : reference;
+            host_scenario_open_window(scenario, time, temperature, target);
+        }
+
+        scenario->has_reference = true;
+        scenario->reference = reference;
+    }
+
+    float new_disturbance =
+        host_scenario_get_disturbance(scenario->type, time);
+    if (new_disturbance != scenario->disturbance) {
+        scenario->disturbance = new_disturbance;
+        host_scenario_open_window(scenario,
+                                  time,
+                                  temperature,
+                                  scenario->reference);
+    }
+
+    if (disturbance != NULL) {
+        *disturbance = scenario->disturbance;
+    }
+
+    if (scenario->has_window) {
+        host_scenario_update_window(scenario, time, elapsed_time, temperature);
+    }
+
+    if (time < HOST_SCENARIO_START_TIME + HOST_SCENARIO_DURATION) {
+        return false;
+    }
+
+    host_scenario_report(scenario);
+
+    return true;
+}
+
+#undef HOST_SCENARIO_PACKET_LEN
+#undef HOST_SCENARIO_RISE_FROM
+#undef HOST_SCENARIO_RISE_TO
@@ -0,0 +1,129 @@
+#include "host_sim.h"
+#include "FreeRTOS.h"
+#include "host_plant.h"
+#include "host_scenario.h"
+#include "task.h"
+#include "tim.h"
+#include <stdlib.h>
+
+#define HOST_SIM_TASK_STACK_DEPTH (configMINIMAL_STACK_SIZE)
+#define HOST_SIM_TASK_NAME ("host_sim_task")
+#define HOST_SIM_TASK_PRIORITY (configMAX_PRIORITIES - 1UL)
+
+typedef struct {
+    uint32_t time_scale;
+    uint64_t time;
+    host_plant_t plant;
+    host_scenario_t scenario;
+} host_sim_t;
+
+static host_sim_t host_sim = {.time_scale = 1U};
+
+static float host_sim_get_env_float(char const* name, float default_value)
+{
+    char const* value = getenv(name);
+    if (value == NULL || *value == '\0') {
+        return default_value;
+    }
+
+    char* end = NULL;
+    float result = strtof(value, &end);
+
+    return end != value && *end == '\0' ? result : default_value;
+}
+
+static uint32_t host_sim_get_time_scale(void)
+{
+    float time_scale = host_sim_get_env_float(HOST_SIM_TIME_SCALE_ENV, 1.0F);
+    if (time_scale < 1.0F) {
+        return 1U;
+    }
+    if (time_scale > (float)HOST_SIM_MAX_TIME_SCALE) {
+        return HOST_SIM_MAX_TIME_SCALE;
+    }
+
+    return (uint32_t)time_scale;
+}
+
+static void host_sim_step_plant(host_sim_t* sim, uint32_t elapsed_time)
+{
+    float duty = host_tim_get_duty(HOST_SIM_PWM_TIMER, HOST_SIM_PWM_CHANNEL);
+    host_plant_step(&sim->plant, duty, elapsed_time);
+
+    float temperature = host_plant_get_temperature(&sim->plant);
+    host_i2c_set_temperature(temperature);
+
+    float disturbance = 0.0F;
+    if (host_scenario_step(&sim->scenario,
+                           sim->time,
+                           elapsed_time,
+                           temperature,
+                           &disturbance)) {
+        exit(EXIT_SUCCESS);
+    }
+    host_plant_set_disturbance(&sim->plant, disturbance);
+}
+
+// plays the role of the interrupt controller - peripheral models are
+// stepped here and raise their HAL callbacks above every firmware task,
+// the time scale only stretches the virtual time seen by the peripherals
+static void host_sim_task_func(void* ctx)
+{
+    host_sim_t* sim = (host_sim_t*)ctx;
+    uint32_t elapsed_time = HOST_SIM_STEP_TIME * sim->time_scale;
+
+    TickType_t wake_time = xTaskGetTickCount();
+
+    while (1) {
+        vTaskDelayUntil(&wake_time, pdMS_TO_TICKS(HOST_SIM_STEP_TIME));
+
+        sim->time += elapsed_time;
+
+        host_tim_step(elapsed_time);
+        host_sim_step_plant(sim, elapsed_time);
+        host_usart_step();
+        host_spi_step(elapsed_time);
+    }
+}
+
+void host_sim_initialize(void)
+{
+    static StaticTask_t host_sim_task_buffer;
+    static StackType_t host_sim_task_stack[HOST_SIM_TASK_STACK_DEPTH];
+
+    host_sim.time_scale = host_sim_get_time_scale();
+    host_sim.time = 0ULL;
+
+    host_plant_params_t params = {
+        .gain = host_sim_get_env_float(HOST_PLANT_GAIN_ENV, HOST_PLANT_GAIN),
+        .time_constant = host_sim_get_env_float(HOST_PLANT_TIME_CONSTANT_ENV,
+                                                HOST_PLANT_TIME_CONSTANT),
+        .dead_time = host_sim_get_env_float(HOST_PLANT_DEAD_TIME_ENV,
+                                            HOST_PLANT_DEAD_TIME),
+        .ambient = host_sim_get_env_float(HOST_PLANT_AMBIENT_ENV,
+                                          HOST_SIM_AMBIENT_TEMP),
+    };
+    host_plant_initialize(&host_sim.plant, &params);
+    host_i2c_set_temperature(host_plant_get_temperature(&host_sim.plant));
+
+    host_scenario_initialize(
+        &host_sim.scenario,
+        host_scenario_type_from_string(getenv(HOST_SCENARIO_ENV)));
+
+    xTaskCreateStatic(host_sim_task_func,
+                      HOST_SIM_TASK_NAME,
+                      HOST_SIM_TASK_STACK_DEPTH,
+                      &host_sim,
+                      HOST_SIM_TASK_PRIORITY,
+                      host_sim_task_stack,
+                      &host_sim_task_buffer);
+}
+
+uint64_t host_sim_get_time(void)
+{
+    return host_sim.time;
+}
+
+#undef HOST_SIM_TASK_STACK_DEPTH
+#undef HOST_SIM_TASK_NAME
+#undef HOST_SIM_TASK_PRIORITY
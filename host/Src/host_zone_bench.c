@@ -0,0 +1,187 @@
+#define _GNU_SOURCE
+
+#include "termo_zones.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#define HOST_ZONE_BENCH_STEPS (1000000U)
+#define HOST_ZONE_BENCH_WARMUP (10000U)
+#define HOST_ZONE_BENCH_CHECK_STEPS (2000U)
+
+// compares a zone may differ by from its own scalar pid, the rounding of
+// the float to compare conversion
+#define HOST_ZONE_BENCH_TOLERANCE (1U)
+
+// the scalar pid every zone has to follow on its own gains
+typedef struct {
+    float32_t integral;
+    float32_t error;
+} host_zone_bench_pid_t;
+
+static uint32_t host_zone_bench_seed = 2654435761U;
+
+static inline uint64_t host_zone_bench_timespec_to_ns(struct timespec const* ts)
+{
+    return (uint64_t)ts->tv_sec * 1000000000ULL + (uint64_t)ts->tv_nsec;
+}
+
+static inline uint64_t host_zone_bench_get_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return host_zone_bench_timespec_to_ns(&ts);
+}
+
+static float32_t host_zone_bench_random(void)
+{
+    host_zone_bench_seed ^= host_zone_bench_seed << 13U;
+    host_zone_bench_seed ^= host_zone_bench_seed >> 17U;
+    host_zone_bench_seed ^= host_zone_bench_seed << 5U;
+
+    return (float32_t)host_zone_bench_seed / 4294967296.0F;
+}
+
+// every zone gets gains of its own, scaled from the defaults of
+// main/config.h down to a back-calculated pid
+static termo_zones_config_t host_zone_bench_config(uint32_t count)
+{
+    termo_zones_config_t config = {.count = count,
+                                   .delta_time = 1.0F,
+                                   .min_control = 25.0F,
+                                   .max_control = 35.0F,
+                                   .min_compare = 0.0F,
+                                   .max_compare = 65535.0F};
+    for (uint32_t zone = 0U; zone < count; ++zone) {
+        config.kp[zone] = 100.0F / (float32_t)(zone + 1U);
+        config.ki[zone] = 0.1F * (float32_t)(zone % 4U);
+        config.kd[zone] = 2.0F * (float32_t)(zone % 3U);
+        config.kc[zone] = 0.25F * (float32_t)(zone % 5U);
+    }
+
+    return config;
+}
+
+static uint32_t host_zone_bench_pid_step(host_zone_bench_pid_t* pid,
+                                         termo_zones_config_t const* config,
+                                         uint32_t zone,
+                                         float32_t error)
+{
+    float32_t integral = pid->integral + config->ki[zone] * error;
+    float32_t control = config->kp[zone] * error + integral +
+                        config->kd[zone] * (error - pid->error);
+    float32_t saturated =
+        fminf(fmaxf(control, config->min_control), config->max_control);
+    float32_t compare_gain = (config->max_compare - config->min_compare) /
+                             (config->max_control - config->min_control);
+
+    pid->integral = integral + config->kc[zone] * (saturated - control);
+    pid->error = error;
+
+    return (uint32_t)(config->min_compare +
+                      compare_gain * (saturated - config->min_control));
+}
+
+// every zone of a full table, each with its own reference and measurement,
+// has to follow a scalar pid running on the same zone's gains
+static uint32_t host_zone_bench_check(void)
+{
+    static termo_zones_t zones;
+    static host_zone_bench_pid_t pids[TERMO_ZONES_NUM];
+
+    termo_zones_config_t config = host_zone_bench_config(TERMO_ZONES_NUM);
+    if (!termo_zones_initialize(&zones, &config)) {
+        printf("failed to initialize\n");
+        return 1U;
+    }
+
+    uint32_t worst = 0U;
+    for (uint32_t step = 0U; step < HOST_ZONE_BENCH_CHECK_STEPS; ++step) {
+        for (uint32_t zone = 0U; zone < TERMO_ZONES_NUM; ++zone) {
+            if (step % 200U == 0U) {
+                zones.references[zone] =
+                    25.0F + 10.0F * host_zone_bench_random();
+            }
+            zones.measurements[zone] =
+                zones.references[zone] + 4.0F * host_zone_bench_random() - 2.0F;
+        }
+
+        termo_zones_step(&zones);
+
+        for (uint32_t zone = 0U; zone < TERMO_ZONES_NUM; ++zone) {
+            uint32_t compare = host_zone_bench_pid_step(
+                &pids[zone],
+                &config,
+                zone,
+                zones.references[zone] - zones.measurements[zone]);
+            uint32_t difference = compare > zones.compares[zone]
+                                      ? compare - zones.compares[zone]
+                                      : zones.compares[zone] - compare;
+            if (difference > worst) {
+                worst = difference;
+            }
+        }
+    }
+
+    printf("per zone gains, worst difference %u\n", worst);
+
+    return worst > HOST_ZONE_BENCH_TOLERANCE ? 1U : 0U;
+}
+
+// every zone starts somewhere else so the saturation clamp takes both sides
+static void host_zone_bench_prepare(termo_zones_t* zones, uint32_t count)
+{
+    for (uint32_t zone = 0U; zone < count; ++zone) {
+        zones->references[zone] = 30.0F;
+        zones->measurements[zone] = 20.0F + (float)zone;
+    }
+}
+
+static double host_zone_bench_run(uint32_t count)
+{
+    static termo_zones_t zones;
+
+    termo_zones_config_t config = host_zone_bench_config(count);
+    if (!termo_zones_initialize(&zones, &config)) {
+        return 0.0;
+    }
+    host_zone_bench_prepare(&zones, count);
+
+    for (uint32_t step = 0U; step < HOST_ZONE_BENCH_WARMUP; ++step) {
+        termo_zones_step(&zones);
+    }
+
+    uint64_t start = host_zone_bench_get_ns();
+    for (uint32_t step = 0U; step < HOST_ZONE_BENCH_STEPS; ++step) {
+        termo_zones_step(&zones);
+        // keeps the compiler from folding the steps into one
+        __asm__ volatile("" : : "r"(zones.compares) : "memory");
+    }
+    uint64_t elapsed = host_zone_bench_get_ns() - start;
+
+    return (double)elapsed / (double)HOST_ZONE_BENCH_STEPS;
+}
+
+int main(void)
+{
+    if (host_zone_bench_check() > 0U) {
+        printf("zones differ from their own gains\n");
+        return 1;
+    }
+
+    printf("zones, ns/step, ns/zone\n");
+
+    for (uint32_t count = 1U; count <= TERMO_ZONES_NUM; ++count) {
+        double step_ns = host_zone_bench_run(count);
+        printf("%u, %.2f, %.2f\n", count, step_ns, step_ns / (double)count);
+    }
+
+    return 0;
+}
+
+#undef HOST_ZONE_BENCH_STEPS
+#undef HOST_ZONE_BENCH_WARMUP
+#undef HOST_ZONE_BENCH_CHECK_STEPS
+#undef HOST_ZONE_BENCH_TOLERANCE
@@ -0,0 +1,174 @@
+#include "i2c.h"
+#include "host_sim.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define HOST_MCP9808_ADDRESS (0x18U)
+#define HOST_MCP9808_ADDRESS_MASK (0x78U)
+#define HOST_MCP9808_REG_NUM (9U)
+#define HOST_MCP9808_REG_TEMP (0x05U)
+#define HOST_MCP9808_REG_MANUFACTURER_ID (0x06U)
+#define HOST_MCP9808_REG_DEVICE_ID (0x07U)
+#define HOST_MCP9808_REG_RESOLUTION (0x08U)
+#define HOST_MCP9808_TEMP_SCALE (16.0F)
+#define HOST_MCP9808_TEMP_MASK (0x1FFFU)
+
+I2C_TypeDef host_i2c1 = {};
+
+I2C_HandleTypeDef hi2c1 = {};
+
+static uint16_t host_mcp9808_regs[HOST_MCP9808_REG_NUM] = {
+    [HOST_MCP9808_REG_MANUFACTURER_ID] = 0x0054U,
+    [HOST_MCP9808_REG_DEVICE_ID] = 0x0400U,
+    [HOST_MCP9808_REG_RESOLUTION] = 0x0003U,
+};
+
+static float host_i2c_temperature = HOST_SIM_AMBIENT_TEMP;
+
+static inline bool host_i2c_is_mcp9808(I2C_HandleTypeDef const* hi2c,
+                                       uint16_t address)
+{
+    return hi2c != NULL && hi2c->Instance == I2C1 &&
+           ((address >> 1U) & HOST_MCP9808_ADDRESS_MASK) ==
+               HOST_MCP9808_ADDRESS;
+}
+
+static inline uint16_t host_mcp9808_read_reg(uint16_t reg)
+{
+    if (reg == HOST_MCP9808_REG_TEMP) {
+        int32_t raw = (int32_t)lroundf(host_i2c_temperature *
+                                       HOST_MCP9808_TEMP_SCALE);
+        return (uint16_t)((uint32_t)raw & HOST_MCP9808_TEMP_MASK);
+    }
+
+    return host_mcp9808_regs[reg];
+}
+
+static inline void host_mcp9808_write_reg(uint16_t reg, uint16_t value)
+{
+    if (reg == HOST_MCP9808_REG_TEMP ||
+        reg == HOST_MCP9808_REG_MANUFACTURER_ID ||
+        reg == HOST_MCP9808_REG_DEVICE_ID) {
+        return;
+    }
+
+    host_mcp9808_regs[reg] = value;
+}
+
+void MX_I2C1_Init(void)
+{
+    hi2c1.Instance = I2C1;
+    hi2c1.Init.Timing = 0x10909CEC;
+    hi2c1.Init.OwnAddress1 = 0;
+}
+
+HAL_StatusTypeDef HAL_I2C_IsDeviceReady(I2C_HandleTypeDef* hi2c,
+                                        uint16_t address,
+                                        uint32_t trials,
+                                        uint32_t timeout)
+{
+    return host_i2c_is_mcp9808(hi2c, address) ? HAL_OK : HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef* hi2c,
+                                    uint16_t address,
+                                    uint16_t mem_address,
+                                    uint16_t mem_address_size,
+                                    uint8_t* data,
+                                    uint16_t size,
+                                    uint32_t timeout)
+{
+    if (!host_i2c_is_mcp9808(hi2c, address) ||
+        mem_address >= HOST_MCP9808_REG_NUM || data == NULL || size == 0U) {
+        return HAL_ERROR;
+    }
+
+    uint16_t value =
+        size == 1U ? data[0] : (uint16_t)((data[0] << 8U) | data[1]);
+    host_mcp9808_write_reg(mem_address, value);
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef* hi2c,
+                                   uint16_t address,
+                                   uint16_t mem_address,
+                                   uint16_t mem_address_size,
+                                   uint8_t* data,
+                                   uint16_t size,
+                                   uint32_t timeout)
+{
+    if (!host_i2c_is_mcp9808(hi2c, address) ||
+        mem_address >= HOST_MCP9808_REG_NUM || data == NULL || size == 0U) {
+        return HAL_ERROR;
+    }
+
+    uint16_t value = host_mcp9808_read_reg(mem_address);
+    if (size == 1U) {
+        data[0] = (uint8_t)(value & 0xFFU);
+        return HAL_OK;
+    }
+
+    data[0] = (uint8_t)(value >> 8U);
+    data[1] = (uint8_t)(value & 0xFFU);
+    for (uint16_t index = 2U; index < size; ++index) {
+        data[index] = 0U;
+    }
+
+    return HAL_OK;
+}
+
+// completes on the spot, like the other host transfers
+HAL_StatusTypeDef HAL_I2C_Mem_Read_IT(I2C_HandleTypeDef* hi2c,
+                                      uint16_t address,
+                                      uint16_t mem_address,
+                                      uint16_t mem_address_size,
+                                      uint8_t* data,
+                                      uint16_t size)
+{
+    if (HAL_I2C_Mem_Read(hi2c,
+                         address,
+                         mem_address,
+                         mem_address_size,
+                         data,
+                         size,
+                         0U) != HAL_OK) {
+        HAL_I2C_ErrorCallback(hi2c);
+        return HAL_OK;
+    }
+
+    HAL_I2C_MemRxCpltCallback(hi2c);
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef* hi2c)
+{
+    return hi2c != NULL && hi2c->Instance == I2C1 ? HAL_OK : HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef* hi2c)
+{
+    return hi2c != NULL && hi2c->Instance == I2C1 ? HAL_OK : HAL_ERROR;
+}
+
+void host_i2c_set_temperature(float temperature)
+{
+    host_i2c_temperature = temperature;
+}
+
+float host_i2c_get_temperature(void)
+{
+    return host_i2c_temperature;
+}
+
+#undef HOST_MCP9808_ADDRESS
+#undef HOST_MCP9808_ADDRESS_MASK
+#undef HOST_MCP9808_REG_NUM
+#undef HOST_MCP9808_REG_TEMP
+#undef HOST_MCP9808_REG_MANUFACTURER_ID
+#undef HOST_MCP9808_REG_DEVICE_ID
+#undef HOST_MCP9808_REG_RESOLUTION
+#undef HOST_MCP9808_TEMP_SCALE
+#undef HOST_MCP9808_TEMP_MASK
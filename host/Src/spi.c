@@ -0,0 +1,190 @@
+#include "spi.h"
+#include "host_sim.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define HOST_SH1107_WIDTH (128U)
+#define HOST_SH1107_HEIGHT (128U)
+#define HOST_SH1107_PAGE_HEIGHT (8U)
+#define HOST_SH1107_PAGE_NUM (HOST_SH1107_HEIGHT / HOST_SH1107_PAGE_HEIGHT)
+#define HOST_SH1107_PATH_LEN (256U)
+
+typedef struct {
+    uint8_t ram[HOST_SH1107_PAGE_NUM][HOST_SH1107_WIDTH];
+    uint8_t page;
+    uint8_t column;
+    bool has_argument;
+    bool is_dirty;
+    uint32_t frame_index;
+    uint32_t frame_elapsed_time;
+    char const* frame_dir;
+} host_sh1107_t;
+
+SPI_TypeDef host_spi1 = {};
+
+SPI_HandleTypeDef hspi1 = {};
+
+static host_sh1107_t host_sh1107 = {};
+
+static inline bool host_sh1107_is_double_command(uint8_t command)
+{
+    switch (command) {
+        case 0x81U:
+        case 0xA8U:
+        case 0xADU:
+        case 0xD3U:
+        case 0xD5U:
+        case 0xD9U:
+        case 0xDBU:
+        case 0xDCU: {
+            return true;
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+static void host_sh1107_write_command(host_sh1107_t* sh1107, uint8_t command)
+{
+    if (sh1107->has_argument) {
+        sh1107->has_argument = false;
+        return;
+    }
+
+    if ((command & 0xF0U) == 0xB0U) {
+        sh1107->page = command & 0x0FU;
+    } else if ((command & 0xF0U) == 0x00U) {
+        sh1107->column = (sh1107->column & 0x70U) | (command & 0x0FU);
+    } else if ((command & 0xF8U) == 0x10U) {
+        sh1107->column =
+            (uint8_t)((sh1107->column & 0x0FU) | ((command & 0x07U) << 4U));
+    } else if (host_sh1107_is_double_command(command)) {
+        sh1107->has_argument = true;
+    }
+}
+
+static void host_sh1107_write_data(host_sh1107_t* sh1107, uint8_t data)
+{
+    if (sh1107->page >= HOST_SH1107_PAGE_NUM ||
+        sh1107->column >= HOST_SH1107_WIDTH) {
+        return;
+    }
+
+    if (sh1107->ram[sh1107->page][sh1107->column] != data) {
+        sh1107->ram[sh1107->page][sh1107->column] = data;
+        sh1107->is_dirty = true;
+    }
+    sh1107->column++;
+}
+
+static void host_sh1107_write(host_sh1107_t* sh1107,
+                              uint8_t const* data,
+                              uint16_t size)
+{
+    bool is_data = (SH1107_CONTROL_GPIO_Port->ODR & SH1107_CONTROL_Pin) != 0U;
+
+    for (uint16_t index = 0U; index < size; ++index) {
+        if (is_data) {
+            host_sh1107_write_data(sh1107, data[index]);
+        } else {
+            host_sh1107_write_command(sh1107, data[index]);
+        }
+    }
+}
+
+static void host_sh1107_dump_frame(host_sh1107_t* sh1107)
+{
+    char path[HOST_SH1107_PATH_LEN];
+    snprintf(path,
+             sizeof(path),
+             "%s/frame_%06u.pbm",
+             sh1107->frame_dir,
+             (unsigned)sh1107->frame_index);
+
+    FILE* file = fopen(path, "wb");
+    if (file == NULL) {
+        return;
+    }
+
+    fprintf(file, "P4\n%u %u\n", HOST_SH1107_WIDTH, HOST_SH1107_HEIGHT);
+    for (uint32_t y = 0U; y < HOST_SH1107_HEIGHT; ++y) {
+        uint8_t const* page = sh1107->ram[y / HOST_SH1107_PAGE_HEIGHT];
+        uint8_t bit = (uint8_t)(y % HOST_SH1107_PAGE_HEIGHT);
+
+        for (uint32_t x = 0U; x < HOST_SH1107_WIDTH; x += 8U) {
+            uint8_t row = 0U;
+            for (uint32_t offset = 0U; offset < 8U; ++offset) {
+                row = (uint8_t)(row << 1U) | ((page[x + offset] >> bit) & 1U);
+            }
+            fputc(row, file);
+        }
+    }
+
+    fclose(file);
+
+    sh1107->frame_index++;
+}
+
+void MX_SPI1_Init(void)
+{
+    hspi1.Instance = SPI1;
+    hspi1.Init.Mode = 0;
+    hspi1.Init.BaudRatePrescaler = 0;
+
+    host_sh1107.frame_dir = getenv(HOST_SIM_FRAME_DIR_ENV);
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef* hspi,
+                                   uint8_t const* data,
+                                   uint16_t size,
+                                   uint32_t timeout)
+{
+    if (hspi == NULL || hspi->Instance != SPI1 || data == NULL) {
+        return HAL_ERROR;
+    }
+
+    host_sh1107_write(&host_sh1107, data, size);
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef* hspi,
+                                       uint8_t const* data,
+                                       uint16_t size)
+{
+    if (HAL_SPI_Transmit(hspi, data, size, 0U) != HAL_OK) {
+        return HAL_ERROR;
+    }
+
+    HAL_SPI_TxCpltCallback(hspi);
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_Abort(SPI_HandleTypeDef* hspi)
+{
+    return hspi != NULL ? HAL_OK : HAL_ERROR;
+}
+
+void host_spi_step(uint32_t elapsed_time)
+{
+    host_sh1107.frame_elapsed_time += elapsed_time;
+
+    if (host_sh1107.frame_dir == NULL || !host_sh1107.is_dirty ||
+        host_sh1107.frame_elapsed_time < HOST_SIM_FRAME_PERIOD) {
+        return;
+    }
+
+    host_sh1107_dump_frame(&host_sh1107);
+    host_sh1107.is_dirty = false;
+    host_sh1107.frame_elapsed_time = 0U;
+}
+
+#undef HOST_SH1107_WIDTH
+#undef HOST_SH1107_HEIGHT
+#undef HOST_SH1107_PAGE_HEIGHT
+#undef HOST_SH1107_PAGE_NUM
+#undef HOST_SH1107_PATH_LEN
@@ -0,0 +1,95 @@
+#include "stm32l4xx_hal.h"
+#include "FreeRTOS.h"
+#include "host_sim.h"
+#include "task.h"
+#include "tim.h"
+#include <unistd.h>
+
+RCC_TypeDef host_rcc = {};
+LPTIM_TypeDef host_lptim1 = {};
+EXTI_TypeDef host_exti = {};
+SysTick_Type host_systick = {};
+
+__IO uint32_t uwTick = 0UL;
+
+static void host_hal_init_tick(void)
+{
+    htim1.Instance = TIM1;
+    htim1.Init.Prescaler = (uint32_t)((HOST_SIM_PCLK1_HZ / 1000000U) - 1U);
+    htim1.Init.Period = (1000000U / 1000U) - 1U;
+    htim1.Init.CounterMode = TIM_COUNTERMODE_UP;
+    htim1.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+
+    htim1.Instance->PSC = htim1.Init.Prescaler;
+    htim1.Instance->ARR = htim1.Init.Period;
+    HAL_TIM_Base_Start_IT(&htim1);
+}
+
+HAL_StatusTypeDef HAL_Init(void)
+{
+    host_hal_init_tick();
+    host_sim_initialize();
+
+    return HAL_OK;
+}
+
+void HAL_IncTick(void)
+{
+    uwTick += 1UL;
+}
+
+uint32_t HAL_GetTick(void)
+{
+    return uwTick;
+}
+
+void HAL_Delay(uint32_t delay)
+{
+    if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) {
+        vTaskDelay(pdMS_TO_TICKS(delay));
+    } else {
+        usleep(delay * 1000U);
+    }
+}
+
+void HAL_SuspendTick(void)
+{}
+
+void HAL_ResumeTick(void)
+{}
+
+uint32_t HAL_RCC_GetPCLK1Freq(void)
+{
+    return HOST_SIM_PCLK1_HZ;
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type irqn)
+{}
+
+void HAL_NVIC_DisableIRQ(IRQn_Type irqn)
+{}
+
+void HAL_PWREx_EnterSTOP2Mode(uint8_t entry)
+{}
+
+[[gnu::weak]] void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef* htim)
+{}
+
+[[gnu::weak]] void HAL_TIM_PWM_PulseFinishedCallback(TIM_HandleTypeDef* htim)
+{}
+
+[[gnu::weak]] void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef* hspi)
+{}
+
+[[gnu::weak]] void HAL_SPI_ErrorCallback(SPI_HandleTypeDef* hspi)
+{}
+
+[[gnu::weak]] void HAL_UART_TxCpltCallback(UART_HandleTypeDef* huart)
+{}
+
+[[gnu::weak]] void HAL_UART_ErrorCallback(UART_HandleTypeDef* huart)
+{}
+
+[[gnu::weak]] void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef* huart,
+                                              uint16_t size)
+{}
@@ -0,0 +1,32 @@
+#include <errno.h>
+#include <stddef.h>
+#include <unistd.h>
+
+int _write(int file, char* ptr, int len);
+
+int _write(int file, char* ptr, int len)
+{
+    if (ptr == NULL || len <= 0) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    if (file != STDOUT_FILENO && file != STDERR_FILENO) {
+        errno = EBADF;
+        return -1;
+    }
+
+    int written_len = 0;
+    while (written_len < len) {
+        ssize_t result = write(file, ptr + written_len, len - written_len);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        written_len += (int)result;
+    }
+
+    return written_len;
+}
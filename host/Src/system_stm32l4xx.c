@@ -0,0 +1,15 @@
+#include "main.h"
+#include "host_sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+uint32_t SystemCoreClock = HOST_SIM_PCLK1_HZ;
+
+void SystemClock_Config(void)
+{}
+
+void Error_Handler(void)
+{
+    fprintf(stderr, "Error_Handler\n");
+    abort();
+}
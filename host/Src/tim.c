@@ -0,0 +1,212 @@
+#include "tim.h"
+#include "host_sim.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+#define HOST_TIM_CHANNEL_INDEX(CHANNEL) ((CHANNEL) >> 2U)
+#define HOST_TIM_CHANNEL_IE(CHANNEL) \
+    (TIM_DIER_CC1IE << HOST_TIM_CHANNEL_INDEX(CHANNEL))
+#define HOST_TIM_CHANNELS_IE (0xFUL << 1U)
+
+typedef struct {
+    TIM_HandleTypeDef* htim;
+    uint64_t residue;
+    uint64_t update_count;
+} host_tim_t;
+
+TIM_TypeDef host_tim1 = {};
+TIM_TypeDef host_tim2 = {};
+TIM_TypeDef host_tim3 = {};
+TIM_TypeDef host_tim4 = {};
+
+TIM_HandleTypeDef htim1 = {};
+TIM_HandleTypeDef htim2 = {};
+TIM_HandleTypeDef htim3 = {};
+TIM_HandleTypeDef htim4 = {};
+
+static host_tim_t host_tims[] = {
+    {.htim = &htim1},
+    {.htim = &htim2},
+    {.htim = &htim3},
+    {.htim = &htim4},
+};
+
+static inline void host_tim_init(TIM_HandleTypeDef* htim)
+{
+    htim->Instance->CR1 = 0UL;
+    htim->Instance->DIER = 0UL;
+    htim->Instance->CNT = 0UL;
+    htim->Instance->PSC = htim->Init.Prescaler;
+    htim->Instance->ARR = htim->Init.Period;
+}
+
+static inline uint32_t host_tim_get_compare(TIM_TypeDef const* instance,
+                                            size_t index)
+{
+    return (&instance->CCR1)[index];
+}
+
+static void host_tim_step_timer(host_tim_t* tim, uint32_t elapsed_time)
+{
+    TIM_TypeDef* instance = tim->htim->Instance;
+    if ((instance->CR1 & TIM_CR1_CEN) == 0UL) {
+        return;
+    }
+
+    uint64_t divider = 1000ULL * (instance->PSC + 1ULL);
+    tim->residue += (uint64_t)HOST_SIM_PCLK1_HZ * elapsed_time;
+    uint64_t counts = tim->residue / divider;
+    tim->residue %= divider;
+
+    uint64_t period = instance->ARR + 1ULL;
+    uint64_t old_count = instance->CNT;
+    uint64_t new_count = old_count + counts;
+    uint64_t updates = new_count / period;
+    instance->CNT = (uint32_t)(new_count % period);
+    tim->update_count += updates;
+
+    if ((instance->DIER & TIM_DIER_UIE) == TIM_DIER_UIE) {
+        for (uint64_t update = 0ULL; update < updates; ++update) {
+            HAL_TIM_PeriodElapsedCallback(tim->htim);
+        }
+    }
+
+    for (size_t index = 0UL; index < 4UL; ++index) {
+        if ((instance->DIER & (TIM_DIER_CC1IE << index)) == 0UL) {
+            continue;
+        }
+
+        uint32_t compare = host_tim_get_compare(instance, index);
+        if (updates > 0ULL || (old_count < compare && new_count >= compare)) {
+            HAL_TIM_PWM_PulseFinishedCallback(tim->htim);
+        }
+    }
+}
+
+void MX_TIM2_Init(void)
+{
+    htim2.Instance = TIM2;
+    htim2.Init.Prescaler = 1279;
+    htim2.Init.CounterMode = TIM_COUNTERMODE_UP;
+    htim2.Init.Period = 62499;
+    htim2.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    host_tim_init(&htim2);
+}
+
+void MX_TIM3_Init(void)
+{
+    htim3.Instance = TIM3;
+    htim3.Init.Prescaler = 0;
+    htim3.Init.CounterMode = TIM_COUNTERMODE_UP;
+    htim3.Init.Period = 49999;
+    htim3.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    host_tim_init(&htim3);
+}
+
+void MX_TIM4_Init(void)
+{
+    htim4.Instance = TIM4;
+    htim4.Init.Prescaler = 1279;
+    htim4.Init.CounterMode = TIM_COUNTERMODE_UP;
+    htim4.Init.Period = 62499;
+    htim4.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    host_tim_init(&htim4);
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef* htim)
+{
+    if (htim == NULL || htim->Instance == NULL) {
+        return HAL_ERROR;
+    }
+
+    htim->Instance->DIER |= TIM_DIER_UIE;
+    htim->Instance->CR1 |= TIM_CR1_CEN;
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef* htim)
+{
+    if (htim == NULL || htim->Instance == NULL) {
+        return HAL_ERROR;
+    }
+
+    htim->Instance->DIER &= ~TIM_DIER_UIE;
+    if ((htim->Instance->DIER & HOST_TIM_CHANNELS_IE) == 0UL) {
+        htim->Instance->CR1 &= ~TIM_CR1_CEN;
+    }
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Start_IT(TIM_HandleTypeDef* htim,
+                                       uint32_t channel)
+{
+    if (htim == NULL || htim->Instance == NULL || channel > TIM_CHANNEL_4) {
+        return HAL_ERROR;
+    }
+
+    htim->Instance->DIER |= HOST_TIM_CHANNEL_IE(channel);
+    htim->Instance->CR1 |= TIM_CR1_CEN;
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Stop_IT(TIM_HandleTypeDef* htim,
+                                      uint32_t channel)
+{
+    if (htim == NULL || htim->Instance == NULL || channel > TIM_CHANNEL_4) {
+        return HAL_ERROR;
+    }
+
+    htim->Instance->DIER &= ~HOST_TIM_CHANNEL_IE(channel);
+    if ((htim->Instance->DIER & (HOST_TIM_CHANNELS_IE | TIM_DIER_UIE)) ==
+        0UL) {
+        htim->Instance->CR1 &= ~TIM_CR1_CEN;
+    }
+
+    return HAL_OK;
+}
+
+void host_tim_step(uint32_t elapsed_time)
+{
+    size_t tim_num = sizeof(host_tims) / sizeof(*host_tims);
+    for (size_t index = 0UL; index < tim_num; ++index) {
+        host_tim_step_timer(&host_tims[index], elapsed_time);
+    }
+}
+
+float host_tim_get_duty(TIM_HandleTypeDef const* htim, uint32_t channel)
+{
+    if (htim == NULL || htim->Instance == NULL || channel > TIM_CHANNEL_4) {
+        return 0.0F;
+    }
+
+    TIM_TypeDef const* instance = htim->Instance;
+    if ((instance->CR1 & TIM_CR1_CEN) == 0UL ||
+        (instance->DIER & HOST_TIM_CHANNEL_IE(channel)) == 0UL) {
+        return 0.0F;
+    }
+
+    uint32_t compare =
+        host_tim_get_compare(instance, HOST_TIM_CHANNEL_INDEX(channel));
+    uint32_t period = instance->ARR + 1UL;
+
+    return compare >= period ? 1.0F : (float)compare / (float)period;
+}
+
+uint64_t host_tim_get_update_count(TIM_HandleTypeDef const* htim)
+{
+    size_t tim_num = sizeof(host_tims) / sizeof(*host_tims);
+    for (size_t index = 0UL; index < tim_num; ++index) {
+        if (host_tims[index].htim == htim) {
+            return host_tims[index].update_count;
+        }
+    }
+
+    return 0ULL;
+}
+
+#undef HOST_TIM_CHANNEL_INDEX
+#undef HOST_TIM_CHANNEL_IE
+#undef HOST_TIM_CHANNELS_IE
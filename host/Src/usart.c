@@ -0,0 +1,279 @@
+#define _GNU_SOURCE
+
+#include "usart.h"
+#include "host_sim.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#define HOST_USART_PTY_NAME_LEN (64U)
+#define HOST_USART_INJECT_LEN (256U)
+
+typedef struct {
+    int master_fd;
+    int slave_fd;
+    char pty_name[HOST_USART_PTY_NAME_LEN];
+    uint8_t* receive_data;
+    uint16_t receive_size;
+    uint16_t receive_position;
+    char inject_data[HOST_USART_INJECT_LEN];
+    size_t inject_size;
+} host_usart_t;
+
+USART_TypeDef host_usart1 = {};
+USART_TypeDef host_usart2 = {};
+
+UART_HandleTypeDef huart1 = {};
+UART_HandleTypeDef huart2 = {};
+
+static host_usart_t host_usart = {.master_fd = -1, .slave_fd = -1};
+
+static bool host_usart_open_pty(host_usart_t* usart)
+{
+    usart->master_fd = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (usart->master_fd < 0) {
+        return false;
+    }
+
+    if (grantpt(usart->master_fd) != 0 || unlockpt(usart->master_fd) != 0 ||
+        ptsname_r(usart->master_fd,
+                  usart->pty_name,
+                  sizeof(usart->pty_name)) != 0) {
+        return false;
+    }
+
+    // keeping the slave open avoids EIO on the master while no client is
+    // attached, raw mode keeps the line discipline away from binary packets
+    usart->slave_fd = open(usart->pty_name, O_RDWR | O_NOCTTY);
+    if (usart->slave_fd < 0) {
+        return false;
+    }
+
+    struct termios attributes;
+    if (tcgetattr(usart->slave_fd, &attributes) != 0) {
+        return false;
+    }
+    cfmakeraw(&attributes);
+
+    return tcsetattr(usart->slave_fd, TCSANOW, &attributes) == 0;
+}
+
+static inline int host_usart_get_fd(UART_HandleTypeDef const* huart)
+{
+    if (huart == NULL) {
+        return -1;
+    }
+
+    if (huart->Instance == USART1) {
+        return host_usart.master_fd;
+    }
+
+    if (huart->Instance == USART2) {
+        return STDOUT_FILENO;
+    }
+
+    return -1;
+}
+
+static bool host_usart_write(int fd, uint8_t const* data, uint16_t size)
+{
+    size_t written_size = 0UL;
+    while (written_size < size) {
+        ssize_t result = write(fd, data + written_size, size - written_size);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            // nobody is reading the pty - the bytes are lost on the wire,
+            // just like on a real UART without a listener
+            return errno == EAGAIN;
+        }
+        written_size += (size_t)result;
+    }
+
+    return true;
+}
+
+void MX_USART1_UART_Init(void)
+{
+    huart1.Instance = USART1;
+    huart1.Init.BaudRate = 115200;
+
+    if (!host_usart_open_pty(&host_usart)) {
+        Error_Handler();
+    }
+
+    fprintf(stderr, "packet uart: %s\n", host_usart.pty_name);
+}
+
+void MX_USART2_UART_Init(void)
+{
+    huart2.Instance = USART2;
+    huart2.Init.BaudRate = 115200;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef* huart,
+                                    uint8_t const* data,
+                                    uint16_t size,
+                                    uint32_t timeout)
+{
+    int fd = host_usart_get_fd(huart);
+    if (fd < 0 || data == NULL) {
+        return HAL_ERROR;
+    }
+
+    return host_usart_write(fd, data, size) ? HAL_OK : HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef* huart,
+                                       uint8_t const* data,
+                                       uint16_t size)
+{
+    if (HAL_UART_Transmit(huart, data, size, 0U) != HAL_OK) {
+        return HAL_ERROR;
+    }
+
+    HAL_UART_TxCpltCallback(huart);
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef* huart,
+                                        uint8_t const* data,
+                                        uint16_t size)
+{
+    return HAL_UART_Transmit_IT(huart, data, size);
+}
+
+HAL_StatusTypeDef HAL_UART_AbortTransmit(UART_HandleTypeDef* huart)
+{
+    return host_usart_get_fd(huart) < 0 ? HAL_ERROR : HAL_OK;
+}
+
+// circular mode - the buffer keeps filling until the reception is aborted
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef* huart,
+                                               uint8_t* data,
+                                               uint16_t size)
+{
+    if (huart == NULL || huart->Instance != USART1 || data == NULL ||
+        size == 0U) {
+        return HAL_ERROR;
+    }
+
+    if (host_usart.receive_data != NULL) {
+        return HAL_BUSY;
+    }
+
+    host_usart.receive_data = data;
+    host_usart.receive_size = size;
+    host_usart.receive_position = 0U;
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_AbortReceive_IT(UART_HandleTypeDef* huart)
+{
+    if (huart == NULL || huart->Instance != USART1) {
+        return HAL_ERROR;
+    }
+
+    host_usart.receive_data = NULL;
+    host_usart.receive_size = 0U;
+    host_usart.receive_position = 0U;
+
+    return HAL_OK;
+}
+
+// transmits complete synchronously, so only the reception can be busy
+HAL_UART_StateTypeDef HAL_UART_GetState(UART_HandleTypeDef const* huart)
+{
+    if (huart == NULL || huart->Instance != USART1 ||
+        host_usart.receive_data == NULL) {
+        return HAL_UART_STATE_READY;
+    }
+
+    return HAL_UART_STATE_BUSY_RX;
+}
+
+// like the dma, reports how far the buffer is filled and wraps at its end
+static void host_usart_receive_event(host_usart_t* usart, size_t size)
+{
+    usart->receive_position = (uint16_t)(usart->receive_position + size);
+    HAL_UARTEx_RxEventCallback(&huart1, usart->receive_position);
+
+    if (usart->receive_position == usart->receive_size) {
+        usart->receive_position = 0U;
+    }
+}
+
+static bool host_usart_receive_injected(host_usart_t* usart)
+{
+    if (usart->inject_size == 0UL) {
+        return false;
+    }
+
+    size_t free_size = usart->receive_size - usart->receive_position;
+    size_t size =
+        usart->inject_size < free_size ? usart->inject_size : free_size;
+    memcpy(usart->receive_data + usart->receive_position,
+           usart->inject_data,
+           size);
+    memmove(usart->inject_data,
+            usart->inject_data + size,
+            usart->inject_size - size);
+    usart->inject_size -= size;
+
+    host_usart_receive_event(usart, size);
+
+    return true;
+}
+
+void host_usart_step(void)
+{
+    if (host_usart.receive_data == NULL ||
+        host_usart_receive_injected(&host_usart)) {
+        return;
+    }
+
+    ssize_t result =
+        read(host_usart.master_fd,
+             host_usart.receive_data + host_usart.receive_position,
+             host_usart.receive_size - host_usart.receive_position);
+    if (result < 0) {
+        if (errno != EAGAIN && errno != EINTR) {
+            host_usart.receive_data = NULL;
+            HAL_UART_ErrorCallback(&huart1);
+        }
+        return;
+    }
+
+    if (result > 0) {
+        host_usart_receive_event(&host_usart, (size_t)result);
+    }
+}
+
+void host_usart_inject(char const* data, size_t data_size)
+{
+    size_t free_size = HOST_USART_INJECT_LEN - host_usart.inject_size;
+    if (data == NULL || data_size > free_size) {
+        return;
+    }
+
+    memcpy(host_usart.inject_data + host_usart.inject_size, data, data_size);
+    host_usart.inject_size += data_size;
+}
+
+char const* host_usart_get_pty_name(void)
+{
+    return host_usart.pty_name;
+}
+
+#undef HOST_USART_PTY_NAME_LEN
+#undef HOST_USART_INJECT_LEN
@@ -1,4 +1,6 @@
 #include "config.h"
+#include "display_task.h"
+#include "log_task.h"
 #include "packet_task.h"
 #include "stm32l476xx.h"
 #include "stm32l4xx_hal.h"
@@ -22,9 +24,56 @@ void HAL_TIM_PWM_PulseFinishedCallback(TIM_HandleTypeDef* htim)
     }
 }
 
-void HAL_UART_RxCplt_Callback(UART_HandleTypeDef* huart)
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef* huart, uint16_t size)
 {
     if (huart->Instance == PACKET_UART_BUS->Instance) {
-        packet_task_rx_complete_callback();
+        packet_task_rx_complete_callback(size);
+    }
+}
+
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef* huart)
+{
+    if (huart->Instance == PACKET_UART_BUS->Instance) {
+        packet_task_tx_complete_callback();
+    } else if (huart->Instance == LOG_UART_BUS->Instance) {
+        log_task_tx_complete_callback();
+    }
+}
+
+void HAL_UART_ErrorCallback(UART_HandleTypeDef* huart)
+{
+    if (huart->Instance == PACKET_UART_BUS->Instance) {
+        packet_task_rx_error_callback();
+        packet_task_tx_error_callback();
+    } else if (huart->Instance == LOG_UART_BUS->Instance) {
+        log_task_tx_error_callback();
+    }
+}
+
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef* hspi)
+{
+    if (hspi->Instance == SH1107_SPI_BUS->Instance) {
+        display_task_tx_complete_callback();
+    }
+}
+
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef* hspi)
+{
+    if (hspi->Instance == SH1107_SPI_BUS->Instance) {
+        display_task_tx_error_callback();
+    }
+}
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef* hi2c)
+{
+    if (hi2c->Instance == MCP9808_I2C_BUS->Instance) {
+        termo_task_sensor_done_callback();
+    }
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef* hi2c)
+{
+    if (hi2c->Instance == MCP9808_I2C_BUS->Instance) {
+        termo_task_sensor_error_callback();
     }
 }
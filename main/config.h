@@ -16,20 +16,42 @@ extern TIM_HandleTypeDef htim1;
 #define UPDATE_TIMER (&htim4)
 
 #define MCP9808_I2C_BUS (&hi2c1)
-#define MCP9808_I2C_ADDRESS (MCP9808_SLAVE_ADDRESS_A2L_A1L_A0L)
+#define MCP9808_I2C_ADDRESSES {MCP9808_SLAVE_ADDRESS_A2L_A1L_A0L}
+#define MCP9808_COUNT (1U)
+#define MCP9808_SENSOR_READ (TERMO_SENSOR_READ_ASYNC)
 
 #define PWM_TIMER (&htim3)
 #define PWM_CHANNEL (TIM_CHANNEL_1)
 
+#define ZONES                                                              \
+    {{.pwm_timer = PWM_TIMER, .pwm_channel = PWM_CHANNEL, .sensor = 0U}}
+#define ZONE_COUNT (1U)
+
+#define CONTROL_ENGINE (TERMO_CONTROL_ENGINE_PID_REGULATOR)
 #define PROP_GAIN (100.0F)
 #define INT_GAIN (0.F)
 #define DOT_GAIN (0.0F)
 #define SAT_GAIN (0.0F)
+#define ZONE_PROP_GAINS {PROP_GAIN}
+#define ZONE_INT_GAINS {INT_GAIN}
+#define ZONE_DOT_GAINS {DOT_GAIN}
+#define ZONE_SAT_GAINS {SAT_GAIN}
 #define MIN_TEMP (25.0F)
 #define MAX_TEMP (35.0F)
 #define MIN_COMPARE (0x0000U)
 #define MAX_COMPARE (0xFFFFU)
 #define DELTA_TIME (1.0F)
+#define SENSOR_FUSION (TERMO_SENSOR_FUSION_SINGLE)
+#define CONTROL_SENSOR (0U)
+#define SENSOR_WEIGHTS {1.0F}
+#define SENSOR_FILTERS {{.median_len = 3U, .cutoff = 0.1F, .decimation = 1U}}
+// the estimate only adds samples once DELTA_TIME is below the update time
+#define ESTIMATION (TERMO_ESTIMATION_NONE)
+#define MODEL_TIME_CONSTANT (60.0F)
+#define MODEL_GAIN (20.0F)
+#define MODEL_AMBIENT (22.0F)
+#define PROCESS_NOISE (0.01F)
+#define MEASUREMENT_NOISE (0.0025F)
 
 #define SH1107_SPI_BUS (&hspi1)
 #define SH1107_CONTROL_GPIO (GPIOC)
@@ -41,5 +63,11 @@ extern TIM_HandleTypeDef htim1;
 
 #define LOG_UART_BUS (&huart2)
 #define PACKET_UART_BUS (&huart1)
+// a binary batch gets smaller than its single measures from 7 samples on
+#define MEASURE_BATCH_SIZE (8U)
+#define MEASURE_BATCH_WINDOW (1000U)
+
+#define POWER_STATS_PERIOD (10000U)
+#define STATS_PERIOD (5000U)
 
 #endif // MAIN_CONFIG_H
\ No newline at end of file
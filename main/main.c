@@ -1,5 +1,6 @@
 #include "main.h"
 #include "config.h"
+#include "dma.h"
 #include "gpio.h"
 #include "i2c.h"
 #include "spi.h"
@@ -10,23 +11,44 @@
 #include <string.h>
 
 static termo_ctx_t config = {
-    .system_ctx = {.config = {}},
-    .termo_ctx = {.config = {.delta_timer = DELTA_TIMER,
+    .system_ctx = {.config = {.power_stats_period = POWER_STATS_PERIOD,
+                              .stats_period = STATS_PERIOD}},
+    .termo_ctx = {.config = {.sensor_read = MCP9808_SENSOR_READ,
+                             .delta_timer = DELTA_TIMER,
                              .mcp9808_i2c_bus = MCP9808_I2C_BUS,
-                             .mcp9808_i2c_address = MCP9808_I2C_ADDRESS,
+                             .mcp9808_i2c_addresses = MCP9808_I2C_ADDRESSES,
+                             .mcp9808_count = MCP9808_COUNT,
                              .update_timer = UPDATE_TIMER,
-                             .pwm_timer = PWM_TIMER,
-                             .pwm_channel = PWM_CHANNEL},
-                  .params = {.kp = PROP_GAIN,
+                             .zones = ZONES,
+                             .zone_count = ZONE_COUNT},
+                  .params = {.control_engine = CONTROL_ENGINE,
+                             .kp = PROP_GAIN,
                              .ki = INT_GAIN,
                              .kd = DOT_GAIN,
                              .kc = SAT_GAIN,
+                             .zone_kp = ZONE_PROP_GAINS,
+                             .zone_ki = ZONE_INT_GAINS,
+                             .zone_kd = ZONE_DOT_GAINS,
+                             .zone_kc = ZONE_SAT_GAINS,
                              .min_temp = MIN_TEMP,
                              .max_temp = MAX_TEMP,
                              .min_compare = MIN_COMPARE,
                              .max_compare = MAX_COMPARE,
-                             .delta_time = DELTA_TIME}},
-    .packet_ctx = {.config = {.packet_uart_bus = PACKET_UART_BUS}},
+                             .delta_time = DELTA_TIME,
+                             .sensor_fusion = SENSOR_FUSION,
+                             .control_sensor = CONTROL_SENSOR,
+                             .sensor_weights = SENSOR_WEIGHTS,
+                             .sensor_filters = SENSOR_FILTERS,
+                             .estimation = ESTIMATION,
+                             .model_time_constant = MODEL_TIME_CONSTANT,
+                             .model_gain = MODEL_GAIN,
+                             .model_ambient = MODEL_AMBIENT,
+                             .process_noise = PROCESS_NOISE,
+                             .measurement_noise = MEASUREMENT_NOISE}},
+    .packet_ctx = {.config = {.packet_uart_bus = PACKET_UART_BUS,
+                              .measure_batch_size = MEASURE_BATCH_SIZE,
+                              .measure_batch_window = MEASURE_BATCH_WINDOW}},
+    .log_ctx = {.config = {.log_uart_bus = LOG_UART_BUS}},
     .display_ctx = {
         .config = {.sh1107_spi_bus = SH1107_SPI_BUS,
                    .sh1107_control_gpio = SH1107_CONTROL_GPIO,
@@ -46,6 +68,7 @@ int main(void)
     SystemClock_Config();
 
     MX_GPIO_Init();
+    MX_DMA_Init();
     MX_USART1_UART_Init();
     MX_USART2_UART_Init();
     MX_I2C1_Init();
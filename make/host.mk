@@ -0,0 +1,31 @@
+include make/common.mk
+
+HOST_BUILD_DIR := $(PROJECT_DIR)/build_host
+HOST_BINARY := $(HOST_BUILD_DIR)/main/main
+HOST_FRAME_DIR ?= $(HOST_BUILD_DIR)/frames
+
+.PHONY: build_host
+build_host:
+	$(MAKE) -C "$(HOST_BUILD_DIR)"
+
+.PHONY: clean_host
+clean_host:
+	rm -rf "$(HOST_BUILD_DIR)"
+
+.PHONY: setup_host
+setup_host: clean_host
+	mkdir -p "$(HOST_BUILD_DIR)"
+	cmake $(CMAKE_FLAGS) -DTERMO_HOST=ON -S . -B "$(HOST_BUILD_DIR)"
+
+.PHONY: run_host
+run_host:
+	mkdir -p "$(HOST_FRAME_DIR)"
+	TERMO_HOST_FRAME_DIR="$(HOST_FRAME_DIR)" "$(HOST_BINARY)"
+
+HOST_SCENARIO ?= step
+HOST_TIME_SCALE ?= 100
+
+.PHONY: scenario_host
+scenario_host:
+	TERMO_HOST_SCENARIO="$(HOST_SCENARIO)" \
+	TERMO_HOST_TIME_SCALE="$(HOST_TIME_SCALE)" "$(HOST_BINARY)"
@@ -7,3 +7,15 @@ MONITOR_BAUD ?= 115200
 .PHONY: monitor
 monitor:
 	$(MONITOR) -D "$(MONITOR_PORT)" -b "$(MONITOR_BAUD)"
+
+.PHONY: monitor_log
+monitor_log:
+	stty -F "$(MONITOR_PORT)" "$(MONITOR_BAUD)" raw -echo
+	python3 "$(SCRIPTS_DIR)/log_decoder.py" "$(PROJECT_BINARY)" "$(MONITOR_PORT)"
+
+TRACE_OUTPUT ?= $(BUILD_DIR)/trace.json
+
+.PHONY: monitor_trace
+monitor_trace:
+	stty -F "$(MONITOR_PORT)" "$(MONITOR_BAUD)" raw -echo
+	python3 "$(SCRIPTS_DIR)/trace_to_chrome.py" "$(MONITOR_PORT)" "$(TRACE_OUTPUT)"
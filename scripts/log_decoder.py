@@ -0,0 +1,209 @@
+#!/usr/bin/env python3
+"""Turns the deferred termo_log stream back into text.
+
+Each record carries the address of its format string, which is looked up
+in the allocated sections of the firmware ELF, followed by the raw
+arguments in format order (see termo_log.h).
+"""
+
+import re
+import struct
+import sys
+
+LOG_SYNC = 0xA5
+LOG_HEADER_SIZE = 10
+
+SHT_NOBITS = 8
+SHF_ALLOC = 0x2
+
+CONVERSION = re.compile(
+    r"%(?P<flags>[-+ #0]*)(?P<width>\*|\d*)(?:\.(?P<precision>\*|\d*))?"
+    r"(?P<length>hh|h|ll|l|j|z|t|L)?(?P<conversion>[%diuxXocfFeEgGaAps])"
+)
+
+
+class Elf:
+    def __init__(self, path):
+        with open(path, "rb") as file:
+            self.data = file.read()
+
+        if self.data[:4] != b"\x7fELF":
+            raise ValueError(f"{path} is not an ELF file")
+
+        self.is_64 = self.data[4] == 2
+        self.endian = "<" if self.data[5] == 1 else ">"
+        self.pointer_size = 8 if self.is_64 else 4
+        self.sections = self.read_sections()
+
+    def read_sections(self):
+        if self.is_64:
+            shoff, = struct.unpack_from(self.endian + "Q", self.data, 0x28)
+            shentsize, shnum = struct.unpack_from(
+                self.endian + "HH", self.data, 0x3A)
+            layout = "IIQQQQ"
+        else:
+            shoff, = struct.unpack_from(self.endian + "I", self.data, 0x20)
+            shentsize, shnum = struct.unpack_from(
+                self.endian + "HH", self.data, 0x2E)
+            layout = "IIIIII"
+
+        sections = []
+        for index in range(shnum):
+            _, sh_type, flags, addr, offset, size = struct.unpack_from(
+                self.endian + layout, self.data, shoff + index * shentsize)
+            if flags & SHF_ALLOC and sh_type != SHT_NOBITS and size > 0:
+                sections.append((addr, offset, size))
+
+        return sections
+
+    def read_string(self, address):
+        for addr, offset, size in self.sections:
+            if addr <= address < addr + size:
+                start = offset + address - addr
+                end = self.data.find(b"\0", start, offset + size)
+                if end < 0:
+                    return None
+                return self.data[start:end].decode("utf-8", "replace")
+
+        return None
+
+
+class Decoder:
+    def __init__(self, elf):
+        self.elf = elf
+        self.buffer = bytearray()
+        self.formats = {}
+
+    def get_format(self, address):
+        if address not in self.formats:
+            self.formats[address] = self.elf.read_string(address)
+
+        return self.formats[address]
+
+    def integer_size(self, length):
+        if length == "l":
+            return self.elf.pointer_size
+        if length in ("ll", "j"):
+            return 8
+        if length in ("z", "t"):
+            return self.elf.pointer_size
+        return 4
+
+    def unpack(self, payload, offset, code, size):
+        value, = struct.unpack_from(
+            self.elf.endian + code, payload, offset)
+        return value, offset + size
+
+    def render(self, format, payload):
+        pieces = []
+        offset = 0
+        position = 0
+
+        for match in CONVERSION.finditer(format):
+            pieces.append(format[position:match.start()])
+            position = match.end()
+
+            conversion = match["conversion"]
+            if conversion == "%":
+                pieces.append("%")
+                continue
+
+            width = match["width"]
+            precision = match["precision"]
+            if width == "*":
+                width, offset = self.unpack(payload, offset, "i", 4)
+            if precision == "*":
+                precision, offset = self.unpack(payload, offset, "i", 4)
+
+            spec = "%" + match["flags"] + str(width or "")
+            if precision is not None:
+                spec += "." + str(precision)
+
+            if conversion in "di":
+                size = self.integer_size(match["length"])
+                value, offset = self.unpack(
+                    payload, offset, {4: "i", 8: "q"}[size], size)
+                pieces.append((spec + "d") % value)
+            elif conversion in "uxXoc":
+                size = self.integer_size(match["length"])
+                value, offset = self.unpack(
+                    payload, offset, {4: "I", 8: "Q"}[size], size)
+                pieces.append((spec + conversion.replace("u", "d")) % value)
+            elif conversion in "fFeEgG":
+                value, offset = self.unpack(payload, offset, "d", 8)
+                pieces.append((spec + conversion) % value)
+            elif conversion in "aA":
+                value, offset = self.unpack(payload, offset, "d", 8)
+                pieces.append(value.hex())
+            elif conversion == "p":
+                size = self.elf.pointer_size
+                value, offset = self.unpack(
+                    payload, offset, {4: "I", 8: "Q"}[size], size)
+                pieces.append(f"0x{value:x}")
+            elif conversion == "s":
+                length = payload[offset]
+                text = payload[offset + 1:offset + 1 + length]
+                offset += 1 + length
+                pieces.append((spec + "s") % text.decode("utf-8", "replace"))
+
+        pieces.append(format[position:])
+
+        return "".join(pieces)
+
+    def feed(self, data):
+        self.buffer.extend(data)
+
+        while True:
+            sync = self.buffer.find(LOG_SYNC)
+            if sync < 0:
+                self.buffer.clear()
+                return
+            del self.buffer[:sync]
+
+            if len(self.buffer) < LOG_HEADER_SIZE:
+                return
+
+            payload_size = self.buffer[1]
+            if len(self.buffer) < LOG_HEADER_SIZE + payload_size:
+                return
+
+            address, tick = struct.unpack_from(
+                self.elf.endian + "II", self.buffer, 2)
+            format = self.get_format(address)
+            payload = bytes(
+                self.buffer[LOG_HEADER_SIZE:LOG_HEADER_SIZE + payload_size])
+
+            try:
+                text = self.render(format, payload) if format else None
+            except (struct.error, IndexError, KeyError, TypeError):
+                text = None
+
+            if text is None:
+                del self.buffer[:1]
+                continue
+
+            del self.buffer[:LOG_HEADER_SIZE + payload_size]
+            print(f"{tick:10d} {text.rstrip()}", flush=True)
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(f"Usage: {sys.argv[0]} <elf> [input]", file=sys.stderr)
+        return 1
+
+    decoder = Decoder(Elf(sys.argv[1]))
+
+    path = sys.argv[2] if len(sys.argv) > 2 else "-"
+    stream = sys.stdin.buffer if path == "-" else open(path, "rb", 0)
+
+    try:
+        while data := stream.read1(256) if path == "-" else stream.read(256):
+            decoder.feed(data)
+    except KeyboardInterrupt:
+        pass
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+"""Requests a termo_trace dump over the packet link and writes it out as
+Chrome trace_event JSON, loadable in chrome://tracing or Perfetto.
+
+The dump arrives as trace packets (see packet_out.h), each carrying a slice
+of the event ring with timestamps in ticks of the reported clock - DWT
+cycles on the target, nanoseconds on the host simulation.
+
+Only the text codec works here: binary trace packets carry the names as
+addresses into the firmware and the binary link has no delimiter to frame
+them by, so build without USE_BINARY_PACKETS (see termo_common.h) to take a
+dump.
+"""
+
+import json
+import os
+import select
+import sys
+
+PACKET_IN_TYPE_TRACE_DUMP = 1
+PACKET_OUT_TYPE_TRACE = 2
+
+TRACE_PHASES = ("B", "E")
+TIMESTAMP_RANGE = 1 << 32
+
+DUMP_TIMEOUT = 5.0
+
+
+class Dump:
+    def __init__(self):
+        self.clock = 0
+        self.total = 0
+        self.events = {}
+
+    def feed(self, payload):
+        if payload["index"] == 0:
+            self.events.clear()
+
+        self.clock = payload["clock"]
+        self.total = payload["total"]
+        for offset, event in enumerate(payload["events"]):
+            self.events[payload["index"] + offset] = event
+
+    def is_complete(self):
+        return self.clock > 0 and len(self.events) >= self.total
+
+    def get_missing(self):
+        return self.total - len(self.events)
+
+    def to_trace_events(self):
+        trace_events = []
+        tids = {}
+        epoch = None
+        previous = None
+        wraps = 0
+
+        for index in sorted(self.events):
+            name, task, timestamp, phase = self.events[index]
+
+            # the ring is ordered by time, so a step back is a wrap around
+            if previous is not None and timestamp < previous:
+                wraps += 1
+            previous = timestamp
+
+            ticks = wraps * TIMESTAMP_RANGE + timestamp
+            if epoch is None:
+                epoch = ticks
+
+            if task not in tids:
+                tids[task] = len(tids)
+                trace_events.append({"name": "thread_name",
+                                     "ph": "M",
+                                     "pid": 0,
+                                     "tid": tids[task],
+                                     "args": {"name": task}})
+
+            trace_events.append({"name": name,
+                                 "ph": TRACE_PHASES[phase],
+                                 "ts": (ticks - epoch) * 1e6 / self.clock,
+                                 "pid": 0,
+                                 "tid": tids[task]})
+
+        return trace_events
+
+
+def read_packets(fd, timeout):
+    buffer = bytearray()
+
+    while True:
+        ready, _, _ = select.select([fd], [], [], timeout)
+        if not ready:
+            return
+
+        data = os.read(fd, 256)
+        if not data:
+            return
+        buffer.extend(data)
+
+        while (end := buffer.find(b"\n")) >= 0:
+            line = bytes(buffer[:end]).strip()
+            del buffer[:end + 1]
+            try:
+                yield json.loads(line)
+            except ValueError:
+                continue
+
+
+def main():
+    if len(sys.argv) < 3:
+        print(f"Usage: {sys.argv[0]} <packet port> <output>", file=sys.stderr)
+        return 1
+
+    fd = os.open(sys.argv[1], os.O_RDWR | os.O_NOCTTY)
+    request = {"packet_type": PACKET_IN_TYPE_TRACE_DUMP,
+               "packet_payload": {}}
+    os.write(fd, (json.dumps(request) + "\n").encode())
+
+    dump = Dump()
+    for packet in read_packets(fd, DUMP_TIMEOUT):
+        if packet.get("packet_type") != PACKET_OUT_TYPE_TRACE:
+            continue
+
+        dump.feed(packet["packet_payload"])
+        if dump.is_complete():
+            break
+
+    os.close(fd)
+
+    if dump.clock == 0:
+        print("no trace received, is the firmware built with the text "
+              "codec?", file=sys.stderr)
+        return 1
+
+    if not dump.is_complete():
+        print(f"{dump.get_missing()} events lost", file=sys.stderr)
+
+    with open(sys.argv[2], "w") as file:
+        json.dump({"traceEvents": dump.to_trace_events(),
+                   "displayTimeUnit": "ns"}, file)
+
+    print(f"{len(dump.events)} events written to {sys.argv[2]}",
+          file=sys.stderr)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())